@@ -0,0 +1,287 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/apps/CMakeLists.txt"
+  "/root/repo/benchmark/CMakeLists.txt"
+  "/root/repo/benchmark/buffer/CMakeLists.txt"
+  "/root/repo/benchmark/dispatch/CMakeLists.txt"
+  "/root/repo/benchmark/gettimeofday/CMakeLists.txt"
+  "/root/repo/benchmark/http/CMakeLists.txt"
+  "/root/repo/benchmark/http/evpp/CMakeLists.txt"
+  "/root/repo/benchmark/http/libevent/CMakeLists.txt"
+  "/root/repo/benchmark/ioevent/CMakeLists.txt"
+  "/root/repo/benchmark/ioevent/evpp/CMakeLists.txt"
+  "/root/repo/benchmark/ioevent/fd_channel_vs_pipe_event_watcher/CMakeLists.txt"
+  "/root/repo/benchmark/ioevent/libevent/CMakeLists.txt"
+  "/root/repo/benchmark/post_task/CMakeLists.txt"
+  "/root/repo/benchmark/timer/CMakeLists.txt"
+  "/root/repo/cmake/packages.cmake"
+  "/root/repo/cmake/utils.cmake"
+  "/root/repo/evpp/CMakeLists.txt"
+  "/root/repo/examples/CMakeLists.txt"
+  "/root/repo/examples/chatroom/CMakeLists.txt"
+  "/root/repo/examples/chatroom/simple/CMakeLists.txt"
+  "/root/repo/examples/http/CMakeLists.txt"
+  "/root/repo/examples/http/evpphttp_server/CMakeLists.txt"
+  "/root/repo/examples/http/http_client_request/CMakeLists.txt"
+  "/root/repo/examples/http/simple_proxy/CMakeLists.txt"
+  "/root/repo/examples/recipes/CMakeLists.txt"
+  "/root/repo/examples/recipes/self_control_timer/CMakeLists.txt"
+  "/root/repo/examples/recipes/self_control_timer/basic_01/CMakeLists.txt"
+  "/root/repo/examples/recipes/self_control_timer/basic_02/CMakeLists.txt"
+  "/root/repo/examples/recipes/self_control_timer/cancel_03/CMakeLists.txt"
+  "/root/repo/examples/recipes/self_control_timer/periodic_04/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/root/repo/test/more_tests/CMakeLists.txt"
+  "/root/repo/test/more_tests/fork/CMakeLists.txt"
+  "/root/repo/test/stability/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCCompiler.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCCompilerABI.c"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXCompiler.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXCompilerABI.cpp"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCompilerIdDetection.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCXXCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompileFeatures.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompilerABI.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompilerId.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindBinUtils.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitIncludeInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitLinkInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseLibraryArchitecture.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystem.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCXXCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCompilerCommon.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeUnixFindMake.cmake"
+  "/usr/share/cmake-3.25/Modules/CPack.cmake"
+  "/usr/share/cmake-3.25/Modules/CPackComponent.cmake"
+  "/usr/share/cmake-3.25/Modules/CTest.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestUseLaunchers.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ADSP-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ARMCC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ARMClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/AppleClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Borland-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Bruce-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Clang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Clang-DetermineCompilerInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Comeau-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Compaq-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Compaq-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Cray-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Embarcadero-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Fujitsu-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/FujitsuClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GHS-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-FindBinUtils.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/HP-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/HP-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IAR-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMCPP-C-DetermineVersionInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMCPP-CXX-DetermineVersionInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMClang-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMClang-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Intel-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IntelLLVM-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/LCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/LCC-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/MSVC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/NVHPC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/NVIDIA-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/OpenWatcom-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/PGI-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/PathScale-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SCO-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SDCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SunPro-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SunPro-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/TI-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Tasking-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/TinyCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/VisualAge-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/VisualAge-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Watcom-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XL-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XL-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XLClang-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XLClang-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/zOS-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/zOS-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/DartConfiguration.tcl.in"
+  "/usr/share/cmake-3.25/Modules/Internal/FeatureTesting.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-Determine-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Templates/CPackConfig.cmake.in"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CPackConfig.cmake"
+  "CPackSourceConfig.cmake"
+  "DartConfiguration.tcl"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "evpp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "DartConfiguration.tcl"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/stability/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/more_tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/more_tests/fork/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/chatroom/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/chatroom/simple/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/recipes/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/recipes/self_control_timer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/recipes/self_control_timer/basic_01/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/recipes/self_control_timer/basic_02/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/recipes/self_control_timer/cancel_03/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/recipes/self_control_timer/periodic_04/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/http/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/http/http_client_request/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/http/simple_proxy/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/http/evpphttp_server/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/buffer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/dispatch/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/gettimeofday/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/http/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/http/libevent/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/http/evpp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/ioevent/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/ioevent/libevent/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/ioevent/evpp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/ioevent/fd_channel_vs_pipe_event_watcher/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/post_task/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/timer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "evpp/CMakeFiles/evpp_static.dir/DependInfo.cmake"
+  "evpp/CMakeFiles/evpp_lite_static.dir/DependInfo.cmake"
+  "evpp/CMakeFiles/evpp.dir/DependInfo.cmake"
+  "test/CMakeFiles/evpp_unittest.dir/DependInfo.cmake"
+  "test/CMakeFiles/Experimental.dir/DependInfo.cmake"
+  "test/CMakeFiles/Nightly.dir/DependInfo.cmake"
+  "test/CMakeFiles/Continuous.dir/DependInfo.cmake"
+  "test/CMakeFiles/NightlyMemoryCheck.dir/DependInfo.cmake"
+  "test/CMakeFiles/NightlyStart.dir/DependInfo.cmake"
+  "test/CMakeFiles/NightlyUpdate.dir/DependInfo.cmake"
+  "test/CMakeFiles/NightlyConfigure.dir/DependInfo.cmake"
+  "test/CMakeFiles/NightlyBuild.dir/DependInfo.cmake"
+  "test/CMakeFiles/NightlyTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/NightlyCoverage.dir/DependInfo.cmake"
+  "test/CMakeFiles/NightlyMemCheck.dir/DependInfo.cmake"
+  "test/CMakeFiles/NightlySubmit.dir/DependInfo.cmake"
+  "test/CMakeFiles/ExperimentalStart.dir/DependInfo.cmake"
+  "test/CMakeFiles/ExperimentalUpdate.dir/DependInfo.cmake"
+  "test/CMakeFiles/ExperimentalConfigure.dir/DependInfo.cmake"
+  "test/CMakeFiles/ExperimentalBuild.dir/DependInfo.cmake"
+  "test/CMakeFiles/ExperimentalTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/ExperimentalCoverage.dir/DependInfo.cmake"
+  "test/CMakeFiles/ExperimentalMemCheck.dir/DependInfo.cmake"
+  "test/CMakeFiles/ExperimentalSubmit.dir/DependInfo.cmake"
+  "test/CMakeFiles/ContinuousStart.dir/DependInfo.cmake"
+  "test/CMakeFiles/ContinuousUpdate.dir/DependInfo.cmake"
+  "test/CMakeFiles/ContinuousConfigure.dir/DependInfo.cmake"
+  "test/CMakeFiles/ContinuousBuild.dir/DependInfo.cmake"
+  "test/CMakeFiles/ContinuousTest.dir/DependInfo.cmake"
+  "test/CMakeFiles/ContinuousCoverage.dir/DependInfo.cmake"
+  "test/CMakeFiles/ContinuousMemCheck.dir/DependInfo.cmake"
+  "test/CMakeFiles/ContinuousSubmit.dir/DependInfo.cmake"
+  "test/stability/CMakeFiles/test_evpp_stability.dir/DependInfo.cmake"
+  "test/more_tests/fork/CMakeFiles/test_evpp_after_fork.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_httpecho.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_tcpecho.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_udpecho.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_pingpong_client.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_pingpong_server.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_tcp_client.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_tcp_server.dir/DependInfo.cmake"
+  "examples/CMakeFiles/rpc_client.dir/DependInfo.cmake"
+  "examples/CMakeFiles/rpc_server.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_multi_accept.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_twisted_pubsubserver.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_twisted_webserver.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_timer01.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_timer02.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_timer03.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_timer04.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_timer05.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_dns_resolve.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_signal01.dir/DependInfo.cmake"
+  "examples/CMakeFiles/example_signal02.dir/DependInfo.cmake"
+  "examples/chatroom/simple/CMakeFiles/example_chatroom_simple_server.dir/DependInfo.cmake"
+  "examples/chatroom/simple/CMakeFiles/example_chatroom_simple_client.dir/DependInfo.cmake"
+  "examples/recipes/self_control_timer/basic_01/CMakeFiles/example_recipes_self_control_timer_basic_01.dir/DependInfo.cmake"
+  "examples/recipes/self_control_timer/basic_02/CMakeFiles/example_recipes_self_control_timer_basic_02.dir/DependInfo.cmake"
+  "examples/recipes/self_control_timer/cancel_03/CMakeFiles/example_recipes_self_control_timer_cancel_03.dir/DependInfo.cmake"
+  "examples/recipes/self_control_timer/periodic_04/CMakeFiles/example_recipes_self_control_timer_periodic_04.dir/DependInfo.cmake"
+  "examples/http/http_client_request/CMakeFiles/example_http_client_request01.dir/DependInfo.cmake"
+  "examples/http/http_client_request/CMakeFiles/example_http_client_request02.dir/DependInfo.cmake"
+  "examples/http/http_client_request/CMakeFiles/example_http_client_request03.dir/DependInfo.cmake"
+  "examples/http/http_client_request/CMakeFiles/example_http_client_request04.dir/DependInfo.cmake"
+  "examples/http/http_client_request/CMakeFiles/example_http_client_request05.dir/DependInfo.cmake"
+  "examples/http/simple_proxy/CMakeFiles/example_http_simple_proxy.dir/DependInfo.cmake"
+  "examples/http/evpphttp_server/CMakeFiles/example_evpphttp_server.dir/DependInfo.cmake"
+  "benchmark/buffer/CMakeFiles/benchmark_buffer.dir/DependInfo.cmake"
+  "benchmark/dispatch/CMakeFiles/benchmark_dispatch.dir/DependInfo.cmake"
+  "benchmark/gettimeofday/CMakeFiles/benchmark_gettimeofday.dir/DependInfo.cmake"
+  "benchmark/http/libevent/CMakeFiles/benchmark_http_libevent.dir/DependInfo.cmake"
+  "benchmark/http/evpp/CMakeFiles/benchmark_http_evpp.dir/DependInfo.cmake"
+  "benchmark/ioevent/libevent/CMakeFiles/benchmark_ioevent_libevent.dir/DependInfo.cmake"
+  "benchmark/ioevent/evpp/CMakeFiles/benchmark_ioevent_evpp.dir/DependInfo.cmake"
+  "benchmark/ioevent/evpp/CMakeFiles/benchmark_ioevent_evpp_pipe_watcher.dir/DependInfo.cmake"
+  "benchmark/ioevent/fd_channel_vs_pipe_event_watcher/CMakeFiles/benchmark_fd_channel_vs_pipe_event_watcher.dir/DependInfo.cmake"
+  "benchmark/post_task/CMakeFiles/benchmark_post_task1.dir/DependInfo.cmake"
+  "benchmark/post_task/CMakeFiles/benchmark_post_task2.dir/DependInfo.cmake"
+  "benchmark/post_task/CMakeFiles/benchmark_post_task3.dir/DependInfo.cmake"
+  "benchmark/post_task/CMakeFiles/benchmark_post_task4.dir/DependInfo.cmake"
+  "benchmark/post_task/CMakeFiles/benchmark_post_task5.dir/DependInfo.cmake"
+  "benchmark/post_task/CMakeFiles/benchmark_post_task6.dir/DependInfo.cmake"
+  "benchmark/post_task/CMakeFiles/benchmark_post_task7.dir/DependInfo.cmake"
+  "benchmark/timer/CMakeFiles/benchmark_timer.dir/DependInfo.cmake"
+  )
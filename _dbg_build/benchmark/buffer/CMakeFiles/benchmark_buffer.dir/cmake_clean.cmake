@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/benchmark_buffer"
+  "../../bin/benchmark_buffer.pdb"
+  "CMakeFiles/benchmark_buffer.dir/buffer.cc.o"
+  "CMakeFiles/benchmark_buffer.dir/buffer.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_buffer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
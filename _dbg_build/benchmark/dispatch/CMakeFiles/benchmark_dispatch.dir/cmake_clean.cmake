@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/benchmark_dispatch"
+  "../../bin/benchmark_dispatch.pdb"
+  "CMakeFiles/benchmark_dispatch.dir/dispatch.cc.o"
+  "CMakeFiles/benchmark_dispatch.dir/dispatch.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_dispatch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
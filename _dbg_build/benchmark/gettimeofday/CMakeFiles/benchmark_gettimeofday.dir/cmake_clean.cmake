@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/benchmark_gettimeofday"
+  "../../bin/benchmark_gettimeofday.pdb"
+  "CMakeFiles/benchmark_gettimeofday.dir/gettimeofday.cc.o"
+  "CMakeFiles/benchmark_gettimeofday.dir/gettimeofday.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_gettimeofday.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/benchmark_http_evpp"
+  "../../../bin/benchmark_http_evpp.pdb"
+  "CMakeFiles/benchmark_http_evpp.dir/evpp_http_bench.cc.o"
+  "CMakeFiles/benchmark_http_evpp.dir/evpp_http_bench.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_http_evpp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
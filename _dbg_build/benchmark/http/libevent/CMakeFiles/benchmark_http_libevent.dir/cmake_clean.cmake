@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/benchmark_http_libevent"
+  "../../../bin/benchmark_http_libevent.pdb"
+  "CMakeFiles/benchmark_http_libevent.dir/libevent_http_bench.c.o"
+  "CMakeFiles/benchmark_http_libevent.dir/libevent_http_bench.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/benchmark_http_libevent.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/benchmark_ioevent_evpp"
+  "../../../bin/benchmark_ioevent_evpp.pdb"
+  "CMakeFiles/benchmark_ioevent_evpp.dir/evpp_ioevent_bench.cc.o"
+  "CMakeFiles/benchmark_ioevent_evpp.dir/evpp_ioevent_bench.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_ioevent_evpp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/benchmark_ioevent_evpp_pipe_watcher"
+  "../../../bin/benchmark_ioevent_evpp_pipe_watcher.pdb"
+  "CMakeFiles/benchmark_ioevent_evpp_pipe_watcher.dir/evpp_ioevent_pipe_watcher.cc.o"
+  "CMakeFiles/benchmark_ioevent_evpp_pipe_watcher.dir/evpp_ioevent_pipe_watcher.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_ioevent_evpp_pipe_watcher.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
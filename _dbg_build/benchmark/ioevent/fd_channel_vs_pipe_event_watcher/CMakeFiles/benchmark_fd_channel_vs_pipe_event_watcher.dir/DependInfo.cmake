@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/benchmark/ioevent/fd_channel_vs_pipe_event_watcher/fd_channel_vs_pipe_event_watcher.cc" "benchmark/ioevent/fd_channel_vs_pipe_event_watcher/CMakeFiles/benchmark_fd_channel_vs_pipe_event_watcher.dir/fd_channel_vs_pipe_event_watcher.cc.o" "gcc" "benchmark/ioevent/fd_channel_vs_pipe_event_watcher/CMakeFiles/benchmark_fd_channel_vs_pipe_event_watcher.dir/fd_channel_vs_pipe_event_watcher.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_dbg_build/evpp/CMakeFiles/evpp_static.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
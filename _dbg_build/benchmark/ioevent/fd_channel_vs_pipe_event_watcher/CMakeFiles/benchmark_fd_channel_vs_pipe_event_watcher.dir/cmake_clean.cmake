@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/benchmark_fd_channel_vs_pipe_event_watcher"
+  "../../../bin/benchmark_fd_channel_vs_pipe_event_watcher.pdb"
+  "CMakeFiles/benchmark_fd_channel_vs_pipe_event_watcher.dir/fd_channel_vs_pipe_event_watcher.cc.o"
+  "CMakeFiles/benchmark_fd_channel_vs_pipe_event_watcher.dir/fd_channel_vs_pipe_event_watcher.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_fd_channel_vs_pipe_event_watcher.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
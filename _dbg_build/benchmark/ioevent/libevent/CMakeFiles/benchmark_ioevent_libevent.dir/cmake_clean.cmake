@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/benchmark_ioevent_libevent"
+  "../../../bin/benchmark_ioevent_libevent.pdb"
+  "CMakeFiles/benchmark_ioevent_libevent.dir/libevent_ioevent_bench.c.o"
+  "CMakeFiles/benchmark_ioevent_libevent.dir/libevent_ioevent_bench.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/benchmark_ioevent_libevent.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/benchmark_post_task1"
+  "../../bin/benchmark_post_task1.pdb"
+  "CMakeFiles/benchmark_post_task1.dir/post_task1.cc.o"
+  "CMakeFiles/benchmark_post_task1.dir/post_task1.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_post_task1.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/benchmark_post_task5"
+  "../../bin/benchmark_post_task5.pdb"
+  "CMakeFiles/benchmark_post_task5.dir/post_task5.cc.o"
+  "CMakeFiles/benchmark_post_task5.dir/post_task5.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_post_task5.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
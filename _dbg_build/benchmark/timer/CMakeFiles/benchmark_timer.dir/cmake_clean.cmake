@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/benchmark_timer"
+  "../../bin/benchmark_timer.pdb"
+  "CMakeFiles/benchmark_timer.dir/timer.cc.o"
+  "CMakeFiles/benchmark_timer.dir/timer.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_timer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,61 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/evpp/buffer.cc" "evpp/CMakeFiles/evpp.dir/buffer.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/buffer.cc.o.d"
+  "/root/repo/evpp/buffer_pool.cc" "evpp/CMakeFiles/evpp.dir/buffer_pool.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/buffer_pool.cc.o.d"
+  "/root/repo/evpp/compute_pool.cc" "evpp/CMakeFiles/evpp.dir/compute_pool.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/compute_pool.cc.o.d"
+  "/root/repo/evpp/connection_table.cc" "evpp/CMakeFiles/evpp.dir/connection_table.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/connection_table.cc.o.d"
+  "/root/repo/evpp/connector.cc" "evpp/CMakeFiles/evpp.dir/connector.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/connector.cc.o.d"
+  "/root/repo/evpp/dns_resolver.cc" "evpp/CMakeFiles/evpp.dir/dns_resolver.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/dns_resolver.cc.o.d"
+  "/root/repo/evpp/duration.cc" "evpp/CMakeFiles/evpp.dir/duration.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/duration.cc.o.d"
+  "/root/repo/evpp/epoll_poller.cc" "evpp/CMakeFiles/evpp.dir/epoll_poller.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/epoll_poller.cc.o.d"
+  "/root/repo/evpp/event_loop.cc" "evpp/CMakeFiles/evpp.dir/event_loop.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/event_loop.cc.o.d"
+  "/root/repo/evpp/event_loop_thread.cc" "evpp/CMakeFiles/evpp.dir/event_loop_thread.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/event_loop_thread.cc.o.d"
+  "/root/repo/evpp/event_loop_thread_pool.cc" "evpp/CMakeFiles/evpp.dir/event_loop_thread_pool.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/event_loop_thread_pool.cc.o.d"
+  "/root/repo/evpp/event_watcher.cc" "evpp/CMakeFiles/evpp.dir/event_watcher.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/event_watcher.cc.o.d"
+  "/root/repo/evpp/evpphttp/http_parser_cpp.cc" "evpp/CMakeFiles/evpp.dir/evpphttp/http_parser_cpp.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/evpphttp/http_parser_cpp.cc.o.d"
+  "/root/repo/evpp/evpphttp/http_request.cc" "evpp/CMakeFiles/evpp.dir/evpphttp/http_request.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/evpphttp/http_request.cc.o.d"
+  "/root/repo/evpp/evpphttp/http_response.cc" "evpp/CMakeFiles/evpp.dir/evpphttp/http_response.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/evpphttp/http_response.cc.o.d"
+  "/root/repo/evpp/evpphttp/service.cc" "evpp/CMakeFiles/evpp.dir/evpphttp/service.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/evpphttp/service.cc.o.d"
+  "/root/repo/evpp/fd_channel.cc" "evpp/CMakeFiles/evpp.dir/fd_channel.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/fd_channel.cc.o.d"
+  "/root/repo/evpp/http/context.cc" "evpp/CMakeFiles/evpp.dir/http/context.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/http/context.cc.o.d"
+  "/root/repo/evpp/http/http_server.cc" "evpp/CMakeFiles/evpp.dir/http/http_server.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/http/http_server.cc.o.d"
+  "/root/repo/evpp/http/service.cc" "evpp/CMakeFiles/evpp.dir/http/service.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/http/service.cc.o.d"
+  "/root/repo/evpp/httpc/conn.cc" "evpp/CMakeFiles/evpp.dir/httpc/conn.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/httpc/conn.cc.o.d"
+  "/root/repo/evpp/httpc/conn_pool.cc" "evpp/CMakeFiles/evpp.dir/httpc/conn_pool.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/httpc/conn_pool.cc.o.d"
+  "/root/repo/evpp/httpc/request.cc" "evpp/CMakeFiles/evpp.dir/httpc/request.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/httpc/request.cc.o.d"
+  "/root/repo/evpp/httpc/response.cc" "evpp/CMakeFiles/evpp.dir/httpc/response.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/httpc/response.cc.o.d"
+  "/root/repo/evpp/httpc/ssl.cc" "evpp/CMakeFiles/evpp.dir/httpc/ssl.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/httpc/ssl.cc.o.d"
+  "/root/repo/evpp/httpc/url_parser.cc" "evpp/CMakeFiles/evpp.dir/httpc/url_parser.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/httpc/url_parser.cc.o.d"
+  "/root/repo/evpp/inner_pre.cc" "evpp/CMakeFiles/evpp.dir/inner_pre.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/inner_pre.cc.o.d"
+  "/root/repo/evpp/invoke_timer.cc" "evpp/CMakeFiles/evpp.dir/invoke_timer.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/invoke_timer.cc.o.d"
+  "/root/repo/evpp/io_uring_engine.cc" "evpp/CMakeFiles/evpp.dir/io_uring_engine.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/io_uring_engine.cc.o.d"
+  "/root/repo/evpp/libevent.cc" "evpp/CMakeFiles/evpp.dir/libevent.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/libevent.cc.o.d"
+  "/root/repo/evpp/listener.cc" "evpp/CMakeFiles/evpp.dir/listener.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/listener.cc.o.d"
+  "/root/repo/evpp/logger.cc" "evpp/CMakeFiles/evpp.dir/logger.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/logger.cc.o.d"
+  "/root/repo/evpp/loop_metrics.cc" "evpp/CMakeFiles/evpp.dir/loop_metrics.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/loop_metrics.cc.o.d"
+  "/root/repo/evpp/memsearch.cc" "evpp/CMakeFiles/evpp.dir/memsearch.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/memsearch.cc.o.d"
+  "/root/repo/evpp/numa.cc" "evpp/CMakeFiles/evpp.dir/numa.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/numa.cc.o.d"
+  "/root/repo/evpp/output_queue.cc" "evpp/CMakeFiles/evpp.dir/output_queue.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/output_queue.cc.o.d"
+  "/root/repo/evpp/sockets.cc" "evpp/CMakeFiles/evpp.dir/sockets.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/sockets.cc.o.d"
+  "/root/repo/evpp/tcp_client.cc" "evpp/CMakeFiles/evpp.dir/tcp_client.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/tcp_client.cc.o.d"
+  "/root/repo/evpp/tcp_conn.cc" "evpp/CMakeFiles/evpp.dir/tcp_conn.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/tcp_conn.cc.o.d"
+  "/root/repo/evpp/tcp_server.cc" "evpp/CMakeFiles/evpp.dir/tcp_server.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/tcp_server.cc.o.d"
+  "/root/repo/evpp/timing_wheel.cc" "evpp/CMakeFiles/evpp.dir/timing_wheel.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/timing_wheel.cc.o.d"
+  "/root/repo/evpp/udp/sync_udp_client.cc" "evpp/CMakeFiles/evpp.dir/udp/sync_udp_client.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/udp/sync_udp_client.cc.o.d"
+  "/root/repo/evpp/udp/udp_server.cc" "evpp/CMakeFiles/evpp.dir/udp/udp_server.cc.o" "gcc" "evpp/CMakeFiles/evpp.dir/udp/udp_server.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
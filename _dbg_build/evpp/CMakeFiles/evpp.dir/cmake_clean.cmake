@@ -0,0 +1,95 @@
+file(REMOVE_RECURSE
+  "../lib/libevpp.pdb"
+  "../lib/libevpp.so"
+  "CMakeFiles/evpp.dir/buffer.cc.o"
+  "CMakeFiles/evpp.dir/buffer.cc.o.d"
+  "CMakeFiles/evpp.dir/buffer_pool.cc.o"
+  "CMakeFiles/evpp.dir/buffer_pool.cc.o.d"
+  "CMakeFiles/evpp.dir/compute_pool.cc.o"
+  "CMakeFiles/evpp.dir/compute_pool.cc.o.d"
+  "CMakeFiles/evpp.dir/connection_table.cc.o"
+  "CMakeFiles/evpp.dir/connection_table.cc.o.d"
+  "CMakeFiles/evpp.dir/connector.cc.o"
+  "CMakeFiles/evpp.dir/connector.cc.o.d"
+  "CMakeFiles/evpp.dir/dns_resolver.cc.o"
+  "CMakeFiles/evpp.dir/dns_resolver.cc.o.d"
+  "CMakeFiles/evpp.dir/duration.cc.o"
+  "CMakeFiles/evpp.dir/duration.cc.o.d"
+  "CMakeFiles/evpp.dir/epoll_poller.cc.o"
+  "CMakeFiles/evpp.dir/epoll_poller.cc.o.d"
+  "CMakeFiles/evpp.dir/event_loop.cc.o"
+  "CMakeFiles/evpp.dir/event_loop.cc.o.d"
+  "CMakeFiles/evpp.dir/event_loop_thread.cc.o"
+  "CMakeFiles/evpp.dir/event_loop_thread.cc.o.d"
+  "CMakeFiles/evpp.dir/event_loop_thread_pool.cc.o"
+  "CMakeFiles/evpp.dir/event_loop_thread_pool.cc.o.d"
+  "CMakeFiles/evpp.dir/event_watcher.cc.o"
+  "CMakeFiles/evpp.dir/event_watcher.cc.o.d"
+  "CMakeFiles/evpp.dir/evpphttp/http_parser_cpp.cc.o"
+  "CMakeFiles/evpp.dir/evpphttp/http_parser_cpp.cc.o.d"
+  "CMakeFiles/evpp.dir/evpphttp/http_request.cc.o"
+  "CMakeFiles/evpp.dir/evpphttp/http_request.cc.o.d"
+  "CMakeFiles/evpp.dir/evpphttp/http_response.cc.o"
+  "CMakeFiles/evpp.dir/evpphttp/http_response.cc.o.d"
+  "CMakeFiles/evpp.dir/evpphttp/service.cc.o"
+  "CMakeFiles/evpp.dir/evpphttp/service.cc.o.d"
+  "CMakeFiles/evpp.dir/fd_channel.cc.o"
+  "CMakeFiles/evpp.dir/fd_channel.cc.o.d"
+  "CMakeFiles/evpp.dir/http/context.cc.o"
+  "CMakeFiles/evpp.dir/http/context.cc.o.d"
+  "CMakeFiles/evpp.dir/http/http_server.cc.o"
+  "CMakeFiles/evpp.dir/http/http_server.cc.o.d"
+  "CMakeFiles/evpp.dir/http/service.cc.o"
+  "CMakeFiles/evpp.dir/http/service.cc.o.d"
+  "CMakeFiles/evpp.dir/httpc/conn.cc.o"
+  "CMakeFiles/evpp.dir/httpc/conn.cc.o.d"
+  "CMakeFiles/evpp.dir/httpc/conn_pool.cc.o"
+  "CMakeFiles/evpp.dir/httpc/conn_pool.cc.o.d"
+  "CMakeFiles/evpp.dir/httpc/request.cc.o"
+  "CMakeFiles/evpp.dir/httpc/request.cc.o.d"
+  "CMakeFiles/evpp.dir/httpc/response.cc.o"
+  "CMakeFiles/evpp.dir/httpc/response.cc.o.d"
+  "CMakeFiles/evpp.dir/httpc/ssl.cc.o"
+  "CMakeFiles/evpp.dir/httpc/ssl.cc.o.d"
+  "CMakeFiles/evpp.dir/httpc/url_parser.cc.o"
+  "CMakeFiles/evpp.dir/httpc/url_parser.cc.o.d"
+  "CMakeFiles/evpp.dir/inner_pre.cc.o"
+  "CMakeFiles/evpp.dir/inner_pre.cc.o.d"
+  "CMakeFiles/evpp.dir/invoke_timer.cc.o"
+  "CMakeFiles/evpp.dir/invoke_timer.cc.o.d"
+  "CMakeFiles/evpp.dir/io_uring_engine.cc.o"
+  "CMakeFiles/evpp.dir/io_uring_engine.cc.o.d"
+  "CMakeFiles/evpp.dir/libevent.cc.o"
+  "CMakeFiles/evpp.dir/libevent.cc.o.d"
+  "CMakeFiles/evpp.dir/listener.cc.o"
+  "CMakeFiles/evpp.dir/listener.cc.o.d"
+  "CMakeFiles/evpp.dir/logger.cc.o"
+  "CMakeFiles/evpp.dir/logger.cc.o.d"
+  "CMakeFiles/evpp.dir/loop_metrics.cc.o"
+  "CMakeFiles/evpp.dir/loop_metrics.cc.o.d"
+  "CMakeFiles/evpp.dir/memsearch.cc.o"
+  "CMakeFiles/evpp.dir/memsearch.cc.o.d"
+  "CMakeFiles/evpp.dir/numa.cc.o"
+  "CMakeFiles/evpp.dir/numa.cc.o.d"
+  "CMakeFiles/evpp.dir/output_queue.cc.o"
+  "CMakeFiles/evpp.dir/output_queue.cc.o.d"
+  "CMakeFiles/evpp.dir/sockets.cc.o"
+  "CMakeFiles/evpp.dir/sockets.cc.o.d"
+  "CMakeFiles/evpp.dir/tcp_client.cc.o"
+  "CMakeFiles/evpp.dir/tcp_client.cc.o.d"
+  "CMakeFiles/evpp.dir/tcp_conn.cc.o"
+  "CMakeFiles/evpp.dir/tcp_conn.cc.o.d"
+  "CMakeFiles/evpp.dir/tcp_server.cc.o"
+  "CMakeFiles/evpp.dir/tcp_server.cc.o.d"
+  "CMakeFiles/evpp.dir/timing_wheel.cc.o"
+  "CMakeFiles/evpp.dir/timing_wheel.cc.o.d"
+  "CMakeFiles/evpp.dir/udp/sync_udp_client.cc.o"
+  "CMakeFiles/evpp.dir/udp/sync_udp_client.cc.o.d"
+  "CMakeFiles/evpp.dir/udp/udp_server.cc.o"
+  "CMakeFiles/evpp.dir/udp/udp_server.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/evpp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,77 @@
+file(REMOVE_RECURSE
+  "../lib/libevpp_lite_static.a"
+  "../lib/libevpp_lite_static.pdb"
+  "CMakeFiles/evpp_lite_static.dir/buffer.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/buffer.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/buffer_pool.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/buffer_pool.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/compute_pool.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/compute_pool.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/connection_table.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/connection_table.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/connector.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/connector.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/dns_resolver.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/dns_resolver.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/duration.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/duration.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/epoll_poller.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/epoll_poller.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/event_loop.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/event_loop.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/event_loop_thread.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/event_loop_thread.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/event_loop_thread_pool.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/event_loop_thread_pool.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/event_watcher.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/event_watcher.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/fd_channel.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/fd_channel.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/httpc/conn.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/httpc/conn.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/httpc/conn_pool.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/httpc/conn_pool.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/httpc/request.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/httpc/request.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/httpc/response.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/httpc/response.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/httpc/ssl.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/httpc/ssl.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/httpc/url_parser.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/httpc/url_parser.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/inner_pre.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/inner_pre.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/invoke_timer.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/invoke_timer.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/io_uring_engine.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/io_uring_engine.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/libevent.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/libevent.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/listener.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/listener.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/logger.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/logger.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/loop_metrics.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/loop_metrics.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/memsearch.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/memsearch.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/numa.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/numa.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/output_queue.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/output_queue.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/sockets.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/sockets.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/tcp_client.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/tcp_client.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/tcp_conn.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/tcp_conn.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/tcp_server.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/tcp_server.cc.o.d"
+  "CMakeFiles/evpp_lite_static.dir/timing_wheel.cc.o"
+  "CMakeFiles/evpp_lite_static.dir/timing_wheel.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/evpp_lite_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
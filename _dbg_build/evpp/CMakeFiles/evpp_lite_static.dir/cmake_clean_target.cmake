@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "../lib/libevpp_lite_static.a"
+)
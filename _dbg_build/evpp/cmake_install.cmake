@@ -0,0 +1,164 @@
+# Install script for directory: /root/repo/evpp
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Debug")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libevpp.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libevpp.so")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libevpp.so"
+         RPATH "")
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES "/root/repo/_dbg_build/lib/libevpp.so")
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libevpp.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libevpp.so")
+    file(RPATH_CHANGE
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libevpp.so"
+         OLD_RPATH "/root/repo/deps_prefix/lib:"
+         NEW_RPATH "")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libevpp.so")
+    endif()
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE STATIC_LIBRARY FILES "/root/repo/_dbg_build/lib/libevpp_static.a")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE STATIC_LIBRARY FILES "/root/repo/_dbg_build/lib/libevpp_lite_static.a")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/evpp" TYPE FILE FILES
+    "/root/repo/evpp/any.h"
+    "/root/repo/evpp/buffer.h"
+    "/root/repo/evpp/buffer_pool.h"
+    "/root/repo/evpp/compute_pool.h"
+    "/root/repo/evpp/connection_table.h"
+    "/root/repo/evpp/connector.h"
+    "/root/repo/evpp/dns_resolver.h"
+    "/root/repo/evpp/duration.h"
+    "/root/repo/evpp/duration.inl.h"
+    "/root/repo/evpp/epoll_poller.h"
+    "/root/repo/evpp/event_loop.h"
+    "/root/repo/evpp/event_loop_thread.h"
+    "/root/repo/evpp/event_loop_thread_pool.h"
+    "/root/repo/evpp/event_watcher.h"
+    "/root/repo/evpp/evlog.h"
+    "/root/repo/evpp/fd_channel.h"
+    "/root/repo/evpp/gettimeofday.h"
+    "/root/repo/evpp/inner_pre.h"
+    "/root/repo/evpp/invoke_timer.h"
+    "/root/repo/evpp/io_uring_engine.h"
+    "/root/repo/evpp/libevent.h"
+    "/root/repo/evpp/listener.h"
+    "/root/repo/evpp/logger.h"
+    "/root/repo/evpp/loop_metrics.h"
+    "/root/repo/evpp/memmem.h"
+    "/root/repo/evpp/memsearch.h"
+    "/root/repo/evpp/mpsc_queue.h"
+    "/root/repo/evpp/numa.h"
+    "/root/repo/evpp/output_queue.h"
+    "/root/repo/evpp/platform_config.h"
+    "/root/repo/evpp/server_status.h"
+    "/root/repo/evpp/slice.h"
+    "/root/repo/evpp/sockets.h"
+    "/root/repo/evpp/sys_addrinfo.h"
+    "/root/repo/evpp/sys_sockets.h"
+    "/root/repo/evpp/task.h"
+    "/root/repo/evpp/tcp_callbacks.h"
+    "/root/repo/evpp/tcp_client.h"
+    "/root/repo/evpp/tcp_conn.h"
+    "/root/repo/evpp/tcp_server.h"
+    "/root/repo/evpp/thread_dispatch_policy.h"
+    "/root/repo/evpp/timestamp.h"
+    "/root/repo/evpp/timestamp.inl.h"
+    "/root/repo/evpp/timing_wheel.h"
+    "/root/repo/evpp/utility.h"
+    "/root/repo/evpp/windows_port.h"
+    "/root/repo/evpp/work_stealing_deque.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/evpp/http" TYPE FILE FILES
+    "/root/repo/evpp/http/context.h"
+    "/root/repo/evpp/http/http_server.h"
+    "/root/repo/evpp/http/service.h"
+    "/root/repo/evpp/http/stats.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/evpp/evpphttp" TYPE FILE FILES
+    "/root/repo/evpp/evpphttp/http_parser.h"
+    "/root/repo/evpp/evpphttp/http_request.h"
+    "/root/repo/evpp/evpphttp/http_response.h"
+    "/root/repo/evpp/evpphttp/service.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/evpp/httpc" TYPE FILE FILES
+    "/root/repo/evpp/httpc/conn.h"
+    "/root/repo/evpp/httpc/conn_pool.h"
+    "/root/repo/evpp/httpc/request.h"
+    "/root/repo/evpp/httpc/response.h"
+    "/root/repo/evpp/httpc/ssl.h"
+    "/root/repo/evpp/httpc/url_parser.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/evpp/udp" TYPE FILE FILES
+    "/root/repo/evpp/udp/sync_udp_client.h"
+    "/root/repo/evpp/udp/udp_message.h"
+    "/root/repo/evpp/udp/udp_server.h"
+    )
+endif()
+
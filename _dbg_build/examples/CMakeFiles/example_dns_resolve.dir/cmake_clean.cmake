@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_dns_resolve"
+  "../bin/example_dns_resolve.pdb"
+  "CMakeFiles/example_dns_resolve.dir/dns_resolve/main.cc.o"
+  "CMakeFiles/example_dns_resolve.dir/dns_resolve/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_dns_resolve.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
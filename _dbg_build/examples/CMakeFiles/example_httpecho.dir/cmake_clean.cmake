@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_httpecho"
+  "../bin/example_httpecho.pdb"
+  "CMakeFiles/example_httpecho.dir/echo/httpecho/main.cc.o"
+  "CMakeFiles/example_httpecho.dir/echo/httpecho/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_httpecho.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_multi_accept"
+  "../bin/example_multi_accept.pdb"
+  "CMakeFiles/example_multi_accept.dir/multi_accept/main.cc.o"
+  "CMakeFiles/example_multi_accept.dir/multi_accept/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_multi_accept.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_pingpong_client"
+  "../bin/example_pingpong_client.pdb"
+  "CMakeFiles/example_pingpong_client.dir/pingpong/client.cc.o"
+  "CMakeFiles/example_pingpong_client.dir/pingpong/client.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_pingpong_client.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_pingpong_server"
+  "../bin/example_pingpong_server.pdb"
+  "CMakeFiles/example_pingpong_server.dir/pingpong/server.cc.o"
+  "CMakeFiles/example_pingpong_server.dir/pingpong/server.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_pingpong_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_signal01"
+  "../bin/example_signal01.pdb"
+  "CMakeFiles/example_signal01.dir/signal/signal01.cc.o"
+  "CMakeFiles/example_signal01.dir/signal/signal01.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_signal01.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_signal02"
+  "../bin/example_signal02.pdb"
+  "CMakeFiles/example_signal02.dir/signal/signal02.cc.o"
+  "CMakeFiles/example_signal02.dir/signal/signal02.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_signal02.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
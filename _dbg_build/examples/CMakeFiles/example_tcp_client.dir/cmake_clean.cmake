@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_tcp_client"
+  "../bin/example_tcp_client.pdb"
+  "CMakeFiles/example_tcp_client.dir/tcp/tcp_client.cc.o"
+  "CMakeFiles/example_tcp_client.dir/tcp/tcp_client.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_tcp_client.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_tcp_server"
+  "../bin/example_tcp_server.pdb"
+  "CMakeFiles/example_tcp_server.dir/tcp/tcp_server.cc.o"
+  "CMakeFiles/example_tcp_server.dir/tcp/tcp_server.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_tcp_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_tcpecho"
+  "../bin/example_tcpecho.pdb"
+  "CMakeFiles/example_tcpecho.dir/echo/tcpecho/main.cc.o"
+  "CMakeFiles/example_tcpecho.dir/echo/tcpecho/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_tcpecho.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_timer01"
+  "../bin/example_timer01.pdb"
+  "CMakeFiles/example_timer01.dir/timer/timer01.cc.o"
+  "CMakeFiles/example_timer01.dir/timer/timer01.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_timer01.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
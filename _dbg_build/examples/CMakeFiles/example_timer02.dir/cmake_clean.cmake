@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_timer02"
+  "../bin/example_timer02.pdb"
+  "CMakeFiles/example_timer02.dir/timer/timer02.cc.o"
+  "CMakeFiles/example_timer02.dir/timer/timer02.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_timer02.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_timer03"
+  "../bin/example_timer03.pdb"
+  "CMakeFiles/example_timer03.dir/timer/timer03.cc.o"
+  "CMakeFiles/example_timer03.dir/timer/timer03.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_timer03.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
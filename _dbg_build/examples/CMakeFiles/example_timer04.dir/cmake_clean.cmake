@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_timer04"
+  "../bin/example_timer04.pdb"
+  "CMakeFiles/example_timer04.dir/timer/timer04.cc.o"
+  "CMakeFiles/example_timer04.dir/timer/timer04.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_timer04.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_timer05"
+  "../bin/example_timer05.pdb"
+  "CMakeFiles/example_timer05.dir/timer/timer05.cc.o"
+  "CMakeFiles/example_timer05.dir/timer/timer05.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_timer05.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
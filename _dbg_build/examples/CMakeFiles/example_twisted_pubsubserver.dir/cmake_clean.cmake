@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_twisted_pubsubserver"
+  "../bin/example_twisted_pubsubserver.pdb"
+  "CMakeFiles/example_twisted_pubsubserver.dir/twisted/pubsubserver/main.cc.o"
+  "CMakeFiles/example_twisted_pubsubserver.dir/twisted/pubsubserver/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_twisted_pubsubserver.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
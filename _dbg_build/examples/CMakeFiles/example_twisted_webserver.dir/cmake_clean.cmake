@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_twisted_webserver"
+  "../bin/example_twisted_webserver.pdb"
+  "CMakeFiles/example_twisted_webserver.dir/twisted/webserver/main.cc.o"
+  "CMakeFiles/example_twisted_webserver.dir/twisted/webserver/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_twisted_webserver.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/example_udpecho"
+  "../bin/example_udpecho.pdb"
+  "CMakeFiles/example_udpecho.dir/echo/udpecho/main.cc.o"
+  "CMakeFiles/example_udpecho.dir/echo/udpecho/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_udpecho.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../bin/rpc_client"
+  "../bin/rpc_client.pdb"
+  "CMakeFiles/rpc_client.dir/rpc/client.cc.o"
+  "CMakeFiles/rpc_client.dir/rpc/client.cc.o.d"
+  "CMakeFiles/rpc_client.dir/rpc/rpc_client.cc.o"
+  "CMakeFiles/rpc_client.dir/rpc/rpc_client.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rpc_client.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
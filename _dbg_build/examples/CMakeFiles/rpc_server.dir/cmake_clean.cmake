@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/rpc_server"
+  "../bin/rpc_server.pdb"
+  "CMakeFiles/rpc_server.dir/rpc/rpc_server.cc.o"
+  "CMakeFiles/rpc_server.dir/rpc/rpc_server.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rpc_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/example_chatroom_simple_client"
+  "../../../bin/example_chatroom_simple_client.pdb"
+  "CMakeFiles/example_chatroom_simple_client.dir/client.cc.o"
+  "CMakeFiles/example_chatroom_simple_client.dir/client.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_chatroom_simple_client.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/example_chatroom_simple_server"
+  "../../../bin/example_chatroom_simple_server.pdb"
+  "CMakeFiles/example_chatroom_simple_server.dir/server.cc.o"
+  "CMakeFiles/example_chatroom_simple_server.dir/server.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_chatroom_simple_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
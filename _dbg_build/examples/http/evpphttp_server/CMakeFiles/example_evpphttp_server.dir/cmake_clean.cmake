@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/example_evpphttp_server"
+  "../../../bin/example_evpphttp_server.pdb"
+  "CMakeFiles/example_evpphttp_server.dir/main.cc.o"
+  "CMakeFiles/example_evpphttp_server.dir/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_evpphttp_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
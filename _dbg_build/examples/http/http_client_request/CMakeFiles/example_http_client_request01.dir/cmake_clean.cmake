@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/example_http_client_request01"
+  "../../../bin/example_http_client_request01.pdb"
+  "CMakeFiles/example_http_client_request01.dir/client01.cc.o"
+  "CMakeFiles/example_http_client_request01.dir/client01.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_http_client_request01.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
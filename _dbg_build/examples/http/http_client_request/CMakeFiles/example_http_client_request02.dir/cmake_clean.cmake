@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/example_http_client_request02"
+  "../../../bin/example_http_client_request02.pdb"
+  "CMakeFiles/example_http_client_request02.dir/client02.cc.o"
+  "CMakeFiles/example_http_client_request02.dir/client02.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_http_client_request02.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
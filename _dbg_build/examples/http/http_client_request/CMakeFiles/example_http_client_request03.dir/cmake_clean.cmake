@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/example_http_client_request03"
+  "../../../bin/example_http_client_request03.pdb"
+  "CMakeFiles/example_http_client_request03.dir/client03.cc.o"
+  "CMakeFiles/example_http_client_request03.dir/client03.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_http_client_request03.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
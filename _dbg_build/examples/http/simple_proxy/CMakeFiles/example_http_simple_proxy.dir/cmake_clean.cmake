@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/example_http_simple_proxy"
+  "../../../bin/example_http_simple_proxy.pdb"
+  "CMakeFiles/example_http_simple_proxy.dir/main.cc.o"
+  "CMakeFiles/example_http_simple_proxy.dir/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_http_simple_proxy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
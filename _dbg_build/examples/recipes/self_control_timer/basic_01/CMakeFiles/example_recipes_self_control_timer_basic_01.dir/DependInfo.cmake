@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/examples/recipes/self_control_timer/basic_01/event_watcher.cc" "examples/recipes/self_control_timer/basic_01/CMakeFiles/example_recipes_self_control_timer_basic_01.dir/event_watcher.cc.o" "gcc" "examples/recipes/self_control_timer/basic_01/CMakeFiles/example_recipes_self_control_timer_basic_01.dir/event_watcher.cc.o.d"
+  "/root/repo/examples/recipes/self_control_timer/basic_01/invoke_timer.cc" "examples/recipes/self_control_timer/basic_01/CMakeFiles/example_recipes_self_control_timer_basic_01.dir/invoke_timer.cc.o" "gcc" "examples/recipes/self_control_timer/basic_01/CMakeFiles/example_recipes_self_control_timer_basic_01.dir/invoke_timer.cc.o.d"
+  "/root/repo/examples/recipes/self_control_timer/basic_01/main.cc" "examples/recipes/self_control_timer/basic_01/CMakeFiles/example_recipes_self_control_timer_basic_01.dir/main.cc.o" "gcc" "examples/recipes/self_control_timer/basic_01/CMakeFiles/example_recipes_self_control_timer_basic_01.dir/main.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
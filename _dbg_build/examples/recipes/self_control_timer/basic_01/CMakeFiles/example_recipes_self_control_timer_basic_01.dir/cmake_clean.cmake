@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../../../bin/example_recipes_self_control_timer_basic_01"
+  "../../../../bin/example_recipes_self_control_timer_basic_01.pdb"
+  "CMakeFiles/example_recipes_self_control_timer_basic_01.dir/event_watcher.cc.o"
+  "CMakeFiles/example_recipes_self_control_timer_basic_01.dir/event_watcher.cc.o.d"
+  "CMakeFiles/example_recipes_self_control_timer_basic_01.dir/invoke_timer.cc.o"
+  "CMakeFiles/example_recipes_self_control_timer_basic_01.dir/invoke_timer.cc.o.d"
+  "CMakeFiles/example_recipes_self_control_timer_basic_01.dir/main.cc.o"
+  "CMakeFiles/example_recipes_self_control_timer_basic_01.dir/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_recipes_self_control_timer_basic_01.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
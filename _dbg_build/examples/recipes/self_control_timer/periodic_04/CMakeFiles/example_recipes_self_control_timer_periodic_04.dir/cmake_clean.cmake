@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../../../bin/example_recipes_self_control_timer_periodic_04"
+  "../../../../bin/example_recipes_self_control_timer_periodic_04.pdb"
+  "CMakeFiles/example_recipes_self_control_timer_periodic_04.dir/event_watcher.cc.o"
+  "CMakeFiles/example_recipes_self_control_timer_periodic_04.dir/event_watcher.cc.o.d"
+  "CMakeFiles/example_recipes_self_control_timer_periodic_04.dir/invoke_timer.cc.o"
+  "CMakeFiles/example_recipes_self_control_timer_periodic_04.dir/invoke_timer.cc.o.d"
+  "CMakeFiles/example_recipes_self_control_timer_periodic_04.dir/main.cc.o"
+  "CMakeFiles/example_recipes_self_control_timer_periodic_04.dir/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_recipes_self_control_timer_periodic_04.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
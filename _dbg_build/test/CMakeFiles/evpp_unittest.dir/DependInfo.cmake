@@ -0,0 +1,55 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/3rdparty/gtest/src/gtest-all.cc" "test/CMakeFiles/evpp_unittest.dir/__/3rdparty/gtest/src/gtest-all.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/__/3rdparty/gtest/src/gtest-all.cc.o.d"
+  "/root/repo/3rdparty/gtest/src/gtest_main.cc" "test/CMakeFiles/evpp_unittest.dir/__/3rdparty/gtest/src/gtest_main.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/__/3rdparty/gtest/src/gtest_main.cc.o.d"
+  "/root/repo/test/any_test.cc" "test/CMakeFiles/evpp_unittest.dir/any_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/any_test.cc.o.d"
+  "/root/repo/test/buffer_pool_test.cc" "test/CMakeFiles/evpp_unittest.dir/buffer_pool_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/buffer_pool_test.cc.o.d"
+  "/root/repo/test/buffer_test.cc" "test/CMakeFiles/evpp_unittest.dir/buffer_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/buffer_test.cc.o.d"
+  "/root/repo/test/compute_pool_test.cc" "test/CMakeFiles/evpp_unittest.dir/compute_pool_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/compute_pool_test.cc.o.d"
+  "/root/repo/test/connection_table_test.cc" "test/CMakeFiles/evpp_unittest.dir/connection_table_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/connection_table_test.cc.o.d"
+  "/root/repo/test/dns_resolver_test.cc" "test/CMakeFiles/evpp_unittest.dir/dns_resolver_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/dns_resolver_test.cc.o.d"
+  "/root/repo/test/epoll_poller_test.cc" "test/CMakeFiles/evpp_unittest.dir/epoll_poller_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/epoll_poller_test.cc.o.d"
+  "/root/repo/test/event_condition_test.cc" "test/CMakeFiles/evpp_unittest.dir/event_condition_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/event_condition_test.cc.o.d"
+  "/root/repo/test/event_loop_test.cc" "test/CMakeFiles/evpp_unittest.dir/event_loop_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/event_loop_test.cc.o.d"
+  "/root/repo/test/event_loop_thread_pool_test.cc" "test/CMakeFiles/evpp_unittest.dir/event_loop_thread_pool_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/event_loop_thread_pool_test.cc.o.d"
+  "/root/repo/test/event_loop_thread_test.cc" "test/CMakeFiles/evpp_unittest.dir/event_loop_thread_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/event_loop_thread_test.cc.o.d"
+  "/root/repo/test/event_watcher_test.cc" "test/CMakeFiles/evpp_unittest.dir/event_watcher_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/event_watcher_test.cc.o.d"
+  "/root/repo/test/evhttp_client_test.cc" "test/CMakeFiles/evpp_unittest.dir/evhttp_client_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/evhttp_client_test.cc.o.d"
+  "/root/repo/test/evpphttp_server_test.cc" "test/CMakeFiles/evpp_unittest.dir/evpphttp_server_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/evpphttp_server_test.cc.o.d"
+  "/root/repo/test/http_client_test.cc" "test/CMakeFiles/evpp_unittest.dir/http_client_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/http_client_test.cc.o.d"
+  "/root/repo/test/http_server_test.cc" "test/CMakeFiles/evpp_unittest.dir/http_server_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/http_server_test.cc.o.d"
+  "/root/repo/test/http_trivial_test.cc" "test/CMakeFiles/evpp_unittest.dir/http_trivial_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/http_trivial_test.cc.o.d"
+  "/root/repo/test/invoke_timer_test.cc" "test/CMakeFiles/evpp_unittest.dir/invoke_timer_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/invoke_timer_test.cc.o.d"
+  "/root/repo/test/io_uring_engine_test.cc" "test/CMakeFiles/evpp_unittest.dir/io_uring_engine_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/io_uring_engine_test.cc.o.d"
+  "/root/repo/test/loop_metrics_test.cc" "test/CMakeFiles/evpp_unittest.dir/loop_metrics_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/loop_metrics_test.cc.o.d"
+  "/root/repo/test/mpsc_queue_test.cc" "test/CMakeFiles/evpp_unittest.dir/mpsc_queue_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/mpsc_queue_test.cc.o.d"
+  "/root/repo/test/numa_test.cc" "test/CMakeFiles/evpp_unittest.dir/numa_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/numa_test.cc.o.d"
+  "/root/repo/test/output_queue_test.cc" "test/CMakeFiles/evpp_unittest.dir/output_queue_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/output_queue_test.cc.o.d"
+  "/root/repo/test/sockets_test.cc" "test/CMakeFiles/evpp_unittest.dir/sockets_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/sockets_test.cc.o.d"
+  "/root/repo/test/task_test.cc" "test/CMakeFiles/evpp_unittest.dir/task_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/task_test.cc.o.d"
+  "/root/repo/test/tcp_client_reconnect_test.cc" "test/CMakeFiles/evpp_unittest.dir/tcp_client_reconnect_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/tcp_client_reconnect_test.cc.o.d"
+  "/root/repo/test/tcp_client_test.cc" "test/CMakeFiles/evpp_unittest.dir/tcp_client_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/tcp_client_test.cc.o.d"
+  "/root/repo/test/tcp_server_test.cc" "test/CMakeFiles/evpp_unittest.dir/tcp_server_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/tcp_server_test.cc.o.d"
+  "/root/repo/test/time_test.cc" "test/CMakeFiles/evpp_unittest.dir/time_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/time_test.cc.o.d"
+  "/root/repo/test/timing_wheel_test.cc" "test/CMakeFiles/evpp_unittest.dir/timing_wheel_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/timing_wheel_test.cc.o.d"
+  "/root/repo/test/trivial_test.cc" "test/CMakeFiles/evpp_unittest.dir/trivial_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/trivial_test.cc.o.d"
+  "/root/repo/test/udp_server_test.cc" "test/CMakeFiles/evpp_unittest.dir/udp_server_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/udp_server_test.cc.o.d"
+  "/root/repo/test/utility_test.cc" "test/CMakeFiles/evpp_unittest.dir/utility_test.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/utility_test.cc.o.d"
+  "/root/repo/test/winmain.cc" "test/CMakeFiles/evpp_unittest.dir/winmain.cc.o" "gcc" "test/CMakeFiles/evpp_unittest.dir/winmain.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_dbg_build/evpp/CMakeFiles/evpp_static.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,81 @@
+file(REMOVE_RECURSE
+  "../bin/evpp_unittest"
+  "../bin/evpp_unittest.pdb"
+  "CMakeFiles/evpp_unittest.dir/__/3rdparty/gtest/src/gtest-all.cc.o"
+  "CMakeFiles/evpp_unittest.dir/__/3rdparty/gtest/src/gtest-all.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/__/3rdparty/gtest/src/gtest_main.cc.o"
+  "CMakeFiles/evpp_unittest.dir/__/3rdparty/gtest/src/gtest_main.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/any_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/any_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/buffer_pool_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/buffer_pool_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/buffer_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/buffer_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/compute_pool_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/compute_pool_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/connection_table_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/connection_table_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/dns_resolver_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/dns_resolver_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/epoll_poller_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/epoll_poller_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/event_condition_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/event_condition_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/event_loop_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/event_loop_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/event_loop_thread_pool_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/event_loop_thread_pool_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/event_loop_thread_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/event_loop_thread_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/event_watcher_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/event_watcher_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/evhttp_client_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/evhttp_client_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/evpphttp_server_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/evpphttp_server_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/http_client_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/http_client_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/http_server_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/http_server_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/http_trivial_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/http_trivial_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/invoke_timer_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/invoke_timer_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/io_uring_engine_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/io_uring_engine_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/loop_metrics_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/loop_metrics_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/mpsc_queue_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/mpsc_queue_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/numa_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/numa_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/output_queue_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/output_queue_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/sockets_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/sockets_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/task_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/task_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/tcp_client_reconnect_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/tcp_client_reconnect_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/tcp_client_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/tcp_client_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/tcp_server_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/tcp_server_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/time_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/time_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/timing_wheel_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/timing_wheel_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/trivial_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/trivial_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/udp_server_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/udp_server_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/utility_test.cc.o"
+  "CMakeFiles/evpp_unittest.dir/utility_test.cc.o.d"
+  "CMakeFiles/evpp_unittest.dir/winmain.cc.o"
+  "CMakeFiles/evpp_unittest.dir/winmain.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/evpp_unittest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
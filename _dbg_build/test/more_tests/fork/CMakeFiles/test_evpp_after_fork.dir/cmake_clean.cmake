@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/test_evpp_after_fork"
+  "../../../bin/test_evpp_after_fork.pdb"
+  "CMakeFiles/test_evpp_after_fork.dir/main.cc.o"
+  "CMakeFiles/test_evpp_after_fork.dir/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_evpp_after_fork.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
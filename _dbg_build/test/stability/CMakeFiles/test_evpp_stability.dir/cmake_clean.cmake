@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/test_evpp_stability"
+  "../../bin/test_evpp_stability.pdb"
+  "CMakeFiles/test_evpp_stability.dir/stability.cc.o"
+  "CMakeFiles/test_evpp_stability.dir/stability.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_evpp_stability.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -22,7 +22,7 @@ void MemcacheClient::PushRunningCommand(CommandPtr& cmd) {
     running_command_.emplace(cmd);
 
     if (UNLIKELY(!timeout_.IsZero() && timer_canceled_)) {
-        cmd_timer_ = exec_loop_->RunAfter(timeout_, std::bind(&MemcacheClient::OnPacketTimeout, shared_from_this(), cmd->id()));
+        cmd_timer_ = exec_loop_->RunAfter(timeout_, evpp::Task(std::bind(&MemcacheClient::OnPacketTimeout, shared_from_this(), cmd->id())), evpp::InvokeTimer::kWheelTimer);
         timer_canceled_ = false;
     }
 }
@@ -33,7 +33,7 @@ void MemcacheClient::PushWaitingCommand(CommandPtr& cmd) {
         waiting_command_.push(cmd);
     }
     if (UNLIKELY(!timeout_.IsZero() && con_timer_canceled_)) {
-        con_cmd_timer_ = exec_loop_->RunAfter(timeout_, std::bind(&MemcacheClient::OnConnectTimeout, shared_from_this(), cmd->id()));
+        con_cmd_timer_ = exec_loop_->RunAfter(timeout_, evpp::Task(std::bind(&MemcacheClient::OnConnectTimeout, shared_from_this(), cmd->id())), evpp::InvokeTimer::kWheelTimer);
         con_timer_canceled_ = false;
     }
 }
@@ -73,7 +73,7 @@ void MemcacheClient::OnConnectTimeout(uint32_t cmd_id) {
         CommandPtr cmd(waiting_command_.front());
         if (LIKELY(cmd->id() != cmd_id)) {
             cmd_timer_bakup_.swap(con_cmd_timer_);
-            con_cmd_timer_ = exec_loop_->RunAfter(timeout_, std::bind(&MemcacheClient::OnConnectTimeout, shared_from_this(), cmd->id()));
+            con_cmd_timer_ = exec_loop_->RunAfter(timeout_, evpp::Task(std::bind(&MemcacheClient::OnConnectTimeout, shared_from_this(), cmd->id())), evpp::InvokeTimer::kWheelTimer);
             con_timer_canceled_ = false;
             return;
         }
@@ -103,7 +103,7 @@ void MemcacheClient::OnPacketTimeout(uint32_t cmd_id) {
         CommandPtr cmd(running_command_.front());
         if (LIKELY(cmd->id() != cmd_id)) {
             cmd_timer_bakup_.swap(cmd_timer_);
-            cmd_timer_ = exec_loop_->RunAfter(timeout_, std::bind(&MemcacheClient::OnPacketTimeout, shared_from_this(), cmd->id()));
+            cmd_timer_ = exec_loop_->RunAfter(timeout_, evpp::Task(std::bind(&MemcacheClient::OnPacketTimeout, shared_from_this(), cmd->id())), evpp::InvokeTimer::kWheelTimer);
             timer_canceled_ = false;
             return;
         }
@@ -0,0 +1,110 @@
+// The delimiter search of Buffer on 8KB HTTP like header blocks.
+//
+// 1. one shot : find CRLFCRLF in a complete block by std::search,
+//    which Buffer::FindCRLF used before, and by every memsearch kernel.
+// 2. incremental : the block arrives in 256 bytes pieces and CRLFCRLF is
+//    searched after every piece, from data() and by the resumable Buffer::Find.
+//
+// Usage : benchmark_buffer [iterations]
+
+#include <evpp/buffer.h>
+#include <evpp/memsearch.h>
+#include <evpp/timestamp.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+static std::string MakeHeader() {
+    std::string s = "GET /index.html HTTP/1.1\r\n";
+    int i = 0;
+    while (s.size() < 8 * 1024 - 64) {
+        s += "X-Header-" + std::to_string(i++) + ": " + std::string(40, 'v') + "\r\n";
+    }
+    s.append(8 * 1024 - 4 - s.size(), 'p');
+    s += "\r\n\r\n";
+    return s;
+}
+
+static const char* Search(const char* begin, const char* end, const char* delim, size_t n) {
+    const char* p = std::search(begin, end, delim, delim + n);
+    return p == end ? nullptr : p;
+}
+
+static void Report(const char* name, const char* what, evpp::Timestamp start, size_t bytes, int iterations) {
+    double ns = double((evpp::Timestamp::Now() - start).Nanoseconds());
+    std::cout << name << " " << what
+              << " " << ns / iterations << "ns/op"
+              << " " << double(bytes) * iterations / ns << "GB/s\n";
+}
+
+// The CRLFCRLF is at the end, so the whole block is searched
+static void BenchOneShot(const std::string& header, int iterations) {
+    const char* begin = header.data();
+    const char* end = begin + header.size();
+    const char* expected = begin + header.size() - 4;
+
+    struct {
+        const char* name;
+        evpp::memsearch::Kernel kernel;
+    } kernels[] = {
+        { "std::search", &Search },
+        { "scalar", evpp::memsearch::ScalarKernel() },
+        { "sse2", evpp::memsearch::SSE2Kernel() },
+        { "avx2", evpp::memsearch::AVX2Kernel() },
+    };
+
+    for (auto& k : kernels) {
+        if (k.kernel == nullptr) {
+            std::cout << k.name << " is not supported\n";
+            continue;
+        }
+
+        size_t found = 0;
+        evpp::Timestamp start = evpp::Timestamp::Now();
+        for (int i = 0; i < iterations; i++) {
+            // Start at an odd offset every other time, so the loads are not always aligned
+            found += k.kernel(begin + i % 2, end, "\r\n\r\n", 4) == expected;
+        }
+        if (found != size_t(iterations)) {
+            std::cerr << k.name << " failed\n";
+            std::exit(1);
+        }
+        Report(k.name, "CRLFCRLF 8KB", start, header.size(), iterations);
+    }
+}
+
+static void BenchIncremental(const std::string& header, int iterations, bool resumable) {
+    const size_t kPiece = 256;
+    evpp::Buffer buf;
+    evpp::Timestamp start = evpp::Timestamp::Now();
+    for (int i = 0; i < iterations; i++) {
+        size_t scanned = 0;
+        const char* found = nullptr;
+        for (size_t off = 0; off < header.size() && found == nullptr; off += kPiece) {
+            buf.Append(header.data() + off, std::min(kPiece, header.size() - off));
+            found = resumable ? buf.Find("\r\n\r\n", 4, &scanned) : buf.FindCRLFCRLF();
+        }
+        if (found == nullptr) {
+            std::cerr << "not found\n";
+            std::exit(1);
+        }
+        buf.Reset();
+    }
+    Report(resumable ? "resumable" : "from-start", "incremental 8KB", start, header.size(), iterations);
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = 200000;
+    if (argc > 1) {
+        iterations = std::atoi(argv[1]);
+    }
+
+    const std::string header = MakeHeader();
+    std::cout << "kernel=" << evpp::memsearch::KernelName() << "\n";
+    BenchOneShot(header, iterations);
+    BenchIncremental(header, iterations / 10, false);
+    BenchIncremental(header, iterations / 10, true);
+    return 0;
+}
@@ -0,0 +1,114 @@
+// The request latency of the dispatch policies of EventLoopThreadPool under
+// a skewed load : 10% of the connections are heavy, whose requests take 2ms,
+// and the others take 50us. The cost is simulated by sleeping, so the loops
+// behave like they are waiting on a backend and the result doesn't depend
+// on the count of the CPUs.
+//
+// A connection arrives every interval, is dispatched by the policy, sends
+// its requests at once and is closed after the last one is processed, like
+// what TCPServer counts by AddLoad.
+//
+// Usage : benchmark_dispatch [connections] [threads] [interval_us]
+
+#include <evpp/event_loop.h>
+#include <evpp/event_loop_thread.h>
+#include <evpp/event_loop_thread_pool.h>
+#include <evpp/timestamp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+const int kRequestsPerConn = 10;
+const int kHeavyCostUs = 2000;
+const int kLightCostUs = 50;
+
+struct Result {
+    std::mutex mutex;
+    std::vector<int64_t> latencies; // In microseconds
+};
+
+void Run(const char* name, evpp::ThreadDispatchPolicy::Policy policy, int conns, int threads, int interval_us) {
+    evpp::EventLoopThread base;
+    base.Start(true);
+    evpp::EventLoopThreadPool pool(base.loop(), threads);
+    pool.Start(true);
+
+    Result result;
+    result.latencies.reserve(conns * kRequestsPerConn);
+    std::atomic<int> closed(0);
+    uint64_t seed = 88172645463325252ull;
+
+    for (int i = 0; i < conns; i++) {
+        // xorshift, the same sequence for every policy
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        bool heavy = seed % 10 == 0;
+        int cost = heavy ? kHeavyCostUs : kLightCostUs;
+
+        evpp::EventLoop* loop = pool.GetNextLoop(policy, seed);
+        pool.AddLoad(loop, 1);
+        evpp::Timestamp arrived = evpp::Timestamp::Now();
+        std::shared_ptr<int> remaining = std::make_shared<int>(kRequestsPerConn);
+        for (int r = 0; r < kRequestsPerConn; r++) {
+            loop->QueueInLoop([&, loop, cost, arrived, remaining]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(cost));
+                int64_t us = (evpp::Timestamp::Now() - arrived).Nanoseconds() / 1000;
+                {
+                    std::lock_guard<std::mutex> g(result.mutex);
+                    result.latencies.push_back(us);
+                }
+                if (--*remaining == 0) {
+                    pool.AddLoad(loop, -1);
+                    closed++;
+                }
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(interval_us));
+    }
+
+    while (closed.load() < conns) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    pool.Stop(true);
+    base.Stop(true);
+
+    std::vector<int64_t>& l = result.latencies;
+    std::sort(l.begin(), l.end());
+    std::cout << name
+              << " p50=" << l[l.size() / 2] << "us"
+              << " p99=" << l[l.size() * 99 / 100] << "us"
+              << " max=" << l.back() << "us\n";
+}
+}
+
+int main(int argc, char* argv[]) {
+    int conns = 2000;
+    int threads = 4;
+    int interval_us = 1000;
+    if (argc > 1) {
+        conns = std::atoi(argv[1]);
+    }
+    if (argc > 2) {
+        threads = std::atoi(argv[2]);
+    }
+    if (argc > 3) {
+        interval_us = std::atoi(argv[3]);
+    }
+
+    typedef evpp::ThreadDispatchPolicy P;
+    Run("round-robin", P::kRoundRobin, conns, threads, interval_us);
+    Run("ip-hashing", P::kIPAddressHashing, conns, threads, interval_us);
+    Run("consistent-hashing", P::kConsistentHashing, conns, threads, interval_us);
+    Run("least-connections", P::kLeastConnections, conns, threads, interval_us);
+    Run("least-pending-functors", P::kLeastPendingFunctors, conns, threads, interval_us);
+    Run("power-of-two-choices", P::kPowerOfTwoChoices, conns, threads, interval_us);
+    return 0;
+}
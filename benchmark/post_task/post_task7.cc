@@ -0,0 +1,91 @@
+#include <evpp/event_loop.h>
+#include <evpp/event_loop_thread.h>
+
+#include "examples/winmain-inl.h"
+
+uint64_t clock_us() {
+    return std::chrono::steady_clock::now().time_since_epoch().count() / 1000;
+}
+
+// posttask7 : thread 1 posts tasks to thread 2 like posttask3, but every task
+// captures a std::shared_ptr and a std::string, the same as TCPConn::Send does.
+// It runs twice : once with std::function<void()> and once with evpp::Task
+// to compare the cost of the heap allocation of std::function.
+class PostTask {
+public:
+    PostTask(uint64_t post_count, bool use_task)
+        : post_count_(post_count), use_task_(use_task) {
+    }
+
+    void Start() {
+        loop1_.Start(true);
+        loop2_.Start(true);
+        loop1_.loop()->RunInLoop([this]() {
+            std::shared_ptr<uint64_t> counter(new uint64_t(0));
+            std::string message(24, 'x');
+            start_time_ = clock_us();
+            for (size_t i = 0; i < post_count_; ++i) {
+                auto f = [this, counter, message]() {
+                    *counter += message.size() > 0 ? 1 : 0;
+                    if (*counter == post_count_) {
+                        stop();
+                    }
+                };
+                if (use_task_) {
+                    loop2_.loop()->QueueInLoop(evpp::Task(std::move(f)));
+                } else {
+                    loop2_.loop()->QueueInLoop(std::function<void()>(std::move(f)));
+                }
+            }
+        });
+    }
+
+    void Wait() {
+        while (!loop1_.IsStopped() || !loop2_.IsStopped()) {
+            usleep(1000);
+        }
+    }
+
+    double use_time() const {
+        return double(stop_time_ - start_time_) / 1000000.0;
+    }
+private:
+    void stop() {
+        stop_time_ = clock_us();
+        loop1_.Stop();
+        loop2_.Stop();
+    }
+private:
+    uint64_t const post_count_;
+    bool use_task_;
+    evpp::EventLoopThread loop1_; // send task
+    evpp::EventLoopThread loop2_; // execute task
+    uint64_t start_time_ = 0;
+    uint64_t stop_time_ = 0;
+};
+
+int main(int argc, char* argv[]) {
+    long long post_count = 10000;
+
+    if (argc == 2) {
+        post_count = std::atoll(argv[1]);
+    } else {
+        printf("Usage : %s <post-count>\n", argv[0]);
+        return 0;
+    }
+
+    {
+        PostTask p(post_count, false);
+        p.Start();
+        p.Wait();
+        printf("%s std::function post_count=%lld use time: %f seconds\n", argv[0], post_count, p.use_time());
+    }
+
+    {
+        PostTask p(post_count, true);
+        p.Start();
+        p.Wait();
+        printf("%s evpp::Task     post_count=%lld use time: %f seconds\n", argv[0], post_count, p.use_time());
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Compare the libevent based InvokeTimer with the TimingWheel based one.
+//
+// 1. start/cancel : start N timers with a long timeout and cancel all of them,
+//    which is what a request timeout does in the common case.
+// 2. expire : start N timers with delays spread in [1, 100ms] and wait until
+//    all of them are expired.
+//
+// Usage : benchmark_timer [timer_count]
+
+#include <evpp/event_loop.h>
+#include <evpp/timestamp.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+static const char* ModeName(evpp::InvokeTimer::Mode mode) {
+    return mode == evpp::InvokeTimer::kWheelTimer ? "wheel" : "libevent";
+}
+
+static void BenchStartCancel(evpp::EventLoop* loop, evpp::InvokeTimer::Mode mode, int count) {
+    std::vector<evpp::InvokeTimerPtr> timers;
+    timers.reserve(count);
+    evpp::Timestamp start = evpp::Timestamp::Now();
+    for (int i = 0; i < count; i++) {
+        timers.push_back(loop->RunAfter(evpp::Duration(10.0), evpp::Task([]() {}), mode));
+    }
+    evpp::Timestamp started = evpp::Timestamp::Now();
+    for (auto& t : timers) {
+        t->Cancel();
+    }
+    timers.clear();
+    evpp::Timestamp end = evpp::Timestamp::Now();
+
+    std::cout << ModeName(mode) << " start/cancel count=" << count
+              << " start=" << (started - start).Nanoseconds() / count << "ns/op"
+              << " cancel=" << (end - started).Nanoseconds() / count << "ns/op\n";
+}
+
+static void BenchExpire(evpp::EventLoop* loop, evpp::InvokeTimer::Mode mode, int count) {
+    int fired = 0;
+    double late_ms = 0;
+    evpp::Timestamp start = evpp::Timestamp::Now();
+    for (int i = 0; i < count; i++) {
+        evpp::Duration delay((i % 100 + 1) * evpp::Duration::kMillisecond);
+        evpp::Timestamp deadline = evpp::Timestamp::Now() + delay;
+        auto f = [loop, count, deadline, &fired, &late_ms]() {
+            late_ms += (evpp::Timestamp::Now() - deadline).Milliseconds();
+            if (++fired == count) {
+                loop->Stop();
+            }
+        };
+        loop->RunAfter(delay, evpp::Task(f), mode);
+    }
+    evpp::Timestamp started = evpp::Timestamp::Now();
+    loop->Run();
+
+    std::cout << ModeName(mode) << " expire count=" << count
+              << " start=" << (started - start).Nanoseconds() / count << "ns/op"
+              << " avg_lateness=" << late_ms / count << "ms\n";
+}
+
+int main(int argc, char* argv[]) {
+    int count = 200000;
+    if (argc > 1) {
+        count = std::atoi(argv[1]);
+    }
+
+    evpp::InvokeTimer::Mode modes[] = { evpp::InvokeTimer::kEventTimer, evpp::InvokeTimer::kWheelTimer };
+    for (auto mode : modes) {
+        evpp::EventLoop loop;
+        // Run the benchmarks inside the loop, the timers are created in the loop thread
+        loop.QueueInLoop([&loop, mode, count]() {
+            BenchStartCancel(&loop, mode, count);
+            loop.Stop();
+        });
+        loop.Run();
+    }
+
+    for (auto mode : modes) {
+        evpp::EventLoop loop;
+        BenchExpire(&loop, mode, count);
+    }
+    return 0;
+}
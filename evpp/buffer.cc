@@ -13,12 +13,45 @@
 #include "evpp/buffer.h"
 #include "evpp/sockets.h"
 
+#include <atomic>
+
 namespace evpp {
 const char Buffer::kCRLF[] = "\r\n";
 
 const size_t Buffer::kCheapPrependSize = 8;
 const size_t Buffer::kInitialSize  = 1024;
 
+namespace {
+class NewAllocator : public BufferAllocator {
+public:
+    char* Allocate(size_t size) override {
+        return new char[size];
+    }
+
+    void Deallocate(char* p, size_t) override {
+        delete[] p;
+    }
+};
+
+NewAllocator new_allocator;
+std::atomic<BufferAllocator*> default_buffer_allocator(&new_allocator);
+}
+
+void Buffer::SetDefaultAllocator(BufferAllocator* a) {
+    default_buffer_allocator.store(a ? a : &new_allocator, std::memory_order_release);
+}
+
+BufferAllocator* Buffer::default_allocator() {
+    return default_buffer_allocator.load(std::memory_order_acquire);
+}
+
+ssize_t Buffer::ReadFromFD(evpp_socket_t fd, int* savedErrno, size_t expected) {
+    if (expected > WritableBytes()) {
+        EnsureWritableBytes(expected);
+    }
+    return ReadFromFD(fd, savedErrno);
+}
+
 ssize_t Buffer::ReadFromFD(evpp_socket_t fd, int* savedErrno) {
     // saved an ioctl()/FIONREAD call to tell how much to read
     char extrabuf[65536];
@@ -6,14 +6,79 @@
 #include "evpp/inner_pre.h"
 #include "evpp/slice.h"
 #include "evpp/sockets.h"
+#include "evpp/memsearch.h"
 
 #include <algorithm>
+#include <atomic>
 
 namespace evpp {
 
 class Buffer;
 using BufferPtr = std::shared_ptr<Buffer>;
 
+// The allocator of the storage of Buffers, see Buffer::SetDefaultAllocator
+// and BufferPool. It MUST be thread safe : a Buffer may be freed by a thread
+// other than the one which allocated it.
+class EVPP_EXPORT BufferAllocator {
+public:
+    virtual ~BufferAllocator() {}
+
+    virtual char* Allocate(size_t size) = 0;
+
+    // @param size - The same size passed to Allocate
+    virtual void Deallocate(char* p, size_t size) = 0;
+
+    // @brief The size Allocate(size) really allocates, e.g. its size class,
+    //  which a Buffer requests instead so none of the block is wasted.
+    virtual size_t UsableSize(size_t size) const {
+        return size;
+    }
+};
+
+// A Slice which holds a reference of the storage it points to, see Buffer::NextShared.
+// It is still valid after the Buffer it comes from is modified or destroyed,
+// so it can be passed to another thread or kept for later without copying the bytes.
+class EVPP_EXPORT SharedSlice {
+public:
+    SharedSlice() {}
+    SharedSlice(const std::shared_ptr<void>& holder, const char* d, size_t n)
+        : holder_(holder), slice_(d, n) {}
+
+    const char* data() const {
+        return slice_.data();
+    }
+
+    size_t size() const {
+        return slice_.size();
+    }
+
+    bool empty() const {
+        return slice_.empty();
+    }
+
+    // Drop the first n bytes from this slice
+    void remove_prefix(size_t n) {
+        slice_.remove_prefix(n);
+    }
+
+    const Slice& ToSlice() const {
+        return slice_;
+    }
+
+    std::string ToString() const {
+        return slice_.ToString();
+    }
+
+    // The owner of the storage, e.g. to queue the bytes to an OutputQueue without copying
+    const std::shared_ptr<void>& holder() const {
+        return holder_;
+    }
+
+private:
+    std::shared_ptr<void> holder_;
+    Slice slice_;
+};
+
 class EVPP_EXPORT Buffer {
 public:
     static const size_t kCheapPrependSize;
@@ -23,15 +88,17 @@ public:
         : capacity_(reserved_prepend_size + initial_size)
         , read_index_(reserved_prepend_size)
         , write_index_(reserved_prepend_size)
-        , reserved_prepend_size_(reserved_prepend_size) {
-        buffer_ = new char[capacity_];
+        , reserved_prepend_size_(reserved_prepend_size)
+        , allocator_(default_allocator()) {
+        capacity_ = allocator_->UsableSize(capacity_);
+        buffer_ = allocator_->Allocate(capacity_);
         assert(length() == 0);
-        assert(WritableBytes() == initial_size);
+        assert(WritableBytes() >= initial_size);
         assert(PrependableBytes() == reserved_prepend_size);
     }
 
     ~Buffer() {
-        delete[] buffer_;
+        FreeStorage();
         buffer_ = nullptr;
         capacity_ = 0;
     }
@@ -42,8 +109,18 @@ public:
         std::swap(read_index_, rhs.read_index_);
         std::swap(write_index_, rhs.write_index_);
         std::swap(reserved_prepend_size_, rhs.reserved_prepend_size_);
+        std::swap(allocator_, rhs.allocator_);
+        std::swap(shared_, rhs.shared_);
     }
 
+    // @brief Set the allocator of the Buffers constructed after this call.
+    //  The default one uses new[] and delete[]. A Buffer keeps using the allocator
+    //  it is constructed with, so a must outlive all the Buffers allocated by it.
+    // @param a - nullptr to restore the default one
+    // @note It is thread safe.
+    static void SetDefaultAllocator(BufferAllocator* a);
+    static BufferAllocator* default_allocator();
+
     // Skip advances the reading index of the buffer
     void Skip(size_t len) {
         if (len < length()) {
@@ -64,6 +141,11 @@ public:
     // It does nothing if n is greater than the length of the buffer.
     void Truncate(size_t n) {
         if (n == 0) {
+            if (shared()) {
+                // Don't overwrite the bytes referenced by the SharedSlices
+                write_index_ = read_index_;
+                Reallocate(capacity_);
+            }
             read_index_ = reserved_prepend_size_;
             write_index_ = reserved_prepend_size_;
         } else if (write_index_ > read_index_ + n) {
@@ -181,7 +263,12 @@ public:
     }
 
     // Insert content, specified by the parameter, into the front of reading index
+    // @note If there are SharedSlices returned by NextShared, the readable
+    //  bytes are moved to a new storage first, and len is kCheapPrependSize at most.
     void Prepend(const void* /*restrict*/ d, size_t len) {
+        if (shared()) {
+            Reallocate(capacity_);
+        }
         assert(len <= PrependableBytes());
         read_index_ -= len;
         const char* p = static_cast<const char*>(d);
@@ -250,6 +337,20 @@ public:
     // and return result of readv, errno is saved into saved_errno
     ssize_t ReadFromFD(evpp_socket_t fd, int* saved_errno);
 
+    // The same as above, but it makes sure there are expected writable bytes
+    // first, so a read of the expected size goes into the buffer directly
+    // instead of the 64KB extra buffer on the stack, which is copied and
+    // appended. See TCPConn for how expected is estimated.
+    ssize_t ReadFromFD(evpp_socket_t fd, int* saved_errno, size_t expected);
+
+    // Release is the same as Shrink(0) when the buffer is empty : almost all
+    // the storage is given back to the allocator. It does nothing otherwise.
+    void Release() {
+        if (length() == 0 && capacity_ > reserved_prepend_size_) {
+            Shrink(0);
+        }
+    }
+
     // Next returns a slice containing the next n bytes from the buffer,
     // advancing the buffer as if the bytes had been returned by Read.
     // If there are fewer than n bytes in the buffer, Next returns the entire buffer.
@@ -264,6 +365,21 @@ public:
         return NextAll();
     }
 
+    // NextShared is the same as Next, but the returned slice holds a reference of
+    // the storage of the buffer, so it stays valid until it is destroyed, in
+    // any thread. The buffer won't overwrite or move the bytes referenced by the
+    // slices, it starts a new storage instead when it needs to.
+    SharedSlice NextShared(size_t len) {
+        if (!shared_) {
+            shared_.reset(buffer_, StorageDeleter(allocator_, capacity_));
+        }
+
+        len = std::min(len, length());
+        SharedSlice result(shared_, data(), len);
+        Skip(len);
+        return result;
+    }
+
     // NextAll returns a slice containing all the unread portion of the buffer,
     // advancing the buffer as if the bytes had been returned by Read.
     Slice NextAll() {
@@ -385,15 +501,41 @@ public:
     // Helpers
 public:
     const char* FindCRLF() const {
-        const char* crlf = std::search(data(), WriteBegin(), kCRLF, kCRLF + 2);
-        return crlf == WriteBegin() ? nullptr : crlf;
+        return memsearch::FindCRLF(data(), WriteBegin());
     }
 
     const char* FindCRLF(const char* start) const {
         assert(data() <= start);
         assert(start <= WriteBegin());
-        const char* crlf = std::search(start, WriteBegin(), kCRLF, kCRLF + 2);
-        return crlf == WriteBegin() ? nullptr : crlf;
+        return memsearch::FindCRLF(start, WriteBegin());
+    }
+
+    // The end of the header of HTTP, etc.
+    const char* FindCRLFCRLF() const {
+        return memsearch::FindCRLFCRLF(data(), WriteBegin());
+    }
+
+    // @brief Find the first occurrence of delim[0, n) in the readable bytes
+    // @return The position of it, or nullptr if it is not found
+    const char* Find(const char* delim, size_t n) const {
+        return memsearch::Find(data(), WriteBegin(), delim, n);
+    }
+
+    // @brief The resumable Find, which doesn't scan the same bytes again when
+    //  a codec searches the delimiter every time more data arrives.
+    // @param scanned - The count of the bytes from data() which have been searched.
+    //  It is set to 0 by the caller for the first search, and is updated
+    //  by every search which doesn't find the delimiter. It MUST be reset
+    //  after the data is retrieved, since it is an offset from data().
+    // @return The position of the delimiter, or nullptr if it is not found
+    const char* Find(const char* delim, size_t n, size_t* scanned) const {
+        assert(*scanned <= length());
+        const char* p = memsearch::Find(data() + *scanned, WriteBegin(), delim, n);
+        if (p == nullptr && length() >= n) {
+            // The tail shorter than delim may be the beginning of it
+            *scanned = std::max(*scanned, length() - n + 1);
+        }
+        return p;
     }
 
     const char* FindEOL() const {
@@ -420,15 +562,11 @@ private:
     void grow(size_t len) {
         if (WritableBytes() + PrependableBytes() < len + reserved_prepend_size_) {
             //grow the capacity
-            size_t n = (capacity_ << 1) + len;
-            size_t m = length();
-            char* d = new char[n];
-            memcpy(d + reserved_prepend_size_, begin() + read_index_, m);
-            write_index_ = m + reserved_prepend_size_;
-            read_index_ = reserved_prepend_size_;
-            capacity_ = n;
-            delete[] buffer_;
-            buffer_ = d;
+            Reallocate((capacity_ << 1) + len);
+        } else if (shared()) {
+            // The bytes before read_index_ are referenced by the SharedSlices,
+            // start a new storage instead of compacting
+            Reallocate(capacity_);
         } else {
             // move readable data to the front, make space inside buffer
             assert(reserved_prepend_size_ < read_index_);
@@ -441,12 +579,61 @@ private:
         }
     }
 
+    // Move the readable data to a new storage of n bytes
+    void Reallocate(size_t n) {
+        size_t m = length();
+        n = allocator_->UsableSize(std::max(n, m + reserved_prepend_size_));
+        char* d = allocator_->Allocate(n);
+        memcpy(d + reserved_prepend_size_, begin() + read_index_, m);
+        write_index_ = m + reserved_prepend_size_;
+        read_index_ = reserved_prepend_size_;
+        FreeStorage();
+        capacity_ = n;
+        buffer_ = d;
+    }
+
+    void FreeStorage() {
+        if (shared_) {
+            // The storage is freed by the last owner of it
+            shared_.reset();
+        } else {
+            allocator_->Deallocate(buffer_, capacity_);
+        }
+    }
+
+    // Whether the storage is referenced by any SharedSlice
+    bool shared() const {
+        if (!shared_) {
+            return false;
+        }
+
+        if (shared_.use_count() > 1) {
+            return true;
+        }
+
+        // The last SharedSlice may be released by another thread,
+        // its reads happen before the storage is written again.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return false;
+    }
+
+    struct StorageDeleter {
+        StorageDeleter(BufferAllocator* a, size_t n) : allocator(a), size(n) {}
+        void operator()(char* p) const {
+            allocator->Deallocate(p, size);
+        }
+        BufferAllocator* allocator;
+        size_t size;
+    };
+
 private:
     char* buffer_;
     size_t capacity_;
     size_t read_index_;
     size_t write_index_;
     size_t reserved_prepend_size_;
+    BufferAllocator* allocator_;
+    std::shared_ptr<char> shared_; // Owns buffer_ once a SharedSlice references it
     static const char kCRLF[];
 };
 
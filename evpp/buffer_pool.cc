@@ -0,0 +1,272 @@
+#include "evpp/inner_pre.h"
+
+#include <sstream>
+
+#include "evpp/buffer_pool.h"
+
+namespace evpp {
+
+BufferPoolStats::BufferPoolStats()
+    : allocations(0), thread_cache_hits(0), depot_hits(0), oversize(0),
+      thread_cache_bytes(0), depot_bytes(0) {}
+
+std::string BufferPoolStats::ToString() const {
+    std::stringstream ss;
+    ss << "allocations=" << allocations
+       << " thread_cache_hits=" << thread_cache_hits
+       << " depot_hits=" << depot_hits
+       << " hit_rate=" << hit_rate()
+       << " oversize=" << oversize
+       << " thread_cache_bytes=" << thread_cache_bytes
+       << " depot_bytes=" << depot_bytes;
+    return ss.str();
+}
+
+// The free lists and the counters of one thread. The counters have only
+// one writer, the owner thread, and are read by BufferPool::Stats.
+class BufferPool::ThreadCache {
+public:
+    explicit ThreadCache(BufferPool* p)
+        : pool(p), allocations(0), thread_cache_hits(0), depot_hits(0), oversize(0), bytes(0),
+          prev(nullptr), next(nullptr) {
+        pool->Register(this);
+    }
+
+    ~ThreadCache() {
+        for (int c = 0; c < kClassCount; c++) {
+            pool->PushToDepot(c, lists[c], lists[c].count);
+        }
+        bytes.store(0, std::memory_order_relaxed);
+        pool->Unregister(this);
+    }
+
+    template<typename T>
+    static void Add(std::atomic<T>& v, T n) {
+        v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    BufferPool* pool;
+    FreeList lists[kClassCount];
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> thread_cache_hits;
+    std::atomic<uint64_t> depot_hits;
+    std::atomic<uint64_t> oversize;
+    std::atomic<size_t> bytes;
+
+    // The list of the live caches, guarded by threads_mutex_
+    ThreadCache* prev;
+    ThreadCache* next;
+};
+
+BufferPool::BufferPool()
+    : depot_bytes_(0), threads_(nullptr) {}
+
+BufferPool::~BufferPool() {}
+
+BufferPool* BufferPool::instance() {
+    static BufferPool* pool = new BufferPool;
+    return pool;
+}
+
+int BufferPool::SizeClass(size_t size) {
+    if (size > ClassSize(kClassCount - 1)) {
+        return -1;
+    }
+
+    int c = 0;
+    while (ClassSize(c) < size) {
+        ++c;
+    }
+    return c;
+}
+
+BufferPool::ThreadCache* BufferPool::GetThreadCache() {
+    // cache is trivially destructible, so it is still valid after holder
+    // is destroyed at the thread exit, when it is marked dead.
+    static ThreadCache* const kDead = reinterpret_cast<ThreadCache*>(1);
+    static thread_local ThreadCache* cache = nullptr;
+    struct Holder {
+        ~Holder() {
+            ThreadCache* tc = cache;
+            cache = kDead;
+            delete tc;
+        }
+    };
+    static thread_local Holder holder;
+
+    if (cache == nullptr) {
+        (void)&holder; // Construct it, so the cache is freed at the thread exit
+        cache = new ThreadCache(this);
+    } else if (cache == kDead) {
+        // The thread is exiting, the blocks go to the depot directly
+        return nullptr;
+    }
+    return cache;
+}
+
+char* BufferPool::Allocate(size_t size) {
+    int c = SizeClass(size);
+    ThreadCache* tc = GetThreadCache();
+    if (c < 0) {
+        if (tc) {
+            ThreadCache::Add(tc->oversize, uint64_t(1));
+        }
+        return new char[size];
+    }
+
+    const size_t block_size = ClassSize(c);
+    if (tc == nullptr) {
+        FreeList l;
+        if (PopFromDepot(c, l, 1) == 1) {
+            return reinterpret_cast<char*>(l.head);
+        }
+        return new char[block_size];
+    }
+
+    ThreadCache::Add(tc->allocations, uint64_t(1));
+    FreeList& l = tc->lists[c];
+    if (l.head) {
+        ThreadCache::Add(tc->thread_cache_hits, uint64_t(1));
+    } else {
+        // Refill half of the free list at a time, so the depot is locked once per batch
+        size_t n = PopFromDepot(c, l, std::max(size_t(1), ThreadCacheLimit(c) / 2));
+        if (n == 0) {
+            return new char[block_size];
+        }
+        ThreadCache::Add(tc->depot_hits, uint64_t(1));
+        ThreadCache::Add(tc->bytes, n * block_size);
+    }
+
+    FreeBlock* b = l.head;
+    l.head = b->next;
+    --l.count;
+    ThreadCache::Add(tc->bytes, size_t(0) - block_size);
+    return reinterpret_cast<char*>(b);
+}
+
+void BufferPool::Deallocate(char* p, size_t size) {
+    int c = SizeClass(size);
+    if (c < 0) {
+        delete[] p;
+        return;
+    }
+
+    FreeBlock* b = reinterpret_cast<FreeBlock*>(p);
+    ThreadCache* tc = GetThreadCache();
+    if (tc == nullptr) {
+        FreeList l;
+        b->next = nullptr;
+        l.head = b;
+        l.count = 1;
+        PushToDepot(c, l, 1);
+        return;
+    }
+
+    const size_t block_size = ClassSize(c);
+    FreeList& l = tc->lists[c];
+    b->next = l.head;
+    l.head = b;
+    ++l.count;
+    ThreadCache::Add(tc->bytes, block_size);
+
+    if (l.count > ThreadCacheLimit(c)) {
+        size_t n = l.count / 2;
+        PushToDepot(c, l, n);
+        ThreadCache::Add(tc->bytes, size_t(0) - n * block_size);
+    }
+}
+
+void BufferPool::PushToDepot(int c, FreeList& from, size_t n) {
+    assert(n <= from.count);
+    const size_t limit = DepotLimit(c);
+    FreeBlock* excess = nullptr;
+    size_t pushed = 0;
+    {
+        std::lock_guard<std::mutex> guard(depot_mutex_[c]);
+        FreeList& depot = depot_[c];
+        for (size_t i = 0; i < n; i++) {
+            FreeBlock* b = from.head;
+            from.head = b->next;
+            if (depot.count < limit) {
+                b->next = depot.head;
+                depot.head = b;
+                ++depot.count;
+                ++pushed;
+            } else {
+                b->next = excess;
+                excess = b;
+            }
+        }
+    }
+    from.count -= n;
+    depot_bytes_.fetch_add(pushed * ClassSize(c), std::memory_order_relaxed);
+
+    // The depot is full, free the rest out of the lock
+    while (excess) {
+        FreeBlock* b = excess;
+        excess = b->next;
+        delete[] reinterpret_cast<char*>(b);
+    }
+}
+
+size_t BufferPool::PopFromDepot(int c, FreeList& to, size_t n) {
+    size_t popped = 0;
+    {
+        std::lock_guard<std::mutex> guard(depot_mutex_[c]);
+        FreeList& depot = depot_[c];
+        while (popped < n && depot.head) {
+            FreeBlock* b = depot.head;
+            depot.head = b->next;
+            --depot.count;
+            b->next = to.head;
+            to.head = b;
+            ++popped;
+        }
+    }
+    to.count += popped;
+    depot_bytes_.fetch_sub(popped * ClassSize(c), std::memory_order_relaxed);
+    return popped;
+}
+
+void BufferPool::Register(ThreadCache* tc) {
+    std::lock_guard<std::mutex> guard(threads_mutex_);
+    tc->next = threads_;
+    if (threads_) {
+        threads_->prev = tc;
+    }
+    threads_ = tc;
+}
+
+void BufferPool::Unregister(ThreadCache* tc) {
+    std::lock_guard<std::mutex> guard(threads_mutex_);
+    if (tc->prev) {
+        tc->prev->next = tc->next;
+    } else {
+        threads_ = tc->next;
+    }
+
+    if (tc->next) {
+        tc->next->prev = tc->prev;
+    }
+
+    exited_.allocations += tc->allocations.load(std::memory_order_relaxed);
+    exited_.thread_cache_hits += tc->thread_cache_hits.load(std::memory_order_relaxed);
+    exited_.depot_hits += tc->depot_hits.load(std::memory_order_relaxed);
+    exited_.oversize += tc->oversize.load(std::memory_order_relaxed);
+}
+
+BufferPoolStats BufferPool::Stats() const {
+    std::lock_guard<std::mutex> guard(threads_mutex_);
+    BufferPoolStats s = exited_;
+    for (ThreadCache* tc = threads_; tc; tc = tc->next) {
+        s.allocations += tc->allocations.load(std::memory_order_relaxed);
+        s.thread_cache_hits += tc->thread_cache_hits.load(std::memory_order_relaxed);
+        s.depot_hits += tc->depot_hits.load(std::memory_order_relaxed);
+        s.oversize += tc->oversize.load(std::memory_order_relaxed);
+        s.thread_cache_bytes += tc->bytes.load(std::memory_order_relaxed);
+    }
+    s.depot_bytes = depot_bytes_.load(std::memory_order_relaxed);
+    return s;
+}
+
+}
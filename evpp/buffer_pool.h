@@ -0,0 +1,122 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "evpp/inner_pre.h"
+#include "evpp/buffer.h"
+
+namespace evpp {
+
+struct EVPP_EXPORT BufferPoolStats {
+    BufferPoolStats();
+
+    // The ratio of the allocations served by the thread caches or the depot
+    double hit_rate() const {
+        return allocations == 0 ? 0.0 : double(thread_cache_hits + depot_hits) / double(allocations);
+    }
+
+    std::string ToString() const;
+
+    uint64_t allocations;       // The pooled allocations, the oversize ones are not counted
+    uint64_t thread_cache_hits; // Served by the free list of the calling thread
+    uint64_t depot_hits;        // Served by the blocks moved from the depot
+    uint64_t oversize;          // The allocations larger than the largest size class
+    size_t thread_cache_bytes;  // The bytes retained by the free lists of all the threads
+    size_t depot_bytes;         // The bytes retained by the depot
+};
+
+// A BufferAllocator which recycles the storage of Buffers, so the connection
+// churn and the growing of Buffers don't go to malloc in the steady state.
+//
+// The sizes are rounded up to the power of two size classes from 64B to 1MB,
+// the larger ones go to new[] and delete[] directly. Every thread has its own
+// free list of each class, which needs no lock. A free list which exceeds its
+// bound moves half of its blocks to the depot, a bounded global free list guarded
+// by a mutex, and an empty one takes a batch from the depot. A block freed
+// by another thread, e.g. the Buffer of a message passed between loops, just
+// goes to the free list of that thread. The depot frees the blocks beyond its bound.
+//
+// Usage : evpp::Buffer::SetDefaultAllocator(evpp::BufferPool::instance());
+class EVPP_EXPORT BufferPool : public BufferAllocator {
+public:
+    enum {
+        kMinShift = 6,  // The smallest class, 64B
+        kMaxShift = 20, // The largest class, 1MB
+        kClassCount = kMaxShift - kMinShift + 1,
+        kThreadCacheBytes = 256 * 1024,  // The bound of one free list of a thread
+        kDepotBytes = 4 * 1024 * 1024,   // The bound of one free list of the depot
+        kMinBlocks = 2,  // The bounds above are at least kMinBlocks blocks of the class
+    };
+
+    // @brief The only pool of the process. It is never destroyed,
+    //  so the Buffers freed at exit can still go back to it.
+    static BufferPool* instance();
+
+    char* Allocate(size_t size) override;
+    void Deallocate(char* p, size_t size) override;
+
+    // The size class of size, or size itself if it is oversize
+    size_t UsableSize(size_t size) const override {
+        int c = SizeClass(size);
+        return c < 0 ? size : ClassSize(c);
+    }
+
+    // @note It is thread safe.
+    BufferPoolStats Stats() const;
+
+    // @brief The size class of size, or -1 if it is oversize
+    static int SizeClass(size_t size);
+
+    static size_t ClassSize(int c) {
+        return size_t(1) << (c + kMinShift);
+    }
+
+    // The bounds of the count of the blocks of class c
+    static size_t ThreadCacheLimit(int c) {
+        return std::max(size_t(kMinBlocks), size_t(kThreadCacheBytes) / ClassSize(c));
+    }
+    static size_t DepotLimit(int c) {
+        return std::max(size_t(kMinBlocks), size_t(kDepotBytes) / ClassSize(c));
+    }
+
+private:
+    class ThreadCache;
+    friend class ThreadCache;
+
+    // A free block, the link is stored in the block itself
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct FreeList {
+        FreeList() : head(nullptr), count(0) {}
+        FreeBlock* head;
+        size_t count;
+    };
+
+    BufferPool();
+    ~BufferPool();
+
+    ThreadCache* GetThreadCache();
+
+    // Move the blocks between a free list of a thread and the depot
+    void PushToDepot(int c, FreeList& from, size_t n);
+    size_t PopFromDepot(int c, FreeList& to, size_t n);
+
+    void Register(ThreadCache* tc);
+    void Unregister(ThreadCache* tc);
+
+    mutable std::mutex depot_mutex_[kClassCount];
+    FreeList depot_[kClassCount];
+    std::atomic<size_t> depot_bytes_;
+
+    // The caches of the live threads and the counters of the exited ones
+    mutable std::mutex threads_mutex_;
+    ThreadCache* threads_;
+    BufferPoolStats exited_;
+};
+
+}
@@ -0,0 +1,248 @@
+#include "evpp/inner_pre.h"
+
+#include "evpp/compute_pool.h"
+#include "evpp/event_loop.h"
+
+namespace evpp {
+
+namespace {
+// The worker running on this thread
+struct CurrentWorker {
+    const ComputePool* pool;
+    uint32_t index;
+};
+
+thread_local CurrentWorker current = { nullptr, 0 };
+}
+
+ComputePool::ComputePool(uint32_t thread_num)
+    : thread_num_(thread_num), injector_size_(0), sleepers_(0), stopping_(false) {
+    assert(thread_num > 0);
+}
+
+ComputePool::~ComputePool() {
+    assert(status_.load() == kNull || IsStopped());
+    for (auto& w : workers_) {
+        if (w->thread.joinable()) {
+            w->thread.join();
+        }
+    }
+
+    // The tasks left, if any, are never run
+    for (auto& w : workers_) {
+        Task* task = nullptr;
+        while (w->deque.Pop(&task)) {
+            delete task;
+        }
+    }
+
+    for (auto task : injector_) {
+        delete task;
+    }
+    injector_.clear();
+}
+
+bool ComputePool::Start() {
+    assert(status_.load() == kNull);
+    status_.store(kStarting);
+
+    // All the deques exist before any worker steals
+    for (uint32_t i = 0; i < thread_num_; ++i) {
+        workers_.emplace_back(new Worker);
+    }
+
+    for (uint32_t i = 0; i < thread_num_; ++i) {
+        workers_[i]->thread = std::thread(&ComputePool::WorkerLoop, this, i);
+    }
+
+    status_.store(kRunning);
+    return true;
+}
+
+void ComputePool::Stop() {
+    assert(IsRunning());
+    assert(!IsInWorkerThread());
+    status_.store(kStopping);
+
+    {
+        std::lock_guard<std::mutex> g(mutex_);
+        stopping_ = true;
+    }
+    cond_.notify_all();
+
+    for (auto& w : workers_) {
+        w->thread.join();
+    }
+
+    status_.store(kStopped);
+    _log_trace(myLog, "compute pool stopped, executed=%llu stolen=%llu",
+               (unsigned long long)executed_count(), (unsigned long long)stolen_count());
+}
+
+bool ComputePool::Submit(const Task& task) {
+    bool worker = IsInWorkerThread();
+    if (!IsRunning() && !(worker && IsStopping())) {
+        _log_warn(myLog, "The compute pool is not running, the task is dropped");
+        return false;
+    }
+
+    // The pool may be stopped since it is checked
+    if (!Enqueue(new Task(task))) {
+        _log_warn(myLog, "The compute pool is stopping, the task is dropped");
+        return false;
+    }
+    return true;
+}
+
+bool ComputePool::Run(EventLoop* loop, const Task& work, const Task& done) {
+    auto f = [loop, work, done]() {
+        work();
+        loop->QueueInLoop(done);
+    };
+    return Submit(f);
+}
+
+void ComputePool::QueueInLoop(EventLoop* loop, const Task& task) {
+    loop->QueueInLoop(task);
+}
+
+uint64_t ComputePool::executed_count() const {
+    uint64_t n = 0;
+    for (auto& w : workers_) {
+        n += w->executed.load(std::memory_order_relaxed);
+    }
+    return n;
+}
+
+uint64_t ComputePool::stolen_count() const {
+    uint64_t n = 0;
+    for (auto& w : workers_) {
+        n += w->stolen.load(std::memory_order_relaxed);
+    }
+    return n;
+}
+
+bool ComputePool::IsInWorkerThread() const {
+    return current.pool == this;
+}
+
+bool ComputePool::Enqueue(Task* task) {
+    if (current.pool == this) {
+        workers_[current.index]->deque.Push(task);
+
+        // Pairs with the fence in WorkerLoop : either the worker going to sleep
+        // sees the task, or it is seen sleeping here
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> g(mutex_);
+            cond_.notify_one();
+        }
+        return true;
+    }
+
+    std::lock_guard<std::mutex> g(mutex_);
+    if (stopping_) {
+        // The workers may have exited, nobody would run it
+        delete task;
+        return false;
+    }
+
+    injector_.push_back(task);
+    injector_size_.fetch_add(1, std::memory_order_release);
+    if (sleepers_.load(std::memory_order_relaxed) > 0) {
+        cond_.notify_one();
+    }
+    return true;
+}
+
+void ComputePool::WorkerLoop(uint32_t index) {
+    current.pool = this;
+    current.index = index;
+    Worker* w = workers_[index].get();
+
+    for (;;) {
+        Task* task = Take(index);
+        if (task) {
+            (*task)();
+            delete task;
+            w->executed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleepers_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (HasWork()) {
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Nothing is left and no task is running on this worker, so nothing
+        // can be submitted to its deque. A task still running on another
+        // worker may submit more, which that worker runs itself.
+        if (stopping_) {
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+
+        cond_.wait(lock);
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    current.pool = nullptr;
+}
+
+ComputePool::Task* ComputePool::Take(uint32_t index) {
+    Task* task = nullptr;
+    if (workers_[index]->deque.Pop(&task)) {
+        return task;
+    }
+
+    task = TakeFromInjector();
+    if (task) {
+        return task;
+    }
+
+    // Steal from the others, starting from the next one, so the
+    // thieves don't all go for the first worker
+    for (uint32_t k = 1; k < thread_num_; ++k) {
+        Worker* victim = workers_[(index + k) % thread_num_].get();
+        if (victim->deque.Steal(&task)) {
+            workers_[index]->stolen.fetch_add(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+ComputePool::Task* ComputePool::TakeFromInjector() {
+    if (injector_size_.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> g(mutex_);
+    if (injector_.empty()) {
+        return nullptr;
+    }
+
+    Task* task = injector_.front();
+    injector_.pop_front();
+    injector_size_.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+}
+
+// It is called with mutex_ locked
+bool ComputePool::HasWork() const {
+    if (!injector_.empty()) {
+        return true;
+    }
+
+    for (auto& w : workers_) {
+        if (!w->deque.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
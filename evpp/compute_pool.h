@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "evpp/inner_pre.h"
+#include "evpp/evlog.h"
+#include "evpp/server_status.h"
+#include "evpp/work_stealing_deque.h"
+
+namespace evpp {
+
+class EventLoop;
+
+// A pool of threads running the CPU bound tasks, e.g. parsing or building
+// JSON, which would block all the connections of an EventLoop if they were
+// run on it. It sits beside the EventLoopThreadPool : the loops only do IO,
+// hand the work over by Run and get the result back by a task queued to them.
+//
+// Every worker has a WorkStealingDeque. The tasks submitted by a worker,
+// e.g. the ones a task splits its work into, are pushed to its own deque,
+// and the tasks submitted by the other threads go to a global injector
+// queue. An idle worker takes the tasks of its own deque first, then the
+// injector, then steals from the other workers, and sleeps if all of them
+// are empty.
+class EVPP_EXPORT ComputePool : public ServerStatus {
+public:
+    typedef std::function<void()> Task;
+
+    explicit ComputePool(uint32_t thread_num);
+    ~ComputePool();
+
+    void SetLogger(logger* log_) { myLog = log_; }
+    bool Start();
+
+    // @brief Stop accepting the tasks from the other threads, wait for all
+    //  the tasks queued to be done, including the ones they submit, and join
+    //  the workers. DO NOT call it from a worker.
+    void Stop();
+
+public:
+    // @brief Run task on one of the workers. It is thread safe.
+    // @return false if the pool is not running. A worker can still submit
+    //  when the pool is stopping.
+    bool Submit(const Task& task);
+
+    // @brief Run work on one of the workers, and then done on loop.
+    // @note loop MUST be running until done is run.
+    bool Run(EventLoop* loop, const Task& work, const Task& done);
+
+    // @brief Run work on one of the workers, and then done(result) on loop,
+    //  in which result is what work returns, e.g. the serialized JSON.
+    // @note loop MUST be running until done is run.
+    template<class Work, class Done>
+    bool Compute(EventLoop* loop, Work work, Done done);
+
+    uint32_t thread_num() const {
+        return thread_num_;
+    }
+
+    // The count of the tasks done
+    uint64_t executed_count() const;
+
+    // The count of the tasks stolen from the deque of another worker
+    uint64_t stolen_count() const;
+
+    // Whether the calling thread is one of the workers of this pool
+    bool IsInWorkerThread() const;
+
+private:
+    struct Worker {
+        Worker() : executed(0), stolen(0) {}
+
+        WorkStealingDeque<Task*> deque;
+        std::thread thread;
+        std::atomic<uint64_t> executed;
+        std::atomic<uint64_t> stolen;
+    };
+
+    // @return false if task is deleted, since the pool is stopping
+    bool Enqueue(Task* task);
+    void WorkerLoop(uint32_t index);
+    Task* Take(uint32_t index);
+    Task* TakeFromInjector();
+    bool HasWork() const;
+    static void QueueInLoop(EventLoop* loop, const Task& task);
+
+    uint32_t thread_num_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // The injector, and the sleeping of the idle workers
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<Task*> injector_;
+    std::atomic<size_t> injector_size_;
+    std::atomic<int> sleepers_;
+    bool stopping_;
+
+    logger* myLog{nullptr};
+};
+
+template<class Work, class Done>
+bool ComputePool::Compute(EventLoop* loop, Work work, Done done) {
+    // C++11 lambdas can't capture by moving, so the result is shared
+    auto f = [loop, work, done]() mutable {
+        typedef decltype(work()) Result;
+        std::shared_ptr<Result> result = std::make_shared<Result>(work());
+        QueueInLoop(loop, [done, result]() mutable {
+            done(std::move(*result));
+        });
+    };
+    return Submit(f);
+}
+
+}
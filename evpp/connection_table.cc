@@ -0,0 +1,110 @@
+#include "evpp/inner_pre.h"
+#include "evpp/connection_table.h"
+#include "evpp/tcp_conn.h"
+
+namespace evpp {
+
+ConnectionTable::ConnectionTable() : size_(0), shift_(64) {
+    Rehash(kMinCapacity);
+}
+
+bool ConnectionTable::Insert(const TCPConnPtr& conn) {
+    uint64_t id = conn->id();
+    assert(id != 0);
+
+    // The load factor is kept at most 1/2
+    if ((size_ + 1) * 2 > slots_.size()) {
+        Rehash(slots_.size() * 2);
+    }
+
+    size_t mask = slots_.size() - 1;
+    for (size_t i = Index(id);; i = (i + 1) & mask) {
+        Slot& s = slots_[i];
+        if (s.id == id) {
+            return false;
+        }
+
+        if (s.id == 0) {
+            s.id = id;
+            s.conn = conn;
+            ++size_;
+            return true;
+        }
+    }
+}
+
+bool ConnectionTable::Erase(uint64_t id) {
+    assert(id != 0);
+    size_t mask = slots_.size() - 1;
+    size_t i = Index(id);
+    while (slots_[i].id != id) {
+        if (slots_[i].id == 0) {
+            return false;
+        }
+        i = (i + 1) & mask;
+    }
+
+    // Shift the following slots of the probe sequence backward into the
+    // hole, unless it would move one of them before its own home slot
+    for (size_t j = (i + 1) & mask; slots_[j].id != 0; j = (j + 1) & mask) {
+        size_t home = Index(slots_[j].id);
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            slots_[i].id = slots_[j].id;
+            slots_[i].conn.swap(slots_[j].conn);
+            i = j;
+        }
+    }
+
+    slots_[i].id = 0;
+    slots_[i].conn.reset();
+    --size_;
+
+    // Give the memory back after a large number of connections are gone
+    if (slots_.size() > size_t(kMinCapacity) && size_ * 8 < slots_.size()) {
+        Rehash(slots_.size() / 2);
+    }
+    return true;
+}
+
+TCPConnPtr ConnectionTable::Find(uint64_t id) const {
+    size_t mask = slots_.size() - 1;
+    for (size_t i = Index(id); slots_[i].id != 0; i = (i + 1) & mask) {
+        if (slots_[i].id == id) {
+            return slots_[i].conn;
+        }
+    }
+    return TCPConnPtr();
+}
+
+void ConnectionTable::Clear() {
+    std::vector<Slot>().swap(slots_);
+    size_ = 0;
+    Rehash(kMinCapacity);
+}
+
+void ConnectionTable::Rehash(size_t capacity) {
+    assert((capacity & (capacity - 1)) == 0);
+    std::vector<Slot> old(capacity);
+    old.swap(slots_);
+
+    shift_ = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) {
+        --shift_;
+    }
+
+    size_t mask = capacity - 1;
+    for (auto& s : old) {
+        if (s.id == 0) {
+            continue;
+        }
+
+        size_t i = Index(s.id);
+        while (slots_[i].id != 0) {
+            i = (i + 1) & mask;
+        }
+        slots_[i].id = s.id;
+        slots_[i].conn.swap(s.conn);
+    }
+}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+#include "evpp/inner_pre.h"
+#include "evpp/tcp_callbacks.h"
+
+namespace evpp {
+
+// The connections of one EventLoop keyed by their ids, see TCPConn::id.
+//
+// It is a flat hash table by open addressing with linear probing, so a
+// connection takes one slot of a contiguous array instead of one node
+// allocation, and a lookup usually touches one cache line. The ids are
+// hashed by the Fibonacci hashing, since they are sequential and the ids
+// of the connections of one loop are usually strided by the count of the loops.
+// The erased slots are filled by shifting the following ones backward,
+// so there are no tombstones and the probes stay short.
+//
+// @note It is not thread safe. A TCPServer keeps one table per loop,
+//  which is only accessed in that loop.
+class EVPP_EXPORT ConnectionTable {
+public:
+    enum {
+        kMinCapacity = 16,
+    };
+
+    ConnectionTable();
+
+    // @brief Add conn by its id, which MUST NOT be 0
+    // @return false if there is a connection with the same id already
+    bool Insert(const TCPConnPtr& conn);
+
+    // @return false if there is no connection with the id
+    bool Erase(uint64_t id);
+
+    // @return The connection with the id, or an empty one
+    TCPConnPtr Find(uint64_t id) const;
+
+    void Clear();
+
+    // @brief Call f(const TCPConnPtr&) for every connection, in no particular order
+    // @note f MUST NOT insert or erase the connections. Copy them out first to do it.
+    template<typename F>
+    void ForEach(F f) const {
+        for (auto& s : slots_) {
+            if (s.id != 0) {
+                f(s.conn);
+            }
+        }
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    size_t capacity() const {
+        return slots_.size();
+    }
+
+private:
+    struct Slot {
+        uint64_t id; // 0 if the slot is empty
+        TCPConnPtr conn;
+    };
+
+    size_t Index(uint64_t id) const {
+        return static_cast<size_t>((id * 11400714819323198485ull) >> shift_);
+    }
+
+    void Rehash(size_t capacity);
+
+    std::vector<Slot> slots_;
+    size_t size_;
+    int shift_; // 64 - log2(capacity)
+};
+
+}
@@ -156,14 +156,18 @@ void Connector::HandleWrite() {
     assert(fd_ == chan_->fd());
     struct sockaddr_storage addr = sock::GetLocalAddr(chan_->fd());
     std::string laddr = sock::ToIPPort(&addr);
-    conn_fn_(chan_->fd(), laddr);
+    evpp_socket_t fd = fd_;
     timer_->Cancel();
     timer_.reset();
+
+    // Close the channel before the fd is attached by the TCPConn,
+    // the epoll backend allows only one registration of an fd
     chan_->DisableAllEvent();
     chan_->Close();
     own_fd_ = false; // Move the ownership of the fd to TCPConn
     fd_ = INVALID_SOCKET;
     status_ = kConnected;
+    conn_fn_(fd, laddr);
 }
 
 void Connector::HandleError() {
@@ -0,0 +1,192 @@
+#include "evpp/inner_pre.h"
+
+#include "evpp/epoll_poller.h"
+#include "evpp/libevent.h"
+#include "evpp/event_loop.h"
+#include "evpp/fd_channel.h"
+
+#ifdef H_OS_LINUX
+#include <sys/epoll.h>
+#endif
+
+namespace evpp {
+
+EpollPoller::EpollPoller(EventLoop* l)
+    : loop_(l), epfd_(-1), event_(nullptr), attached_(false), ready_(nullptr), ready_count_(0), ready_index_(0), size_(0) {
+}
+
+EpollPoller::~EpollPoller() {
+    Detach();
+    delete event_;
+    event_ = nullptr;
+
+#ifdef H_OS_LINUX
+    if (epfd_ >= 0) {
+        ::close(epfd_);
+        epfd_ = -1;
+    }
+
+    delete [] ready_;
+    ready_ = nullptr;
+#endif
+}
+
+#ifdef H_OS_LINUX
+bool EpollPoller::Init() {
+    assert(epfd_ < 0);
+    epfd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epfd_ < 0) {
+        int serrno = errno;
+        _log_warn(myLog, "epoll_create1 failed, err: %s", strerror(serrno).c_str());
+        return false;
+    }
+
+    event_ = new event;
+    memset(event_, 0, sizeof(struct event));
+    ::event_set(event_, epfd_, EV_READ | EV_PERSIST, &EpollPoller::HandleReady, this);
+    ::event_base_set(loop_->event_base(), event_);
+    ready_ = new struct epoll_event[kMaxEvents];
+    return true;
+}
+
+bool EpollPoller::Attach() {
+    assert(event_ && !attached_);
+    if (EventAdd(event_, nullptr) != 0) {
+        _log_err(myLog, "epoll fd=%d attach to event loop failed", epfd_);
+        return false;
+    }
+    attached_ = true;
+    return true;
+}
+
+void EpollPoller::Detach() {
+    if (attached_) {
+        EventDel(event_);
+        attached_ = false;
+    }
+}
+
+bool EpollPoller::Control(int op, FdChannel* c, uint32_t events) {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.ptr = c;
+    if (::epoll_ctl(epfd_, op, c->fd(), &ev) != 0) {
+        int serrno = errno;
+        _log_err(myLog, "epoll_ctl op=%d fd=%d events=0x%x failed, err: %s", op, c->fd(), events, strerror(serrno).c_str());
+        return false;
+    }
+    return true;
+}
+
+bool EpollPoller::Add(FdChannel* c, uint32_t events) {
+    assert(loop_->IsInLoopThread());
+    if (!Control(EPOLL_CTL_ADD, c, events)) {
+        return false;
+    }
+    ++size_;
+    return true;
+}
+
+bool EpollPoller::Modify(FdChannel* c, uint32_t events) {
+    assert(loop_->IsInLoopThread());
+    return Control(EPOLL_CTL_MOD, c, events);
+}
+
+void EpollPoller::Remove(FdChannel* c) {
+    assert(loop_->IsInLoopThread());
+    Control(EPOLL_CTL_DEL, c, 0);
+    assert(size_ > 0);
+    --size_;
+
+    // The channel may be deleted after this call, so the pending events
+    // of it in the current batch must not be dispatched
+    for (int i = ready_index_; i < ready_count_; i++) {
+        if (ready_[i].data.ptr == c) {
+            ready_[i].data.ptr = nullptr;
+        }
+    }
+}
+
+void EpollPoller::HandleReady(evpp_socket_t fd, short which, void* v) {
+    EpollPoller* p = (EpollPoller*)v;
+    assert(fd == p->epfd_);
+    p->Poll();
+}
+
+void EpollPoller::Poll() {
+    // The libevent loop has told us the epoll fd is readable, so don't block here.
+    // If there are more than kMaxEvents ready, the epoll fd stays readable
+    // and the rest are fetched in the next iteration of the loop.
+    int n = ::epoll_wait(epfd_, ready_, kMaxEvents, 0);
+    if (n < 0) {
+        int serrno = errno;
+        if (serrno != EINTR) {
+            _log_err(myLog, "epoll_wait failed, err: %s", strerror(serrno).c_str());
+        }
+        return;
+    }
+
+    ready_count_ = n;
+    for (ready_index_ = 0; ready_index_ < ready_count_;) {
+        const struct epoll_event& ev = ready_[ready_index_++];
+        FdChannel* c = static_cast<FdChannel*>(ev.data.ptr);
+        if (!c) {
+            continue;
+        }
+
+        // The same as the epoll backend of libevent
+        short which = 0;
+        if (ev.events & (EPOLLHUP | EPOLLERR)) {
+            which = FdChannel::kReadable | FdChannel::kWritable;
+        } else {
+            if (ev.events & EPOLLIN) {
+                which |= FdChannel::kReadable;
+            }
+
+            if (ev.events & EPOLLOUT) {
+                which |= FdChannel::kWritable;
+            }
+        }
+
+        c->HandlePollerEvent(which);
+    }
+
+    ready_count_ = 0;
+    ready_index_ = 0;
+}
+#else
+bool EpollPoller::Init() {
+    return false;
+}
+
+bool EpollPoller::Attach() {
+    return false;
+}
+
+void EpollPoller::Detach() {
+}
+
+bool EpollPoller::Add(FdChannel*, uint32_t) {
+    return false;
+}
+
+bool EpollPoller::Modify(FdChannel*, uint32_t) {
+    return false;
+}
+
+void EpollPoller::Remove(FdChannel*) {
+}
+
+void EpollPoller::HandleReady(evpp_socket_t, short, void*) {
+}
+
+void EpollPoller::Poll() {
+}
+
+bool EpollPoller::Control(int, FdChannel*, uint32_t) {
+    return false;
+}
+#endif
+
+}
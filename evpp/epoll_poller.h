@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "evpp/inner_pre.h"
+#include "evpp/evlog.h"
+
+struct event;
+struct epoll_event;
+
+namespace evpp {
+
+class EventLoop;
+class FdChannel;
+
+// A native epoll(7) poller of one EventLoop. See EventLoop::IOBackend.
+//
+// The FdChannels of the loop are registered into the epoll fd of this poller
+// instead of into libevent. Each fd is registered once when it is attached
+// the first time, the interest changes are done by EPOLL_CTL_MOD only when
+// the interest really changes, and it is removed only when the FdChannel is closed.
+// So enabling and disabling the write event of a busy TCPConn costs at most
+// one syscall instead of the event_del/event_add pair of libevent.
+//
+// The epoll fd itself is watched by a persistent libevent event, so the
+// timers and the watchers of the loop are still driven by libevent and
+// the readiness of all the channels is fetched by one epoll_wait.
+//
+// It is only available on Linux. Init returns false on the other platforms.
+//
+// @note All the methods MUST be called in the loop thread.
+class EVPP_EXPORT EpollPoller {
+public:
+    enum { kMaxEvents = 256, };
+
+    explicit EpollPoller(EventLoop* loop);
+    ~EpollPoller();
+
+    void SetLogger(logger* log_) { myLog = log_; }
+
+    // @brief Create the epoll fd
+    // @return false if epoll is not available
+    bool Init();
+
+    // @brief Watch the epoll fd in the event_base of the loop, or stop watching it.
+    //  EventLoop::Run calls them at its start and end, so the event is added
+    //  and deleted in the loop thread, like the NotifyWatcher of the loop.
+    bool Attach();
+    void Detach();
+
+    // @brief Register, modify or unregister a channel.
+    // @param events - The bitwise OR of the EPOLL* flags
+    bool Add(FdChannel* c, uint32_t events);
+    bool Modify(FdChannel* c, uint32_t events);
+    void Remove(FdChannel* c);
+
+    // @brief The count of the registered channels
+    size_t size() const {
+        return size_;
+    }
+
+private:
+    static void HandleReady(evpp_socket_t fd, short which, void* v);
+    void Poll();
+    bool Control(int op, FdChannel* c, uint32_t events);
+
+private:
+    EventLoop* loop_;
+    int epfd_;
+    struct event* event_;
+    bool attached_;
+
+    // The events returned by the last epoll_wait. The entries of the channels
+    // removed during the dispatching are cleared, see Remove.
+    struct epoll_event* ready_;
+    int ready_count_;
+    int ready_index_;
+
+    size_t size_;
+    logger* myLog{nullptr};
+};
+
+}
@@ -4,10 +4,12 @@
 #include "evpp/event_watcher.h"
 #include "evpp/event_loop.h"
 #include "evpp/invoke_timer.h"
+#include "evpp/epoll_poller.h"
+#include "evpp/io_uring_engine.h"
 
 namespace evpp {
 EventLoop::EventLoop()
-    : create_evbase_myself_(true), notified_(false), pending_functor_count_(0) {
+    : create_evbase_myself_(true), io_backend_(kLibevent), notified_(false), pending_functor_count_(0), before_wait_event_(nullptr), metrics_enabled_(false) {
 #if LIBEVENT_VERSION_NUMBER >= 0x02001500
     struct event_config* cfg = event_config_new();
     if (cfg) {
@@ -23,7 +25,7 @@ EventLoop::EventLoop()
 }
 
 EventLoop::EventLoop(struct event_base* base)
-    : evbase_(base), create_evbase_myself_(false), notified_(false), pending_functor_count_(0) {
+    : evbase_(base), create_evbase_myself_(false), io_backend_(kLibevent), notified_(false), pending_functor_count_(0), before_wait_event_(nullptr), metrics_enabled_(false) {
     Init();
 
     // When we build an EventLoop instance from an existing event_base
@@ -32,13 +34,25 @@ EventLoop::EventLoop(struct event_base* base)
     bool rc = watcher_->AsyncWait();
     assert(rc);
     if (!rc) {
-        _log_err(myLog, "PipeEventWatcher init failed.");
+        _log_err(myLog, "NotifyWatcher init failed.");
     }
+    AttachPoller();
     status_.store(kRunning);
 }
 
 EventLoop::~EventLoop() {
     watcher_.reset();
+    timing_wheel_.reset();
+    DetachPoller();
+    poller_.reset();
+    io_uring_.reset();
+
+    if (before_wait_event_) {
+        event_del(before_wait_event_);
+        delete before_wait_event_;
+        before_wait_event_ = nullptr;
+    }
+    before_wait_tasks_.clear();
 
     if (evbase_ != nullptr && create_evbase_myself_) {
         event_base_free(evbase_);
@@ -51,29 +65,109 @@ EventLoop::~EventLoop() {
 
 void EventLoop::Init() {
     status_.store(kInitializing);
-#ifdef H_HAVE_BOOST
-    const size_t kPendingFunctorCount = 1024 * 16;
-    this->pending_functors_ = new boost::lockfree::queue<Functor*>(kPendingFunctorCount);
-#elif defined(H_HAVE_CAMERON314_CONCURRENTQUEUE)
-    this->pending_functors_ = new moodycamel::ConcurrentQueue<Functor>();
-#else
-    this->pending_functors_ = new std::vector<Functor>();
-#endif
+    this->pending_functors_ = new MPSCQueue<PendingTask>();
+    metrics_.reset(new LoopMetrics);
 
     tid_ = std::this_thread::get_id(); // The default thread id
 
     InitNotifyPipeWatcher();
+    InitPoller();
+
+    before_wait_event_ = new event;
+    memset(before_wait_event_, 0, sizeof(struct event));
+    ::event_set(before_wait_event_, -1, 0, &EventLoop::HandleBeforeWait, this);
+    ::event_base_set(evbase_, before_wait_event_);
 
     status_.store(kInitialized);
 }
 
+namespace {
+std::atomic<int>& DefaultIOBackend() {
+    static std::atomic<int> backend([]() {
+        const char* s = ::getenv("EVPP_IO_BACKEND");
+        if (s && strcmp(s, "epoll") == 0) {
+            return int(EventLoop::kEpoll);
+        }
+
+        if (s && strcmp(s, "epoll_et") == 0) {
+            return int(EventLoop::kEpollET);
+        }
+
+        if (s && strcmp(s, "io_uring") == 0) {
+            return int(EventLoop::kIoUring);
+        }
+        return int(EventLoop::kLibevent);
+    }());
+    return backend;
+}
+}
+
+void EventLoop::SetDefaultIOBackend(IOBackend b) {
+    DefaultIOBackend().store(b);
+}
+
+EventLoop::IOBackend EventLoop::default_io_backend() {
+    return IOBackend(DefaultIOBackend().load());
+}
+
+void EventLoop::InitPoller() {
+    IOBackend b = default_io_backend();
+    if (b == kLibevent) {
+        return;
+    }
+
+    if (b == kIoUring) {
+        io_uring_.reset(new IoUringEngine(this));
+        io_uring_->SetLogger(myLog);
+        if (!io_uring_->Init()) {
+            _log_warn(myLog, "The io_uring backend is not available, fall back to libevent");
+            io_uring_.reset();
+            return;
+        }
+
+        io_backend_ = b;
+        return;
+    }
+
+    poller_.reset(new EpollPoller(this));
+    poller_->SetLogger(myLog);
+    if (!poller_->Init()) {
+        _log_warn(myLog, "The epoll backend is not available, fall back to libevent");
+        poller_.reset();
+        return;
+    }
+
+    io_backend_ = b;
+}
+
+// The events of the pollers are added and deleted in the loop thread, like watcher_
+void EventLoop::AttachPoller() {
+    if (poller_ && !poller_->Attach()) {
+        _log_err(myLog, "EpollPoller attach failed.");
+    }
+
+    if (io_uring_ && !io_uring_->Attach()) {
+        _log_err(myLog, "IoUringEngine attach failed.");
+    }
+}
+
+void EventLoop::DetachPoller() {
+    if (poller_) {
+        poller_->Detach();
+    }
+
+    if (io_uring_) {
+        io_uring_->Detach();
+    }
+}
+
 void EventLoop::InitNotifyPipeWatcher() {
     // Initialized task queue notify pipe watcher
-    watcher_.reset(new PipeEventWatcher(this, std::bind(&EventLoop::DoPendingFunctors, this)));
+    watcher_.reset(new NotifyWatcher(this, std::bind(&EventLoop::DoPendingFunctors, this)));
     int rc = watcher_->Init();
     assert(rc);
     if (!rc) {
-        _log_err(myLog, "PipeEventWatcher init failed.");
+        _log_err(myLog, "NotifyWatcher init failed.");
     }
 }
 
@@ -84,13 +178,19 @@ void EventLoop::Run() {
     int rc = watcher_->AsyncWait();
     assert(rc);
     if (!rc) {
-        _log_err(myLog, "PipeEventWatcher init failed.");
+        _log_err(myLog, "NotifyWatcher init failed.");
     }
+    AttachPoller();
 
     // After everything have initialized, we set the status to kRunning
     status_.store(kRunning);
 
-    rc = event_base_dispatch(evbase_);
+    if (busy_poll_max_ns_ > 0) {
+        rc = RunBusyPoll();
+    } else {
+        rc = event_base_dispatch(evbase_);
+    }
+
     if (rc == 1) {
         _log_err(myLog, "event_base_dispatch error: no event registered");
     } else if (rc == -1) {
@@ -100,11 +200,135 @@ void EventLoop::Run() {
 
     // Make sure watcher_ does construct, initialize and destruct in the same thread.
     watcher_.reset();
+    timing_wheel_.reset();
+    DetachPoller();
     _log_trace(myLog, "EventLoop stopped, tid=%ld", std::this_thread::get_id());
 
     status_.store(kStopped);
 }
 
+namespace {
+// The hint to the CPU in a spin, which saves power and
+// the memory order violations when the spin ends
+inline void CpuRelax() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+// The limit of the adaptive spin grows from it, see SetBusyPoll
+const int64_t kMinSpinNs = 10 * 1000;
+}
+
+void EventLoop::SetBusyPoll(Duration max_spin, bool adaptive) {
+    assert(status_.load() != kRunning);
+    busy_poll_max_ns_ = std::max(max_spin.Nanoseconds(), int64_t(0));
+    busy_poll_adaptive_ = adaptive;
+    spin_limit_ns_ = busy_poll_max_ns_;
+    busy_poll_stats_.spin_limit_ns.store(spin_limit_ns_, std::memory_order_relaxed);
+}
+
+BusyPollStats EventLoop::busy_poll_stats() const {
+    BusyPollStats s;
+    s.spin_ns = busy_poll_stats_.spin_ns.load(std::memory_order_relaxed);
+    s.idle_spin_ns = busy_poll_stats_.idle_spin_ns.load(std::memory_order_relaxed);
+    s.hits = busy_poll_stats_.hits.load(std::memory_order_relaxed);
+    s.blocks = busy_poll_stats_.blocks.load(std::memory_order_relaxed);
+    s.wakeup_samples = busy_poll_stats_.wakeup_samples.load(std::memory_order_relaxed);
+    s.wakeup_ns = busy_poll_stats_.wakeup_ns.load(std::memory_order_relaxed);
+    s.spin_limit_ns = busy_poll_stats_.spin_limit_ns.load(std::memory_order_relaxed);
+    return s;
+}
+
+// The loop alternates between spinning and blocking. A spin is a series of
+// the non-blocking iterations of the event_base, with the pending tasks polled
+// before each. It ends when it has found nothing for spin_limit_ns_.
+int EventLoop::RunBusyPoll() {
+    // Only the loop thread writes them
+    auto add = [](std::atomic<uint64_t>& c, uint64_t n) {
+        c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    };
+
+    for (;;) {
+        spinning_.store(true, std::memory_order_relaxed);
+        int64_t start = LoopMetrics::Now();
+        int64_t last_work = start;
+        uint64_t hits = 0;
+        bool idle = false;
+        for (;;) {
+            uint64_t activity = activity_;
+            if (!pending_functors_->Empty()) {
+                DoPendingFunctors();
+            }
+
+            int rc = event_base_loop(evbase_, EVLOOP_NONBLOCK);
+            if (rc < 0 || event_base_got_exit(evbase_) || event_base_got_break(evbase_)) {
+                spinning_.store(false, std::memory_order_relaxed);
+                add(busy_poll_stats_.spin_ns, uint64_t(LoopMetrics::Now() - start));
+                add(busy_poll_stats_.hits, hits);
+                return rc < 0 ? rc : 0;
+            }
+
+            int64_t now = LoopMetrics::Now();
+            if (activity != activity_) {
+                // The loop would have blocked before it, if it were not spinning
+                hits += idle ? 1 : 0;
+                idle = false;
+                last_work = now;
+            } else {
+                idle = true;
+                if (now - last_work >= spin_limit_ns_) {
+                    break;
+                }
+                CpuRelax();
+            }
+        }
+
+        // Pairs with the fence in Notify : either the producer sees the loop
+        // is not spinning and notifies it, or its task is seen here
+        spinning_.store(false, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        int64_t spin_end = LoopMetrics::Now();
+        add(busy_poll_stats_.spin_ns, uint64_t(spin_end - start));
+        add(busy_poll_stats_.idle_spin_ns, uint64_t(spin_end - last_work));
+        add(busy_poll_stats_.hits, hits);
+        if (!pending_functors_->Empty()) {
+            continue;
+        }
+
+        add(busy_poll_stats_.blocks, 1);
+        blocking_ = true;
+        int rc = event_base_loop(evbase_, EVLOOP_ONCE);
+        blocking_ = false;
+        if (rc < 0 || event_base_got_exit(evbase_) || event_base_got_break(evbase_)) {
+            return rc < 0 ? rc : 0;
+        }
+
+        if (busy_poll_adaptive_) {
+            AdaptSpinLimit(LoopMetrics::Now() - spin_end);
+        }
+    }
+}
+
+void EventLoop::AdaptSpinLimit(int64_t blocked_ns) {
+    if (blocked_ns <= busy_poll_max_ns_) {
+        // A longer spin would have found the work
+        if (spin_limit_ns_ < blocked_ns) {
+            spin_limit_ns_ = std::min(std::max(spin_limit_ns_ * 2, kMinSpinNs), busy_poll_max_ns_);
+        }
+    } else {
+        // Even the longest spin would have been wasted
+        spin_limit_ns_ /= 2;
+        if (spin_limit_ns_ < kMinSpinNs) {
+            spin_limit_ns_ = 0;
+        }
+    }
+    busy_poll_stats_.spin_limit_ns.store(spin_limit_ns_, std::memory_order_relaxed);
+}
+
 void EventLoop::Stop() {
     assert(status_.load() == kRunning);
     status_.store(kStopping);
@@ -154,7 +378,7 @@ void EventLoop::AfterFork() {
     //
     // But if we have multi child processes, something goes wrong.
     // Because EventLoop::watcher_ is created and initialized in father process
-    // all children processes inherited father's pipe.
+    // all children processes inherited father's eventfd (or pipe).
     //
     // When we use the pipe to do a notification in one child process
     // the notification may be received by another child process randomly.
@@ -200,6 +424,43 @@ evpp::InvokeTimerPtr EventLoop::RunEvery(Duration interval, Functor&& f) {
     return t;
 }
 
+InvokeTimerPtr EventLoop::RunAfter(double delay_ms, Task&& f) {
+    return RunAfter(Duration(delay_ms / 1000.0), std::move(f));
+}
+
+InvokeTimerPtr EventLoop::RunAfter(Duration delay, Task&& f) {
+    std::shared_ptr<InvokeTimer> t = InvokeTimer::Create(this, delay, std::move(f), false);
+    t->Start();
+    return t;
+}
+
+evpp::InvokeTimerPtr EventLoop::RunEvery(Duration interval, Task&& f) {
+    std::shared_ptr<InvokeTimer> t = InvokeTimer::Create(this, interval, std::move(f), true);
+    t->Start();
+    return t;
+}
+
+InvokeTimerPtr EventLoop::RunAfter(Duration delay, Task&& f, InvokeTimer::Mode mode) {
+    std::shared_ptr<InvokeTimer> t = InvokeTimer::Create(this, delay, std::move(f), false, mode);
+    t->Start();
+    return t;
+}
+
+InvokeTimerPtr EventLoop::RunEvery(Duration interval, Task&& f, InvokeTimer::Mode mode) {
+    std::shared_ptr<InvokeTimer> t = InvokeTimer::Create(this, interval, std::move(f), true, mode);
+    t->Start();
+    return t;
+}
+
+TimingWheel* EventLoop::timing_wheel() {
+    assert(IsInLoopThread());
+    if (!timing_wheel_) {
+        timing_wheel_.reset(new TimingWheel(this, Duration(kTimingWheelTickMs * Duration::kMillisecond)));
+        timing_wheel_->SetLogger(myLog);
+    }
+    return timing_wheel_.get();
+}
+
 void EventLoop::RunInLoop(const Functor& functor) {
     // DLOG_TRACE;
     if (IsRunning() && IsInLoopThread()) {
@@ -218,141 +479,229 @@ void EventLoop::RunInLoop(Functor&& functor) {
     }
 }
 
+void EventLoop::RunInLoop(Task&& task) {
+    if (IsRunning() && IsInLoopThread()) {
+        task();
+    } else {
+        QueueInLoop(std::move(task));
+    }
+}
+
 void EventLoop::QueueInLoop(const Functor& cb) {
     _log_trace(myLog, "pending_functor_count_=%d PendingQueueSize=%d notified_=%d",
                pending_functor_count_.load(), GetPendingQueueSize(), notified_.load());
-    {
-#ifdef H_HAVE_BOOST
-        auto f = new Functor(cb);
-        while (!pending_functors_->push(f)) {
-        }
-#elif defined(H_HAVE_CAMERON314_CONCURRENTQUEUE)
-        while (!pending_functors_->enqueue(cb)) {
-        }
-#else
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_functors_->emplace_back(cb);
-#endif
-    }
+    PushPendingTask(Task(cb));
     ++pending_functor_count_;
     _log_trace(myLog, "queued a new Functor, pending_functor_count_=%d PendingQueueSize=%d notified_=%d",
                pending_functor_count_.load(), GetPendingQueueSize(), notified_.load());
-    if (!notified_.load()) {
-        _log_trace(myLog, "call watcher_->Nofity() notified_.store(true)");
-
-        // We must set notified_ to true before calling `watcher_->Nodify()`
-        // otherwise there is a change that:
-        //  1. We called watcher_- > Nodify() on thread1
-        //  2. On thread2 we watched this event, so wakeup the CPU changed to run this EventLoop on thread2 and executed all the pending task
-        //  3. Then the CPU changed to run on thread1 and set notified_ to true
-        //  4. Then, some thread except thread2 call this QueueInLoop to push a task into the queue, and find notified_ is true, so there is no change to wakeup thread2 to execute this task
-        notified_.store(true);
-
-        // Sometimes one thread invoke EventLoop::QueueInLoop(...), but anther
-        // thread is invoking EventLoop::Stop() to stop this loop. At this moment
-        // this loop maybe is stopping and the watcher_ object maybe has been
-        // released already.
-        if (watcher_) {
-            watcher_->Notify();
-        } else {
-            _log_trace(myLog, "status=%s", StatusToString().c_str());
-            assert(!IsRunning());
-        }
-    } else {
-         _log_trace(myLog, "No need to call watcher_->Nofity()");
-    }
+    Notify();
 }
 
 void EventLoop::QueueInLoop(Functor&& cb) {
     _log_trace(myLog, "pending_functor_count_=%d PendingQueueSize=%d notified_=%d",
                pending_functor_count_.load(), GetPendingQueueSize(), notified_.load());
-    {
-#ifdef H_HAVE_BOOST
-        auto f = new Functor(std::move(cb)); // TODO Add test code for it
-        while (!pending_functors_->push(f)) {
-        }
-#elif defined(H_HAVE_CAMERON314_CONCURRENTQUEUE)
-        while (!pending_functors_->enqueue(std::move(cb))) {
-        }
-#else
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_functors_->emplace_back(std::move(cb));
-#endif
-    }
+    PushPendingTask(Task(std::move(cb)));
     ++pending_functor_count_;
     _log_trace(myLog, "queued a new Functor, pending_functor_count_=%d PendingQueueSize=%d notified_=%d",
                pending_functor_count_.load(), GetPendingQueueSize(), notified_.load());
-    if (!notified_.load()) {
-        _log_trace(myLog, "call watcher_->Nofity() notified_.store(true)");
-        notified_.store(true);
-        if (watcher_) {
-            watcher_->Notify();
-        } else {
-            _log_trace(myLog, "watcher_ is empty, maybe we call EventLoop::QueueInLoop on a stopped EventLoop. status=%s",
-                       StatusToString().c_str());
-            assert(!IsRunning());
+    Notify();
+}
+
+void EventLoop::QueueInLoop(Task&& task) {
+    assert(task);
+    PushPendingTask(std::move(task));
+    ++pending_functor_count_;
+    _log_trace(myLog, "queued a new Task, pending_functor_count_=%d PendingQueueSize=%d notified_=%d",
+               pending_functor_count_.load(), GetPendingQueueSize(), notified_.load());
+    Notify();
+}
+
+void EventLoop::QueueInLoopBatch(std::vector<Task>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    struct Assign {
+        int64_t queued_ns;
+        void operator()(PendingTask& dst, Task& src) const {
+            dst.task = std::move(src);
+            dst.queued_ns = queued_ns;
         }
-    } else {
+    };
+
+    Assign assign = { metrics_enabled_.load(std::memory_order_relaxed) ? LoopMetrics::Now() : 0 };
+    size_t n = pending_functors_->PushBatch(tasks.begin(), tasks.end(), assign);
+    tasks.clear();
+    pending_functor_count_.fetch_add(static_cast<int>(n));
+    _log_trace(myLog, "queued %d Tasks, pending_functor_count_=%d PendingQueueSize=%d notified_=%d",
+               static_cast<int>(n), pending_functor_count_.load(), GetPendingQueueSize(), notified_.load());
+    Notify();
+}
+
+void EventLoop::RunBeforeWait(Task&& task) {
+    assert(IsInLoopThread());
+    assert(task);
+    before_wait_tasks_.push_back(std::move(task));
+    if (before_wait_tasks_.size() == 1) {
+        // libevent runs the events activated by the callbacks
+        // in the same iteration, after the ones already active
+        event_active(before_wait_event_, 0, 0);
+    }
+}
+
+void EventLoop::HandleBeforeWait(evpp_socket_t fd, short which, void* v) {
+    EventLoop* loop = (EventLoop*)v;
+
+    // The tasks added by the tasks are run in another round of the same iteration
+    std::vector<Task> tasks;
+    tasks.swap(loop->before_wait_tasks_);
+    for (auto& t : tasks) {
+        t();
+    }
+
+    // Reuse the capacity
+    if (loop->before_wait_tasks_.empty()) {
+        tasks.clear();
+        loop->before_wait_tasks_.swap(tasks);
+    }
+}
+
+void EventLoop::PushPendingTask(Task&& task) {
+    PendingTask p;
+    p.task = std::move(task);
+    if (metrics_enabled_.load(std::memory_order_relaxed)) {
+        p.queued_ns = LoopMetrics::Now();
+    }
+    pending_functors_->Push(std::move(p));
+}
+
+void EventLoop::Notify() {
+    // We must set notified_ to true before calling `watcher_->Nodify()`
+    // otherwise there is a change that:
+    //  1. We called watcher_- > Nodify() on thread1
+    //  2. On thread2 we watched this event, so wakeup the CPU changed to run this EventLoop on thread2 and executed all the pending task
+    //  3. Then the CPU changed to run on thread1 and set notified_ to true
+    //  4. Then, some thread except thread2 call this QueueInLoop to push a task into the queue, and find notified_ is true, so there is no change to wakeup thread2 to execute this task
+    //
+    // We use an atomic exchange here and in DoPendingFunctors, so that
+    // a task pushed before DoPendingFunctors resets notified_ is always
+    // visible to DoPendingFunctors, otherwise its producer sees false and notifies again.
+    if (busy_poll_max_ns_ > 0) {
+        // The spinning loop polls the queue itself
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (spinning_.load(std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    if (notified_.exchange(true)) {
         _log_trace(myLog, "No need to call watcher_->Nofity()");
+        return;
+    }
+
+    if (busy_poll_max_ns_ > 0) {
+        // The latency of the wakeup, which the spinning saves, see BusyPollStats
+        int64_t expected = 0;
+        notify_ns_.compare_exchange_strong(expected, LoopMetrics::Now(), std::memory_order_relaxed);
+    }
+
+    _log_trace(myLog, "call watcher_->Nofity() notified_.store(true)");
+
+    // Sometimes one thread invoke EventLoop::QueueInLoop(...), but anther
+    // thread is invoking EventLoop::Stop() to stop this loop. At this moment
+    // this loop maybe is stopping and the watcher_ object maybe has been
+    // released already.
+    if (watcher_) {
+        watcher_->Notify();
+    } else {
+        _log_trace(myLog, "watcher_ is empty, maybe we call EventLoop::QueueInLoop on a stopped EventLoop. status=%s",
+                   StatusToString().c_str());
+        assert(!IsRunning());
     }
 }
 
 void EventLoop::DoPendingFunctors() {
     _log_trace(myLog, "pending_functor_count_=%d PendingQueueSize=%d notified_=%d",
                pending_functor_count_.load(), GetPendingQueueSize(), notified_.load());
-#ifdef H_HAVE_BOOST
-    notified_.store(false);
-    Functor* f = nullptr;
-    while (pending_functors_->pop(f)) {
-        (*f)();
-        delete f;
-        --pending_functor_count_;
-    }
-#elif defined(H_HAVE_CAMERON314_CONCURRENTQUEUE)
-    notified_.store(false);
-    Functor f;
-    while (pending_functors_->try_dequeue(f)) {
-        f();
-        --pending_functor_count_;
-    }
-#else
-    std::vector<Functor> functors;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        notified_.store(false);
-        pending_functors_->swap(functors);
-        _log_trace(myLog, "pending_functor_count_=%d PendingQueueSize=%d notified_=%d",
-               pending_functor_count_.load(), GetPendingQueueSize(), notified_.load());
+    notified_.exchange(false);
+
+    if (busy_poll_max_ns_ > 0) {
+        int64_t notified = notify_ns_.exchange(0, std::memory_order_relaxed);
+        if (notified != 0 && blocking_) {
+            busy_poll_stats_.wakeup_samples.fetch_add(1, std::memory_order_relaxed);
+            busy_poll_stats_.wakeup_ns.fetch_add(uint64_t(LoopMetrics::Now() - notified), std::memory_order_relaxed);
+        }
     }
-    _log_trace(myLog, "pending_functor_count_=%d PendingQueueSize=%d notified_=%d",
-               pending_functor_count_.load(), GetPendingQueueSize(), notified_.load());
-    for (size_t i = 0; i < functors.size(); ++i) {
-        functors[i]();
-        --pending_functor_count_;
+
+    // Drain all the functors queued before this point in one pass.
+    // The functors queued by the functors themselves will be executed in the next round.
+    LoopMetrics* m = metrics();
+    if (m == nullptr) {
+        size_t n = pending_functors_->Drain([this](PendingTask& p) {
+            p.task();
+            --pending_functor_count_;
+        });
+        activity_ += n;
+    } else {
+        int64_t start = LoopMetrics::Now();
+        m->pending_depth.Record(static_cast<uint64_t>(pending_functor_count_.load()));
+        size_t n = pending_functors_->Drain([this, m](PendingTask& p) {
+            if (p.queued_ns != 0) {
+                LoopMetrics::RecordElapsed(m->queue_latency, p.queued_ns);
+            }
+            p.task();
+            --pending_functor_count_;
+        });
+
+        if (n > 0) {
+            LoopMetrics::RecordElapsed(m->pending_batch, start);
+        }
+        activity_ += n;
     }
     _log_trace(myLog, "pending_functor_count_=%d PendingQueueSize=%d notified_=%d",
                pending_functor_count_.load(), GetPendingQueueSize(), notified_.load());
-#endif
 }
 
 size_t EventLoop::GetPendingQueueSize() {
-#ifdef H_HAVE_BOOST
     return static_cast<size_t>(pending_functor_count_.load());
-#elif defined(H_HAVE_CAMERON314_CONCURRENTQUEUE)
-    return pending_functors_->size_approx();
-#else
-    return pending_functors_->size();
-#endif
 }
 
 bool EventLoop::IsPendingQueueEmpty() {
-#ifdef H_HAVE_BOOST
-    return pending_functors_->empty();
-#elif defined(H_HAVE_CAMERON314_CONCURRENTQUEUE)
-    return pending_functors_->size_approx() == 0;
-#else
-    return pending_functors_->empty();
-#endif
+    return pending_functors_->Empty();
+}
+
+TaskBatch::~TaskBatch() {
+    Flush();
+}
+
+void TaskBatch::Add(EventLoop* loop, Task&& task) {
+    assert(loop);
+    for (auto& b : batches_) {
+        if (b.first == loop) {
+            b.second.push_back(std::move(task));
+            return;
+        }
+    }
+
+    batches_.push_back(std::make_pair(loop, std::vector<Task>()));
+    batches_.back().second.push_back(std::move(task));
+}
+
+void TaskBatch::Flush() {
+    // The per-loop vectors are kept to reuse their capacity in the next round
+    for (auto& b : batches_) {
+        if (!b.second.empty()) {
+            b.first->QueueInLoopBatch(b.second);
+        }
+    }
+}
+
+size_t TaskBatch::size() const {
+    size_t n = 0;
+    for (auto& b : batches_) {
+        n += b.second.size();
+    }
+    return n;
 }
 
 }
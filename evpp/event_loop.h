@@ -10,26 +10,19 @@
 #include "evpp/duration.h"
 #include "evpp/any.h"
 #include "evpp/invoke_timer.h"
+#include "evpp/timing_wheel.h"
+#include "evpp/loop_metrics.h"
 #include "evpp/server_status.h"
 #include "evpp/evlog.h"
+#include "evpp/mpsc_queue.h"
+#include "evpp/task.h"
 
-#ifdef H_HAVE_BOOST
-#include <boost/lockfree/queue.hpp>
-#elif defined(H_HAVE_CAMERON314_CONCURRENTQUEUE)
-
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wshadow"
-#include <concurrentqueue/concurrentqueue.h>
-#pragma GCC diagnostic pop
-#else
-#include <concurrentqueue/concurrentqueue.h>
-#endif // __GNUC__
-
-#endif
 
 namespace evpp {
 
+class EpollPoller;
+class IoUringEngine;
+
 // This is the IO Event driving kernel. Reactor model.
 // This class is a wrapper of event_base but not only a wrapper.
 // It provides a simple way to run a IO Event driving loop.
@@ -37,6 +30,14 @@ namespace evpp {
 class EVPP_EXPORT EventLoop : public ServerStatus {
 public:
     typedef std::function<void()> Functor;
+
+    // The backend which watches the fds of the FdChannels
+    enum IOBackend {
+        kLibevent = 0, // The event_base, the default
+        kEpoll = 1,    // The native EpollPoller, level triggered. Linux only.
+        kEpollET = 2,  // The same as kEpoll, but the TCPConns are edge triggered
+        kIoUring = 3,  // The TCPConns and the Listener do their I/O by the IoUringEngine. Linux only.
+    };
 public:
     EventLoop();
 
@@ -78,11 +79,91 @@ public:
     void RunInLoop(Functor&& handler);
     void QueueInLoop(Functor&& handler);
 
+public:
+    // The move-only Task overloads. A Task stores a callable of
+    // EVPP_TASK_INLINE_SIZE bytes inline, so posting a lambda that
+    // captures e.g. a TCPConnPtr and a std::string does not allocate.
+    InvokeTimerPtr RunAfter(double delay_ms, Task&& f);
+    InvokeTimerPtr RunAfter(Duration delay, Task&& f);
+    InvokeTimerPtr RunEvery(Duration interval, Task&& f);
+
+    // @brief The timers with a Mode. InvokeTimer::kWheelTimer uses the
+    //  TimingWheel of this loop : O(1) start and cancel without a libevent event,
+    //  which suits a large number of timeouts, e.g. one per request.
+    //  Its precision is the tick of the wheel, see kTimingWheelTickMs.
+    InvokeTimerPtr RunAfter(Duration delay, Task&& f, InvokeTimer::Mode mode);
+    InvokeTimerPtr RunEvery(Duration interval, Task&& f, InvokeTimer::Mode mode);
+
+    void RunInLoop(Task&& handler);
+    void QueueInLoop(Task&& handler);
+
+    // @brief Queue a batch of tasks into the loop.
+    //  The whole batch is published with one atomic operation and
+    //  wakes up the loop thread at most once. The tasks are executed in order.
+    // @param tasks - It is cleared after the call, its capacity can be reused
+    // @note It is thread safe.
+    void QueueInLoopBatch(std::vector<Task>& tasks);
+
+    // @brief Run task after all the events which are active in the current
+    //  iteration of the loop are handled, right before the loop waits for
+    //  the next events. It is used to batch the work of many callbacks,
+    //  e.g. to flush the output of a TCPConn once per iteration.
+    //  Unlike QueueInLoop, it doesn't wake up the loop.
+    // @note It MUST be called in the loop thread.
+    void RunBeforeWait(Task&& task);
+
+    // @brief Spin up to max_spin before blocking for the events. While spinning, the
+    //  loop polls its queue of the pending tasks and checks the fds and the timers
+    //  without blocking, so a task queued or an event arriving is handled without
+    //  the latency of a wakeup, and the producers skip the write to the notify fd.
+    //  The spin restarts whenever it finds work.
+    // @param max_spin - The limit of the spin. 0 turns it off, which is the default.
+    // @param adaptive - Adapt the limit between 0 and max_spin, like the halt polling
+    //  of KVM : it grows when the loop was woken up soon after it blocked, i.e. a
+    //  longer spin would have found the work, and shrinks when the loop was blocked
+    //  for longer than max_spin, i.e. the spin was wasted.
+    // @note It MUST be called before Run. The loop uses a whole CPU while spinning.
+    //  The work found is what evpp handles : the tasks, the FdChannels, the
+    //  completions of io_uring and the InvokeTimers.
+    void SetBusyPoll(Duration max_spin, bool adaptive = true);
+
+    // @note It is thread safe.
+    BusyPollStats busy_poll_stats() const;
+
+    // @brief Count the work done by the loop, which ends the idle time of a busy poll.
+    //  It is called by the handlers of the events.
+    void NoteActivity() {
+        ++activity_;
+    }
+
+    // @brief Select the IOBackend of the EventLoops constructed after this call.
+    //  The initial default is read from the environment variable EVPP_IO_BACKEND,
+    //  which is one of "libevent", "epoll", "epoll_et" and "io_uring".
+    //  A loop falls back to kLibevent if the backend is not available.
+    // @note It is thread safe.
+    static void SetDefaultIOBackend(IOBackend b);
+    static IOBackend default_io_backend();
+
     // Getter and Setter
 public:
     struct event_base* event_base() {
         return evbase_;
     }
+
+    // @brief The actual IOBackend of this loop
+    IOBackend io_backend() const {
+        return io_backend_;
+    }
+
+    // @return The EpollPoller of this loop, or nullptr if its IOBackend is kLibevent
+    EpollPoller* poller() {
+        return poller_.get();
+    }
+
+    // @return The IoUringEngine of this loop, or nullptr if its IOBackend is not kIoUring
+    IoUringEngine* io_uring() {
+        return io_uring_.get();
+    }
     bool IsInLoopThread() const {
         return tid_ == std::this_thread::get_id();
     }
@@ -100,6 +181,27 @@ public:
         assert(index < kContextCount && index >= 0);
         return context_[index];
     }
+    // @brief Turn on or off the runtime metrics of this loop. They are off by default.
+    //  When it is off, the only cost on the hot paths is a relaxed load of a flag.
+    // @note It is thread safe.
+    void EnableMetrics(bool on) {
+        metrics_enabled_.store(on, std::memory_order_relaxed);
+    }
+
+    // @return The metrics to record into, or nullptr if the metrics are off.
+    // @note The recording MUST be done in the loop thread
+    LoopMetrics* metrics() {
+        return metrics_enabled_.load(std::memory_order_relaxed) ? metrics_.get() : nullptr;
+    }
+
+    // @note It is thread safe.
+    LoopMetricsSnapshot metrics_snapshot() const {
+        return metrics_->Snapshot();
+    }
+
+    // @brief The timing wheel of this loop. It is created at the first call.
+    // @note It MUST be called in the loop thread
+    TimingWheel* timing_wheel();
     int pending_functor_count() const {
         return pending_functor_count_.load();
     }
@@ -109,33 +211,99 @@ public:
 private:
     void Init();
     void InitNotifyPipeWatcher();
+    void InitPoller();
+    void AttachPoller();
+    void DetachPoller();
     void StopInLoop();
+    int RunBusyPoll();
+    void AdaptSpinLimit(int64_t blocked_ns);
     void DoPendingFunctors();
+    static void HandleBeforeWait(evpp_socket_t fd, short which, void* v);
+    void Notify();
     size_t GetPendingQueueSize();
     bool IsPendingQueueEmpty();
 private:
     struct event_base* evbase_;
     bool create_evbase_myself_;
+
+    IOBackend io_backend_;
+    std::unique_ptr<EpollPoller> poller_;
+    std::unique_ptr<IoUringEngine> io_uring_;
     std::thread::id tid_;
     enum { kContextCount = 16, };
     Any context_[kContextCount];
 
-    std::mutex mutex_;
     // We use this to notify the thread when we put a task into the pending_functors_ queue
-    std::shared_ptr<PipeEventWatcher> watcher_;
+    std::shared_ptr<NotifyWatcher> watcher_;
     // When we put a task into the pending_functors_ queue,
     // we need to notify the thread to execute it. But we don't want to notify repeatedly.
     std::atomic<bool> notified_;
-#ifdef H_HAVE_BOOST
-    boost::lockfree::queue<Functor*>* pending_functors_;
-#elif defined(H_HAVE_CAMERON314_CONCURRENTQUEUE)
-    moodycamel::ConcurrentQueue<Functor>* pending_functors_;
-#else
-    std::vector<Functor>* pending_functors_; // @Guarded By mutex_
-#endif
+    // The queued time is only recorded when the metrics are on
+    struct PendingTask {
+        PendingTask() : queued_ns(0) {}
+        Task task;
+        int64_t queued_ns;
+    };
+    void PushPendingTask(Task&& task);
+    MPSCQueue<PendingTask>* pending_functors_; // Multi-producer, only consumed in the loop thread
 
     std::atomic<int> pending_functor_count_;
 
+    // The tasks of RunBeforeWait. before_wait_event_ is activated when the
+    // first one is added, so it runs after the other active events.
+    std::vector<Task> before_wait_tasks_;
+    struct event* before_wait_event_;
+
+    enum { kTimingWheelTickMs = 1, };
+    std::unique_ptr<TimingWheel> timing_wheel_;
+
+    std::atomic<bool> metrics_enabled_;
+    std::unique_ptr<LoopMetrics> metrics_;
+
+    // The busy polling, see SetBusyPoll. The statistics are only
+    // written by the loop thread, and read by any thread.
+    int64_t busy_poll_max_ns_ = 0;
+    bool busy_poll_adaptive_ = true;
+    int64_t spin_limit_ns_ = 0;
+    uint64_t activity_ = 0;
+    bool blocking_ = false;
+    std::atomic<bool> spinning_ = { false }; // The producers don't notify when it is true
+    std::atomic<int64_t> notify_ns_ = { 0 }; // When a producer woke up the loop blocked
+    struct BusyPollCounters {
+        std::atomic<uint64_t> spin_ns = { 0 };
+        std::atomic<uint64_t> idle_spin_ns = { 0 };
+        std::atomic<uint64_t> hits = { 0 };
+        std::atomic<uint64_t> blocks = { 0 };
+        std::atomic<uint64_t> wakeup_samples = { 0 };
+        std::atomic<uint64_t> wakeup_ns = { 0 };
+        std::atomic<int64_t> spin_limit_ns = { 0 };
+    };
+    BusyPollCounters busy_poll_stats_;
+
     logger* myLog{nullptr};
 };
+
+// A staging buffer of tasks posted to one or more EventLoops.
+// A producer which posts many tasks in a burst can Add them here and Flush
+// at the end of its iteration, so each target loop gets one QueueInLoopBatch
+// instead of one queue push and one possible wakeup per task.
+// @note It is not thread safe. Use one TaskBatch per producer thread.
+class EVPP_EXPORT TaskBatch {
+public:
+    TaskBatch() {}
+    ~TaskBatch();
+
+    TaskBatch(const TaskBatch&) = delete;
+    TaskBatch& operator=(const TaskBatch&) = delete;
+
+    void Add(EventLoop* loop, Task&& task);
+
+    // @brief Post all the staged tasks to their loops
+    void Flush();
+
+    // @brief The count of the staged tasks
+    size_t size() const;
+private:
+    std::vector<std::pair<EventLoop*, std::vector<Task>>> batches_;
+};
 }
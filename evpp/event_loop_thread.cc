@@ -2,6 +2,7 @@
 
 #include "evpp/event_loop.h"
 #include "evpp/event_loop_thread.h"
+#include "evpp/numa.h"
 
 #include <sys/prctl.h>
 
@@ -56,6 +57,14 @@ void EventLoopThread::Run(const Functor& pre, const Functor& post) {
         _log_err(myLog, "set thread name failed! name[%s]", name_.c_str());
     }
 
+    // Before the loop runs, so the memory it allocates from now on is local
+    if (!cpu_affinity_.empty() && !numa::PinThread(cpu_affinity_)) {
+        _log_warn(myLog, "pin the thread to the CPUs failed! name[%s]", name_.c_str());
+    }
+    if (numa_node_ >= 0 && !numa::PreferNode(numa_node_)) {
+        _log_warn(myLog, "prefer the NUMA node %d failed! name[%s]", numa_node_, name_.c_str());
+    }
+
     _log_trace(myLog, "execute pre functor.");
     auto fn = [this, pre]() {
         status_ = kRunning;
@@ -2,6 +2,7 @@
 
 #include <thread>
 #include <mutex>
+#include <vector>
 
 #include "evpp/inner_pre.h"
 #include "evpp/server_status.h"
@@ -46,6 +47,25 @@ public:
 public:
     void set_name(const std::string& n);
     const std::string& name() const;
+
+    // @brief Pin the thread to the CPUs when it starts. It MUST be called before Start.
+    //  The thread runs on any CPU if it is not set or it fails. See numa::PinThread.
+    void set_cpu_affinity(const std::vector<int>& cpus) {
+        cpu_affinity_ = cpus;
+    }
+    const std::vector<int>& cpu_affinity() const {
+        return cpu_affinity_;
+    }
+
+    // @brief Allocate the memory of the thread from the NUMA node, see numa::PreferNode.
+    //  It MUST be called before Start. It is -1 by default, i.e. not set.
+    void set_numa_node(int node) {
+        numa_node_ = node;
+    }
+    int numa_node() const {
+        return numa_node_;
+    }
+
     EventLoop* loop() const;
     struct event_base* event_base();
     std::thread::id tid() const;
@@ -62,6 +82,10 @@ private:
 
     std::string name_;
 
+    // The placement of the thread, see set_cpu_affinity and set_numa_node
+    std::vector<int> cpu_affinity_;
+    int numa_node_ = -1;
+
     logger* myLog{nullptr};
 };
 }
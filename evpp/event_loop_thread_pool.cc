@@ -1,12 +1,20 @@
 #include "evpp/inner_pre.h"
 #include "evpp/event_loop_thread_pool.h"
 #include "evpp/event_loop.h"
+#include "evpp/numa.h"
 
 namespace evpp {
 
 EventLoopThreadPool::EventLoopThreadPool(EventLoop* base_loop, uint32_t thread_number)
     : base_loop_(base_loop),
-      thread_num_(thread_number) {
+      thread_num_(thread_number),
+      load_storage_(new char[(thread_number + 1) * sizeof(Load)]) {
+    uintptr_t p = reinterpret_cast<uintptr_t>(load_storage_.get());
+    p = (p + alignof(Load) - 1) & ~uintptr_t(alignof(Load) - 1);
+    loads_ = reinterpret_cast<Load*>(p);
+    for (uint32_t i = 0; i < thread_number; ++i) {
+        new (&loads_[i]) Load;
+    }
     _log_trace(myLog, "thread_num=%d base loop=%s", thread_num(), (base_loop_ ? "base_loop_" : "NULL"));
 }
 
@@ -25,6 +33,8 @@ bool EventLoopThreadPool::Start(bool wait_thread_started) {
         return true;
     }
 
+    Place();
+
     std::shared_ptr<std::atomic<uint32_t>> started_count(new std::atomic<uint32_t>(0));
     std::shared_ptr<std::atomic<uint32_t>> exited_count(new std::atomic<uint32_t>(0));
     for (uint32_t i = 0; i < thread_num_; ++i) {
@@ -49,6 +59,14 @@ bool EventLoopThreadPool::Start(bool wait_thread_started) {
             ss << name_ << "-" << i;
         }
         t->set_name(ss.str());
+        t->loop()->EnableMetrics(metrics_enabled_.load());
+        if (busy_poll_.Nanoseconds() > 0) {
+            t->loop()->SetBusyPoll(busy_poll_, busy_poll_adaptive_);
+        }
+        if (!placements_.empty()) {
+            t->set_cpu_affinity(placements_[i].cpus);
+            t->set_numa_node(placements_[i].node);
+        }
 
         if (!t->Start(wait_thread_started, prefn, postfn)) {
             //FIXME error process
@@ -56,6 +74,7 @@ bool EventLoopThreadPool::Start(bool wait_thread_started) {
             return false;
         }
 
+        loop_index_[t->loop()] = static_cast<uint32_t>(threads_.size());
         threads_.push_back(t);
     }
 
@@ -141,6 +160,43 @@ void EventLoopThreadPool::AfterFork() {
     }
 }
 
+void EventLoopThreadPool::EnableMetrics(bool on) {
+    metrics_enabled_.store(on);
+    if (IsRunning()) {
+        for (auto& t : threads_) {
+            t->loop()->EnableMetrics(on);
+        }
+    }
+}
+
+LoopMetricsSnapshot EventLoopThreadPool::metrics_snapshot() const {
+    LoopMetricsSnapshot s;
+    // threads_ is only modified during Start
+    if (IsRunning() || IsStopping() || IsStopped()) {
+        for (auto& t : threads_) {
+            s.Merge(t->loop()->metrics_snapshot());
+        }
+    }
+    return s;
+}
+
+BusyPollStats EventLoopThreadPool::busy_poll_stats() const {
+    BusyPollStats s;
+    if (IsRunning() || IsStopping() || IsStopped()) {
+        for (auto& t : threads_) {
+            BusyPollStats l = t->loop()->busy_poll_stats();
+            s.spin_ns += l.spin_ns;
+            s.idle_spin_ns += l.idle_spin_ns;
+            s.hits += l.hits;
+            s.blocks += l.blocks;
+            s.wakeup_samples += l.wakeup_samples;
+            s.wakeup_ns += l.wakeup_ns;
+            s.spin_limit_ns = std::max(s.spin_limit_ns, l.spin_limit_ns);
+        }
+    }
+    return s;
+}
+
 EventLoop* EventLoopThreadPool::GetNextLoop() {
     // DLOG_TRACE;
     EventLoop* loop = base_loop_;
@@ -166,6 +222,172 @@ EventLoop* EventLoopThreadPool::GetNextLoopWithHash(uint64_t hash) {
     return loop;
 }
 
+namespace {
+// The jump consistent hash by John Lamping and Eric Veach. When the count of
+// the buckets grows from n to n + 1, only 1/(n + 1) of the keys move, all of
+// them to the new bucket. It needs no memory, unlike a hash ring.
+uint32_t JumpConsistentHash(uint64_t key, uint32_t buckets) {
+    int64_t b = -1;
+    int64_t j = 0;
+    while (j < int64_t(buckets)) {
+        b = j;
+        key = key * 2862933555777941757ULL + 1;
+        j = int64_t(double(b + 1) * (double(1LL << 31) / double((key >> 33) + 1)));
+    }
+    return static_cast<uint32_t>(b);
+}
+
+// The SplitMix64 finalizer, which turns a counter into random bits
+uint64_t Mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+}
+
+EventLoop* EventLoopThreadPool::GetNextLoop(ThreadDispatchPolicy::Policy policy, uint64_t hash) {
+    if (!IsRunning() || threads_.empty()) {
+        return base_loop_;
+    }
+
+    uint32_t n = static_cast<uint32_t>(threads_.size());
+    switch (policy) {
+    case ThreadDispatchPolicy::kRoundRobin:
+        return GetNextLoop();
+    case ThreadDispatchPolicy::kIPAddressHashing:
+        return GetNextLoopWithHash(hash);
+    case ThreadDispatchPolicy::kConsistentHashing:
+        // The addresses are not random enough for the hash
+        return threads_[JumpConsistentHash(Mix(hash), n)]->loop();
+    case ThreadDispatchPolicy::kPowerOfTwoChoices: {
+        if (n == 1) {
+            return threads_[0]->loop();
+        }
+
+        uint64_t r = Mix(random_seq_.fetch_add(1, std::memory_order_relaxed));
+        uint32_t a = static_cast<uint32_t>(r % n);
+        uint32_t b = static_cast<uint32_t>((a + 1 + (r >> 32) % (n - 1)) % n);
+        return threads_[load(b) < load(a) ? b : a]->loop();
+    }
+    case ThreadDispatchPolicy::kLeastConnections:
+    case ThreadDispatchPolicy::kLeastPendingFunctors: {
+        // Start the scan from the next loop of the round robin,
+        // so the ties don't always go to the first loop
+        uint32_t start = static_cast<uint32_t>(next_.fetch_add(1, std::memory_order_relaxed) % n);
+        uint32_t best = start;
+        int64_t best_load = INT64_MAX;
+        for (uint32_t k = 0; k < n; k++) {
+            uint32_t i = (start + k) % n;
+            int64_t l = policy == ThreadDispatchPolicy::kLeastConnections ? load(i) : threads_[i]->loop()->pending_functor_count();
+            if (l < best_load) {
+                best = i;
+                best_load = l;
+            }
+        }
+        return threads_[best]->loop();
+    }
+    }
+
+    return GetNextLoop();
+}
+
+void EventLoopThreadPool::AddLoad(EventLoop* loop, int64_t delta) {
+    auto it = loop_index_.find(loop);
+    if (it != loop_index_.end()) {
+        loads_[it->second].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+}
+
+void EventLoopThreadPool::SetCPUAffinity(const std::vector<std::vector<int>>& cpu_sets) {
+    assert(!IsRunning());
+    cpu_sets_ = cpu_sets;
+}
+
+void EventLoopThreadPool::SpreadAcrossNUMANodes(bool pin_to_cpu) {
+    assert(!IsRunning());
+    numa_spread_ = true;
+    pin_to_cpu_ = pin_to_cpu;
+}
+
+void EventLoopThreadPool::Place() {
+    placements_.clear();
+    cpu_loops_.clear();
+    node_loops_.clear();
+
+    if (numa_spread_) {
+        // The nodes which have CPUs for this process
+        std::vector<int> nodes;
+        for (int n = 0; n < numa::NodeCount(); ++n) {
+            if (!numa::CPUsOfNode(n).empty()) {
+                nodes.push_back(n);
+            }
+        }
+
+        if (nodes.empty()) {
+            _log_warn(myLog, "no NUMA node has CPUs for this process, the loops are not placed");
+            return;
+        }
+
+        for (uint32_t i = 0; i < thread_num_; ++i) {
+            Placement p;
+            p.node = nodes[i % nodes.size()];
+            std::vector<int> cpus = numa::CPUsOfNode(p.node);
+            if (pin_to_cpu_) {
+                // The loops on the same node go to its CPUs in turn
+                p.cpus.push_back(cpus[(i / nodes.size()) % cpus.size()]);
+            } else {
+                p.cpus = cpus;
+            }
+            placements_.push_back(p);
+        }
+    } else if (!cpu_sets_.empty()) {
+        for (uint32_t i = 0; i < thread_num_; ++i) {
+            Placement p;
+            p.cpus = cpu_sets_[i % cpu_sets_.size()];
+            p.node = p.cpus.empty() ? -1 : numa::NodeOfCPU(p.cpus[0]);
+            placements_.push_back(p);
+        }
+    }
+
+    for (uint32_t i = 0; i < placements_.size(); ++i) {
+        for (int cpu : placements_[i].cpus) {
+            cpu_loops_[cpu].push_back(i);
+        }
+        if (placements_[i].node >= 0) {
+            node_loops_[placements_[i].node].push_back(i);
+        }
+    }
+}
+
+uint32_t EventLoopThreadPool::LeastLoaded(const std::vector<uint32_t>& loops) const {
+    assert(!loops.empty());
+    uint32_t best = loops[0];
+    for (uint32_t i : loops) {
+        if (load(i) < load(best)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+EventLoop* EventLoopThreadPool::GetLoopForCPU(int cpu) {
+    if (!IsRunning() || placements_.empty() || cpu < 0) {
+        return nullptr;
+    }
+
+    auto it = cpu_loops_.find(cpu);
+    if (it != cpu_loops_.end()) {
+        return threads_[LeastLoaded(it->second)]->loop();
+    }
+
+    it = node_loops_.find(numa::NodeOfCPU(cpu));
+    if (it != node_loops_.end()) {
+        return threads_[LeastLoaded(it->second)]->loop();
+    }
+    return nullptr;
+}
+
 uint32_t EventLoopThreadPool::thread_num() const {
     return thread_num_;
 }
@@ -1,9 +1,14 @@
 #pragma once
 
 #include "evpp/event_loop_thread.h"
+#include "evpp/duration.h"
 #include "evpp/evlog.h"
+#include "evpp/loop_metrics.h"
+#include "evpp/thread_dispatch_policy.h"
 
 #include <atomic>
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace evpp {
@@ -31,8 +36,74 @@ public:
     EventLoop* GetNextLoop();
     EventLoop* GetNextLoopWithHash(uint64_t hash);
 
+    // @brief Choose a loop by policy. It is thread safe.
+    // @param hash - The hash of the peer address, used by kIPAddressHashing
+    //  and kConsistentHashing
+    // @note kLeastConnections and kPowerOfTwoChoices compare the loads counted
+    //  by AddLoad, which is the job of the caller, e.g. TCPServer.
+    EventLoop* GetNextLoop(ThreadDispatchPolicy::Policy policy, uint64_t hash);
+
+    // @brief Add delta to the load of loop, e.g. 1 when a connection is
+    //  dispatched to it and -1 when it is closed. It is thread safe.
+    //  It is ignored if loop is not a working loop of this pool.
+    void AddLoad(EventLoop* loop, int64_t delta);
+
+    // The load of the index-th working loop
+    int64_t load(uint32_t index) const {
+        return loads_[index].value.load(std::memory_order_relaxed);
+    }
+
     uint32_t thread_num() const;
 
+public:
+    // @brief Pin the i-th loop to cpu_sets[i % cpu_sets.size()], and allocate
+    //  its memory from the NUMA node of the first CPU of the set.
+    // @note It MUST be called before Start.
+    void SetCPUAffinity(const std::vector<std::vector<int>>& cpu_sets);
+
+    // @brief Spread the loops across the NUMA nodes by round robin. A loop is
+    //  pinned to one CPU of its node if pin_to_cpu, or to all the CPUs of its
+    //  node otherwise. Its memory, e.g. its buffers, timers and connections,
+    //  is allocated from its node, see numa::PreferNode.
+    // @note It MUST be called before Start. It overrides SetCPUAffinity.
+    void SpreadAcrossNUMANodes(bool pin_to_cpu);
+
+    // @brief The loop placed nearest to cpu : the least loaded one of the
+    //  loops pinned to cpu, or else of the loops on the node of cpu, e.g. for
+    //  a connection whose packets are received on cpu, see sock::GetIncomingCPU.
+    //  It is thread safe.
+    // @return nullptr if the loops are not placed, or none is near cpu
+    EventLoop* GetLoopForCPU(int cpu);
+
+    // Whether the loops are placed by SetCPUAffinity or SpreadAcrossNUMANodes
+    bool placed() const {
+        return !placements_.empty();
+    }
+
+    // The NUMA node of the index-th loop, or -1 if the loops are not placed
+    int numa_node(uint32_t index) const {
+        return index < placements_.size() ? placements_[index].node : -1;
+    }
+
+    // @brief Turn on or off the metrics of all the loops of this pool.
+    //  It can be called before or after Start. See EventLoop::EnableMetrics.
+    void EnableMetrics(bool on);
+
+    // @brief Busy poll in all the loops of this pool, see EventLoop::SetBusyPoll.
+    // @note It MUST be called before Start.
+    void SetBusyPoll(Duration max_spin, bool adaptive = true) {
+        assert(!IsRunning());
+        busy_poll_ = max_spin;
+        busy_poll_adaptive_ = adaptive;
+    }
+
+    // @brief The busy poll statistics of all the loops of this pool added up
+    BusyPollStats busy_poll_stats() const;
+
+    // @brief The metrics of all the loops of this pool merged into one snapshot.
+    //  It is empty if the pool has not been started.
+    LoopMetricsSnapshot metrics_snapshot() const;
+
 public:
     void set_name(const std::string& n) { name_ = n; }
     const std::string& name() const { return name_; }
@@ -41,12 +112,42 @@ private:
     void Stop(bool wait_thread_exit, DoneCallback fn);
     void OnThreadStarted(uint32_t count);
     void OnThreadExited(uint32_t count);
+    void Place();
+    uint32_t LeastLoaded(const std::vector<uint32_t>& loops) const;
 
 protected:
     EventLoop* base_loop_;
 
     uint32_t thread_num_ = 0;
     std::atomic<int64_t> next_ = { 0 };
+    std::atomic<uint64_t> random_seq_ = { 0 }; // The random choices of kPowerOfTwoChoices
+
+    // On separate cache lines, since they are updated by different loops
+    struct alignas(64) Load {
+        Load() : value(0) {}
+        std::atomic<int64_t> value;
+    };
+
+    // std::allocator doesn't align beyond max_align_t before C++17,
+    // so the Loads are placed in a storage aligned by hand
+    std::unique_ptr<char[]> load_storage_;
+    Load* loads_ = nullptr;
+    std::map<const EventLoop*, uint32_t> loop_index_; // Only modified during Start
+    std::atomic<bool> metrics_enabled_ = { false };
+    Duration busy_poll_;
+    bool busy_poll_adaptive_ = true;
+
+    // The placement of the loops, see SetCPUAffinity and SpreadAcrossNUMANodes
+    struct Placement {
+        std::vector<int> cpus;
+        int node;
+    };
+    std::vector<std::vector<int>> cpu_sets_;
+    bool numa_spread_ = false;
+    bool pin_to_cpu_ = false;
+    std::vector<Placement> placements_; // Only modified during Start
+    std::map<int, std::vector<uint32_t>> cpu_loops_; // The loops pinned to a CPU
+    std::map<int, std::vector<uint32_t>> node_loops_; // The loops on a node
 
     DoneCallback stopped_cb_;
 
@@ -7,6 +7,10 @@
 #include "evpp/event_loop.h"
 #include "evpp/evlog.h"
 
+#ifdef H_OS_LINUX
+#include <sys/eventfd.h>
+#endif
+
 namespace evpp {
 
 EventWatcher::EventWatcher(struct event_base* evbase, const Handler& handler)
@@ -180,6 +184,117 @@ void PipeEventWatcher::Notify() {
     }
 }
 
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+NotifyWatcher::NotifyWatcher(EventLoop* loop,
+                             const Handler& handler)
+    : EventWatcher(loop->event_base(), handler) {
+    memset(fds_, 0, sizeof(fds_[0]) * 2);
+}
+
+NotifyWatcher::NotifyWatcher(EventLoop* loop,
+                             Handler&& h)
+    : EventWatcher(loop->event_base(), std::move(h)) {
+    memset(fds_, 0, sizeof(fds_[0]) * 2);
+}
+
+NotifyWatcher::~NotifyWatcher() {
+    Close();
+}
+
+bool NotifyWatcher::DoInit() {
+    assert(fds_[0] == 0);
+
+#ifdef H_OS_LINUX
+    int efd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (efd >= 0) {
+        fds_[0] = efd;
+        fds_[1] = efd;
+    } else {
+        int err = errno;
+        _log_warn(myLog, "create eventfd ERROR errno=%d err=%s, fall back to socketpair", err, strerror(err).c_str());
+    }
+#endif
+
+    if (fds_[0] == 0) {
+        if (evutil_socketpair(AF_UNIX, SOCK_STREAM, 0, fds_) < 0) {
+            int err = errno;
+            _log_err(myLog, "create socketpair ERROR errno=%d err=%s", err, strerror(err).c_str());
+            goto failed;
+        }
+
+        if (evutil_make_socket_nonblocking(fds_[0]) < 0 ||
+            evutil_make_socket_nonblocking(fds_[1]) < 0) {
+            goto failed;
+        }
+    }
+
+    ::event_set(event_, fds_[1], EV_READ | EV_PERSIST,
+                &NotifyWatcher::HandlerFn, this);
+    return true;
+failed:
+    Close();
+    return false;
+}
+
+void NotifyWatcher::DoClose() {
+    if (fds_[0] > 0) {
+        if (fds_[0] == fds_[1]) {
+            EVUTIL_CLOSESOCKET(fds_[0]);
+        } else {
+            EVUTIL_CLOSESOCKET(fds_[0]);
+            EVUTIL_CLOSESOCKET(fds_[1]);
+        }
+        memset(fds_, 0, sizeof(fds_[0]) * 2);
+    }
+}
+
+void NotifyWatcher::HandlerFn(evpp_socket_t /*fd*/, short /*which*/, void* v) {
+    NotifyWatcher* e = (NotifyWatcher*)v;
+    ssize_t n = 0;
+
+#ifdef H_OS_LINUX
+    if (e->IsEventFd()) {
+        // One read resets the eventfd counter no matter how many Notify() were issued
+        uint64_t count = 0;
+        n = ::read(e->fds_[1], &count, sizeof(count));
+    } else
+#endif
+    {
+        char buf[4096];
+        n = ::recv(e->fds_[1], buf, sizeof(buf), 0);
+    }
+
+    if (n > 0) {
+        e->handler_();
+    }
+}
+
+bool NotifyWatcher::AsyncWait() {
+    return Watch(Duration());
+}
+
+void NotifyWatcher::Notify() {
+#ifdef H_OS_LINUX
+    if (IsEventFd()) {
+        // It fails only when the counter would overflow, and then the eventfd is readable anyway
+        uint64_t one = 1;
+        ssize_t n = ::write(fds_[0], &one, sizeof(one));
+        (void)n;
+        return;
+    }
+#endif
+
+    char buf[1] = {};
+
+    if (::send(fds_[0], buf, sizeof(buf), 0) < 0) {
+        return;
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
@@ -223,6 +338,11 @@ bool TimerEventWatcher::AsyncWait() {
     return Watch(timeout_);
 }
 
+bool TimerEventWatcher::AsyncWait(Duration timeout) {
+    timeout_ = timeout;
+    return Watch(timeout_);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
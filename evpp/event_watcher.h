@@ -70,6 +70,29 @@ private:
     evpp_socket_t pipe_[2]; // Write to pipe_[0] , Read from pipe_[1]
 };
 
+// NotifyWatcher is the wakeup channel of EventLoop's task queue.
+// On Linux it is backed by a single eventfd, so one Notify() costs one
+// write(2) and any number of pending notifications are drained by one read(2).
+// On other platforms it falls back to a socketpair like PipeEventWatcher.
+class EVPP_EXPORT NotifyWatcher : public EventWatcher {
+public:
+    NotifyWatcher(EventLoop* loop, const Handler& handler);
+    NotifyWatcher(EventLoop* loop, Handler&& handler);
+    ~NotifyWatcher();
+
+    bool AsyncWait();
+    void Notify();
+
+    // Return true if this watcher is backed by an eventfd
+    bool IsEventFd() const { return fds_[0] == fds_[1] && fds_[0] > 0; }
+private:
+    virtual bool DoInit();
+    virtual void DoClose();
+    static void HandlerFn(evpp_socket_t fd, short which, void* v);
+
+    evpp_socket_t fds_[2]; // Write to fds_[0] , Read from fds_[1]. They are the same fd when using eventfd
+};
+
 class EVPP_EXPORT TimerEventWatcher : public EventWatcher {
 public:
     TimerEventWatcher(EventLoop* loop, const Handler& handler, Duration timeout);
@@ -79,6 +102,9 @@ public:
 
     bool AsyncWait();
 
+    // @brief Wait for a new timeout, it replaces the timeout given to the constructor
+    bool AsyncWait(Duration timeout);
+
 private:
     virtual bool DoInit();
     static void HandlerFn(evpp_socket_t fd, short which, void* v);
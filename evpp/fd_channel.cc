@@ -5,13 +5,19 @@
 #include "evpp/fd_channel.h"
 #include "evpp/libevent.h"
 #include "evpp/event_loop.h"
+#include "evpp/epoll_poller.h"
+
+#ifdef H_OS_LINUX
+#include <sys/epoll.h>
+#endif
 
 namespace evpp {
 static_assert(FdChannel::kReadable == EV_READ, "");
 static_assert(FdChannel::kWritable == EV_WRITE, "");
 
 FdChannel::FdChannel(EventLoop* l, evpp_socket_t f, bool r, bool w)
-    : loop_(l), attached_(false), event_(nullptr), fd_(f) {
+    : loop_(l), attached_(false), event_(nullptr)
+    , edge_triggered_(false), registered_(false), polled_events_(kNone), fd_(f) {
     _log_trace(myLog, "fd=%d", fd_);
     assert(fd_ > 0);
     events_ = (r ? kReadable : 0) | (w ? kWritable : 0);
@@ -28,6 +34,13 @@ FdChannel::~FdChannel() {
 void FdChannel::Close() {
     _log_trace(myLog, "fd=%d", fd_);
     // fprintf(stderr, "close fd=%d\n", fd_);
+    if (registered_) {
+        // It MUST be unregistered before the fd is closed by its owner
+        assert(loop_->poller());
+        loop_->poller()->Remove(this);
+        registered_ = false;
+    }
+
     assert(event_);
     if (event_) {
         assert(!attached_);
@@ -46,6 +59,12 @@ void FdChannel::AttachToLoop() {
     assert(!IsNoneEvent());
     assert(loop_->IsInLoopThread());
 
+    EpollPoller* p = loop_->poller();
+    if (p) {
+        UpdatePoller(p);
+        return;
+    }
+
     if (attached_) {
         // FdChannel::Update may be called many times
         // So doing this can avoid event_add will be called more than once.
@@ -65,6 +84,11 @@ void FdChannel::AttachToLoop() {
     }
 }
 
+void FdChannel::SetEdgeTriggered(bool on) {
+    assert(!registered_);
+    edge_triggered_ = on && loop_->poller() != nullptr;
+}
+
 void FdChannel::EnableReadEvent() {
     int events = events_;
     events_ |= kReadable;
@@ -124,6 +148,12 @@ void FdChannel::DetachFromLoop() {
 void FdChannel::Update() {
     assert(loop_->IsInLoopThread());
 
+    EpollPoller* p = loop_->poller();
+    if (p) {
+        UpdatePoller(p);
+        return;
+    }
+
     if (IsNoneEvent()) {
         DetachFromLoop();
     } else {
@@ -131,6 +161,66 @@ void FdChannel::Update() {
     }
 }
 
+uint32_t FdChannel::PollerEvents() const {
+#ifdef H_OS_LINUX
+    if (edge_triggered_) {
+        return EPOLLIN | EPOLLOUT | EPOLLET;
+    }
+
+    if (events_ == kNone) {
+        // EPOLLHUP and EPOLLERR are always reported. They are ignored
+        // by HandlePollerEvent, so only report their edges, or they spin the loop.
+        return EPOLLET;
+    }
+
+    uint32_t e = 0;
+    if (events_ & kReadable) {
+        e |= EPOLLIN;
+    }
+
+    if (events_ & kWritable) {
+        e |= EPOLLOUT;
+    }
+    return e;
+#else
+    return 0;
+#endif
+}
+
+void FdChannel::UpdatePoller(EpollPoller* p) {
+    assert(loop_->IsInLoopThread());
+
+    bool ok = true;
+    if (!registered_) {
+        if (IsNoneEvent()) {
+            attached_ = false;
+            return;
+        }
+
+        ok = p->Add(this, PollerEvents());
+        registered_ = ok;
+    } else if (!edge_triggered_ && IsNoneEvent()) {
+        // It is usually going to be closed, in which case EPOLL_CTL_DEL is enough.
+        // The kernel is updated lazily if it reports anything before that.
+        attached_ = false;
+        return;
+    } else if (edge_triggered_ ? (events_ & ~polled_events_) != 0 : events_ != polled_events_) {
+        // An edge triggered fd is re-armed when an event is enabled, so the
+        // readiness happened while the event was disabled is reported again.
+        // Disabling an event of it needs nothing, see HandlePollerEvent.
+        ok = p->Modify(this, PollerEvents());
+    }
+
+    if (ok) {
+        polled_events_ = events_;
+        attached_ = !IsNoneEvent();
+        _log_trace(myLog, "fd=%d watching event=%s", fd_, EventsToString().c_str());
+    } else {
+        attached_ = false;
+        _log_err(myLog, "fd=%d with event %s update the epoll poller failed", fd_, EventsToString().c_str());
+    }
+}
+
 std::string FdChannel::EventsToString() const {
     std::string s;
 
@@ -160,12 +250,50 @@ void FdChannel::HandleEvent(evpp_socket_t sockfd, short which) {
     assert(sockfd == fd_);
     // _log_trace(myLog, "fd=%d err=%s", sockfd, EventsToString().c_str());
 
+    loop_->NoteActivity();
+    LoopMetrics* m = loop_->metrics();
+    if (m) {
+        HandleEventWithMetrics(which, m);
+        return;
+    }
+
+    if ((which & kReadable) && read_fn_) {
+        read_fn_();
+    }
+
+    if ((which & kWritable) && write_fn_) {
+        write_fn_();
+    }
+}
+
+void FdChannel::HandlePollerEvent(short which) {
+    // An edge triggered fd is always registered for both events,
+    // and EPOLLHUP and EPOLLERR are reported without being asked for
+    which &= events_;
+    if (!edge_triggered_ && polled_events_ != events_) {
+        // All the events were disabled lazily, see UpdatePoller
+        assert(IsNoneEvent());
+        if (loop_->poller()->Modify(this, PollerEvents())) {
+            polled_events_ = events_;
+        }
+    }
+
+    if (which) {
+        HandleEvent(fd_, which);
+    }
+}
+
+void FdChannel::HandleEventWithMetrics(short which, LoopMetrics* m) {
     if ((which & kReadable) && read_fn_) {
+        int64_t start = LoopMetrics::Now();
         read_fn_();
+        LoopMetrics::RecordElapsed(m->fd_read, start);
     }
 
     if ((which & kWritable) && write_fn_) {
+        int64_t start = LoopMetrics::Now();
         write_fn_();
+        LoopMetrics::RecordElapsed(m->fd_write, start);
     }
 }
 }
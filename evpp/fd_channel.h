@@ -9,6 +9,8 @@ struct event_base;
 namespace evpp {
 
 class EventLoop;
+class LoopMetrics;
+class EpollPoller;
 
 // A selectable I/O fd channel.
 //
@@ -40,6 +42,18 @@ public:
         return attached_;
     }
 
+    // @brief Use the edge triggered mode of the epoll backend for this channel.
+    //  The fd is registered for both reading and writing only once, enabling an
+    //  event only re-arms it and disabling an event costs nothing.
+    //  The read callback MUST read until EAGAIN, or the rest data is never reported again.
+    //  It has no effect on the libevent backend, see EventLoop::IOBackend.
+    // @note It MUST be called before AttachToLoop
+    void SetEdgeTriggered(bool on);
+
+    bool edge_triggered() const {
+        return edge_triggered_;
+    }
+
 public:
     bool IsReadable() const {
         return (events_ & kReadable) != 0;
@@ -75,10 +89,17 @@ public:
 private:
     void HandleEvent(evpp_socket_t fd, short which);
     static void HandleEvent(evpp_socket_t fd, short which, void* v);
+    void HandleEventWithMetrics(short which, LoopMetrics* m);
 
     void Update();
     void DetachFromLoop();
 
+    // The epoll backend
+    friend class EpollPoller;
+    void HandlePollerEvent(short which);
+    void UpdatePoller(EpollPoller* p);
+    uint32_t PollerEvents() const;
+
 protected:
     ReadEventCallback read_fn_;
     EventCallback write_fn_;
@@ -89,6 +110,10 @@ protected:
     struct event* event_;
     int events_; // the bitwise OR of zero or more of the EventType flags
 
+    bool edge_triggered_;
+    bool registered_;    // Whether fd_ is registered in the EpollPoller of loop_
+    int polled_events_;  // The events_ when the registration was updated last time
+
     evpp_socket_t fd_;
     logger* myLog{nullptr};
 };
@@ -6,6 +6,7 @@
 #include "evpp/event_loop.h"
 #include "evpp/event_loop_thread.h"
 #include "evpp/event_loop_thread_pool.h"
+#include "evpp/compute_pool.h"
 #include "evpp/utility.h"
 
 #include <future>
@@ -140,6 +141,12 @@ bool Server::Start() {
         return false;
     }
 
+    if (compute_thread_num_ > 0) {
+        compute_pool_.reset(new ComputePool(compute_thread_num_));
+        compute_pool_->SetLogger(myLog);
+        compute_pool_->Start();
+    }
+
     for (auto& lt : listen_threads_) {
         auto& hservice = lt.hservice;
         auto& lthread = lt.thread;
@@ -220,8 +227,12 @@ void Server::Stop() {
     }
     promise.get_future().wait();
 
-    // Secondly we stop thread pool
+    // Secondly we stop thread pool, after the compute pool, whose
+    // tasks are delivering their results to the working threads
     substatus_.store(kStoppingThreadPool);
+    if (compute_pool_) {
+        compute_pool_->Stop();
+    }
     tpool_->Stop(true);
 
     // Thirdly we stop the listening threads
@@ -280,6 +291,35 @@ void Server::RegisterDefaultHandler(HTTPRequestCallback callback) {
     default_callback_ = callback;
 }
 
+namespace {
+// A request in process, counted in the load of its loop until it is replied.
+// The count is dropped only once, even if the handler replies more than once,
+// and it is dropped as well when the handler drops the response callback
+// without replying.
+class RequestLoad {
+public:
+    RequestLoad(const std::shared_ptr<EventLoopThreadPool>& pool, EventLoop* loop)
+        : pool_(pool), loop_(loop), done_(false) {
+        pool_->AddLoad(loop_, 1);
+    }
+
+    ~RequestLoad() {
+        Done();
+    }
+
+    void Done() {
+        if (!done_.exchange(true)) {
+            pool_->AddLoad(loop_, -1);
+        }
+    }
+
+private:
+    std::shared_ptr<EventLoopThreadPool> pool_;
+    EventLoop* loop_;
+    std::atomic<bool> done_;
+};
+}
+
 void Server::Dispatch(EventLoop* listening_loop,
                       const ContextPtr& ctx,
                       const HTTPSendResponseCallback& response_callback,
@@ -296,8 +336,18 @@ void Server::Dispatch(EventLoop* listening_loop,
     EventLoop* loop = nullptr;
     loop = GetNextLoop(listening_loop, ctx);
 
+    // The requests in process are the load of kLeastConnections and kPowerOfTwoChoices
+    HTTPSendResponseCallback respcb = response_callback;
+    if (policy_ == kLeastConnections || policy_ == kPowerOfTwoChoices) {
+        std::shared_ptr<RequestLoad> load = std::make_shared<RequestLoad>(tpool_, loop);
+        respcb = [load, response_callback](const std::string& response_data) {
+            load->Done();
+            response_callback(response_data);
+        };
+    }
+
     // Forward this HTTP request to a worker thread to process
-    auto f = [loop, ctx, response_callback, user_callback, this]() {
+    auto f = [loop, ctx, respcb, user_callback, this]() {
         // DLOG_TRACE << "process request " << ctx->req()
         //     << " url=" << ctx->original_uri()
         //     << " in working thread. status=" << StatusToString();
@@ -315,7 +365,7 @@ void Server::Dispatch(EventLoop* listening_loop,
         // to send the result back to framework,
         // that actually comes back to Service::SendReply method.
         assert(loop->IsInLoopThread());
-        user_callback(loop, ctx, response_callback);
+        user_callback(loop, ctx, respcb);
     };
 
     loop->RunInLoop(f);
@@ -331,6 +381,11 @@ EventLoop* Server::GetNextLoop(EventLoop* default_loop, const ContextPtr& ctx) {
         return tpool_->GetNextLoop();
     }
 
+    if (policy_ != kIPAddressHashing) {
+        uint64_t hash = policy_ == kConsistentHashing ? std::hash<std::string>()(ctx->remote_ip()) : 0;
+        return tpool_->GetNextLoop(policy_, hash);
+    }
+
 #if LIBEVENT_VERSION_NUMBER >= 0x02010500
     const sockaddr*  sa = evhttp_connection_get_addr(ctx->req()->evcon);
     if (sa) {
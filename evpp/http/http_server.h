@@ -15,6 +15,7 @@ class EventLoop;
 class EventLoopThreadPool;
 class PipeEventWatcher;
 class EventLoopThread;
+class ComputePool;
 
 namespace http {
 class Service;
@@ -90,6 +91,21 @@ public:
         return tpool_;
     }
 
+    // @brief Start a ComputePool of thread_num threads with the server, for
+    //  the CPU bound work of the handlers, e.g. building a large JSON. It
+    //  MUST be called before Start. It is off by default.
+    //  A handler runs the work by compute_pool()->Compute(loop, work, done),
+    //  and sends the response in done, which runs on the loop of the handler.
+    void SetComputeThreadNum(uint32_t thread_num) {
+        assert(!IsRunning());
+        compute_thread_num_ = thread_num;
+    }
+
+    // The ComputePool, which is null if SetComputeThreadNum is not called
+    std::shared_ptr<ComputePool> compute_pool() const {
+        return compute_pool_;
+    }
+
     // Get the service object hold by this http server.
     Service* service(int index = 0) const;
 private:
@@ -113,6 +129,10 @@ private:
     // The worker thread pool used to process HTTP request
     std::shared_ptr<EventLoopThreadPool> tpool_;
 
+    // The pool of the CPU bound work, see SetComputeThreadNum
+    uint32_t compute_thread_num_ = 0;
+    std::shared_ptr<ComputePool> compute_pool_;
+
     HTTPRequestCallbackMap callbacks_;
     HTTPRequestCallback default_callback_;
 #if defined(EVPP_HTTP_SERVER_SUPPORTS_SSL)
@@ -6,11 +6,15 @@
 namespace evpp {
 
 InvokeTimer::InvokeTimer(EventLoop* evloop, Duration timeout, const Functor& f, bool periodic)
-    : loop_(evloop), timeout_(timeout), functor_(f), periodic_(periodic) {
+    : loop_(evloop), timeout_(timeout), functor_(f), periodic_(periodic), mode_(kEventTimer), deadline_ns_(0) {
 }
 
 InvokeTimer::InvokeTimer(EventLoop* evloop, Duration timeout, Functor&& f, bool periodic)
-    : loop_(evloop), timeout_(timeout), functor_(std::move(f)), periodic_(periodic) {
+    : loop_(evloop), timeout_(timeout), functor_(std::move(f)), periodic_(periodic), mode_(kEventTimer), deadline_ns_(0) {
+}
+
+InvokeTimer::InvokeTimer(EventLoop* evloop, Duration timeout, Task&& f, bool periodic, Mode mode)
+    : loop_(evloop), timeout_(timeout), functor_(std::move(f)), periodic_(periodic), mode_(mode), deadline_ns_(0) {
 }
 
 InvokeTimerPtr InvokeTimer::Create(EventLoop* evloop, Duration timeout, const Functor& f, bool periodic) {
@@ -25,11 +29,30 @@ InvokeTimerPtr InvokeTimer::Create(EventLoop* evloop, Duration timeout, Functor&
     return it;
 }
 
+InvokeTimerPtr InvokeTimer::Create(EventLoop* evloop, Duration timeout, Task&& f, bool periodic, Mode mode) {
+    InvokeTimerPtr it(new InvokeTimer(evloop, timeout, std::move(f), periodic, mode));
+    it->self_ = it;
+    return it;
+}
+
 InvokeTimer::~InvokeTimer() {
 }
 
 void InvokeTimer::Start() {
     _log_trace(myLog, "refcount=%d", self_.use_count());
+    if (mode_ == kWheelTimer) {
+        InvokeTimerPtr time_ptr = shared_from_this();
+        auto f = [time_ptr]() {
+            // It may have been canceled before it starts
+            if (time_ptr->self_) {
+                time_ptr->UpdateDeadline();
+                time_ptr->loop_->timing_wheel()->Add(time_ptr.get(), time_ptr->timeout_);
+            }
+        };
+        loop_->RunInLoop(std::move(f));
+        return;
+    }
+
     auto f = [this]() {
         timer_.reset(new TimerEventWatcher(loop_, [time_weak = std::weak_ptr<InvokeTimer>(shared_from_this())]() {
             auto time_ptr = time_weak.lock();
@@ -45,6 +68,7 @@ void InvokeTimer::Start() {
             }
         });
         timer_->Init();
+        UpdateDeadline();
         timer_->AsyncWait();
         _log_trace(myLog, "refcount=%d periodic=%d timeout(ms)=%d", self_.use_count(), periodic_, timeout_.Milliseconds());
     };
@@ -55,7 +79,17 @@ void InvokeTimer::Cancel() {
     // DLOG_TRACE;
     auto f = [time_weak = std::weak_ptr<InvokeTimer>(shared_from_this())]() {
         auto time_ptr = time_weak.lock();
-        if (time_ptr && time_ptr->timer_) {
+        if (!time_ptr) {
+            return;
+        }
+
+        if (time_ptr->mode_ == kWheelTimer) {
+            // self_ is reset after a one-shot timer is triggered or canceled
+            if (time_ptr->self_) {
+                time_ptr->loop_->timing_wheel()->Remove(time_ptr.get());
+                time_ptr->OnCanceled();
+            }
+        } else if (time_ptr->timer_) {
             time_ptr->timer_->Cancel();
         }
     };
@@ -64,16 +98,39 @@ void InvokeTimer::Cancel() {
 
 void InvokeTimer::OnTimerTriggered() {
     _log_trace(myLog, "refcount=%d", self_.use_count());
+    loop_->NoteActivity();
+    if (deadline_ns_ != 0) {
+        LoopMetrics* m = loop_->metrics();
+        if (m) {
+            LoopMetrics::RecordElapsed(m->timer_lateness, deadline_ns_);
+        }
+    }
+
     functor_();
 
     if (periodic_) {
-        timer_->AsyncWait();
+        UpdateDeadline();
+        if (mode_ == kWheelTimer) {
+            loop_->timing_wheel()->Add(this, timeout_);
+        } else {
+            timer_->AsyncWait();
+        }
     } else {
         timer_.reset();
         self_.reset();
     }
 }
 
+void InvokeTimer::UpdateDeadline() {
+    deadline_ns_ = loop_->metrics() ? LoopMetrics::Now() + timeout_.Nanoseconds() : 0;
+}
+
+void InvokeTimer::OnWheelTimeout() {
+    // Hold myself, the functor may cancel this timer
+    InvokeTimerPtr guard(self_);
+    OnTimerTriggered();
+}
+
 void InvokeTimer::OnCanceled() {
     _log_trace(myLog, "refcount=%d", self_.use_count());
     periodic_ = false;
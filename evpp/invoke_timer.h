@@ -2,6 +2,8 @@
 
 #include "evpp/inner_pre.h"
 #include "evpp/duration.h"
+#include "evpp/task.h"
+#include "evpp/timing_wheel.h"
 #include "evpp/evlog.h"
 
 namespace evpp {
@@ -11,10 +13,15 @@ class InvokeTimer;
 
 typedef std::shared_ptr<InvokeTimer> InvokeTimerPtr;
 
-class EVPP_EXPORT InvokeTimer : public std::enable_shared_from_this<InvokeTimer> {
+class EVPP_EXPORT InvokeTimer : public std::enable_shared_from_this<InvokeTimer>, private TimingWheel::Node {
 public:
     typedef std::function<void()> Functor;
 
+    enum Mode {
+        kEventTimer = 0, // A libevent timer event
+        kWheelTimer = 1, // A node of the TimingWheel of the EventLoop. See EventLoop::timing_wheel()
+    };
+
     // @brief Create a timer. When the timer is timeout, the functor f will
     //  be invoked automatically.
     // @param evloop - The EventLoop runs this timer
@@ -32,6 +39,11 @@ public:
                                  Duration timeout,
                                  Functor&& f,
                                  bool periodic);
+    static InvokeTimerPtr Create(EventLoop* evloop,
+                                 Duration timeout,
+                                 Task&& f,
+                                 bool periodic,
+                                 Mode mode = kEventTimer);
     ~InvokeTimer();
 
     void SetLogger(logger* log_) { myLog = log_; }
@@ -48,16 +60,21 @@ public:
 private:
     InvokeTimer(EventLoop* evloop, Duration timeout, const Functor& f, bool periodic);
     InvokeTimer(EventLoop* evloop, Duration timeout, Functor&& f, bool periodic);
+    InvokeTimer(EventLoop* evloop, Duration timeout, Task&& f, bool periodic, Mode mode);
     void OnTimerTriggered();
+    void OnWheelTimeout() override;
+    void UpdateDeadline();
     void OnCanceled();
 
 private:
     EventLoop* loop_;
     Duration timeout_;
-    Functor functor_;
+    Task functor_;
     Functor cancel_callback_;
     std::unique_ptr<TimerEventWatcher> timer_;
     bool periodic_;
+    Mode mode_;
+    int64_t deadline_ns_; // The expected trigger time, only recorded when the metrics of loop_ are on
     std::shared_ptr<InvokeTimer> self_; // Hold myself
 
     logger* myLog{nullptr};
@@ -0,0 +1,662 @@
+#include "evpp/inner_pre.h"
+
+#include "evpp/io_uring_engine.h"
+#include "evpp/libevent.h"
+#include "evpp/event_loop.h"
+
+#if defined(H_OS_LINUX) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <vector>
+#include <deque>
+// The provided buffer rings and the multishot receiving are in Linux 6.0
+#if defined(IORING_RECV_MULTISHOT) && defined(__NR_io_uring_setup)
+#define EVPP_HAVE_IO_URING
+#endif
+#endif
+#endif
+
+namespace evpp {
+
+#ifdef EVPP_HAVE_IO_URING
+namespace {
+int IoUringSetup(unsigned entries, struct io_uring_params* p) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int IoUringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int IoUringRegister(int fd, unsigned op, void* arg, unsigned n) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, op, arg, n));
+}
+
+template<typename T>
+T LoadAcquire(const T* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+template<typename T>
+void StoreRelease(T* p, T v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+}
+
+// The memory shared with the kernel
+struct IoUringEngine::Ring {
+    Ring()
+        : fd(-1), ring_ptr(nullptr), ring_size(0), sqes(nullptr), sqes_size(0)
+        , sq_head(nullptr), sq_tail(nullptr), sq_flags(nullptr), sq_mask(0), sq_entries(0)
+        , cq_head(nullptr), cq_tail(nullptr), cqes(nullptr), cq_mask(0)
+        , sqe_head(0), sqe_tail(0)
+        , br(nullptr), br_size(0), br_tail(0), br_published(0), buffers(nullptr) {}
+
+    ~Ring() {
+        delete [] buffers;
+        if (br) {
+            ::munmap(br, br_size);
+        }
+
+        if (sqes) {
+            ::munmap(sqes, sqes_size);
+        }
+
+        if (ring_ptr) {
+            ::munmap(ring_ptr, ring_size);
+        }
+
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    int fd;
+    void* ring_ptr;
+    size_t ring_size;
+    struct io_uring_sqe* sqes;
+    size_t sqes_size;
+
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_flags;
+    unsigned sq_mask;
+    unsigned sq_entries;
+
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    struct io_uring_cqe* cqes;
+    unsigned cq_mask;
+
+    unsigned sqe_head; // The prepared SQEs in [sqe_head, sqe_tail) are not submitted
+    unsigned sqe_tail;
+
+    struct io_uring_buf_ring* br;
+    size_t br_size;
+    uint16_t br_tail;
+    uint16_t br_published;
+    char* buffers;
+
+    std::deque<struct io_uring_sqe> backlog; // The prepared SQEs which the queue has no room for
+};
+
+IoUringEngine::IoUringEngine(EventLoop* l)
+    : loop_(l), event_fd_(-1), completion_event_(nullptr), submit_event_(nullptr), reap_event_(nullptr), attached_(false)
+    , submit_scheduled_(false), reap_scheduled_(false), multishot_recv_(true), multishot_accept_(true), stopping_(false), inflight_(0) {
+}
+
+IoUringEngine::~IoUringEngine() {
+    if (ring_ && inflight_ > 0) {
+        // The kernel may still be reading the send buffers,
+        // so wait for all the requests to complete before unmapping anything.
+        stopping_ = true;
+        struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(PrepareSQE(OperationPtr(), std::shared_ptr<void>()));
+        if (sqe) {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+        }
+        Submit();
+
+        struct pollfd pfd = { event_fd_, POLLIN, 0 };
+        for (int i = 0; i < 100 && inflight_ > 0; i++) {
+            ::poll(&pfd, 1, 10);
+            Reap();
+        }
+
+        if (inflight_ > 0) {
+            _log_err(myLog, "%d io_uring requests are still in flight", int(inflight_));
+        }
+    }
+
+    Detach();
+    delete completion_event_;
+    completion_event_ = nullptr;
+    delete submit_event_;
+    submit_event_ = nullptr;
+    delete reap_event_;
+    reap_event_ = nullptr;
+
+    ring_.reset();
+
+    if (event_fd_ >= 0) {
+        ::close(event_fd_);
+        event_fd_ = -1;
+    }
+}
+
+bool IoUringEngine::Init() {
+    assert(!ring_);
+    std::unique_ptr<Ring> r(new Ring);
+
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    p.flags = IORING_SETUP_CQSIZE;
+    p.cq_entries = kCompletionEntries;
+    r->fd = IoUringSetup(kEntries, &p);
+    if (r->fd < 0) {
+        int serrno = errno;
+        _log_warn(myLog, "io_uring_setup failed, err: %s", strerror(serrno).c_str());
+        return false;
+    }
+
+    if (!(p.features & IORING_FEAT_SINGLE_MMAP) || !(p.features & IORING_FEAT_NODROP)) {
+        _log_warn(myLog, "io_uring features 0x%x are not enough", p.features);
+        return false;
+    }
+
+    size_t sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    size_t cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    r->ring_size = sq_size > cq_size ? sq_size : cq_size;
+    void* m = ::mmap(nullptr, r->ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQ_RING);
+    if (m == MAP_FAILED) {
+        _log_warn(myLog, "mmap the io_uring failed");
+        return false;
+    }
+    r->ring_ptr = m;
+
+    r->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    m = ::mmap(nullptr, r->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQES);
+    if (m == MAP_FAILED) {
+        _log_warn(myLog, "mmap the io_uring SQEs failed");
+        return false;
+    }
+    r->sqes = static_cast<struct io_uring_sqe*>(m);
+
+    char* base = static_cast<char*>(r->ring_ptr);
+    r->sq_head = reinterpret_cast<unsigned*>(base + p.sq_off.head);
+    r->sq_tail = reinterpret_cast<unsigned*>(base + p.sq_off.tail);
+    r->sq_flags = reinterpret_cast<unsigned*>(base + p.sq_off.flags);
+    r->sq_mask = *reinterpret_cast<unsigned*>(base + p.sq_off.ring_mask);
+    r->sq_entries = p.sq_entries;
+    unsigned* sq_array = reinterpret_cast<unsigned*>(base + p.sq_off.array);
+    for (unsigned i = 0; i < p.sq_entries; i++) {
+        sq_array[i] = i;
+    }
+
+    r->cq_head = reinterpret_cast<unsigned*>(base + p.cq_off.head);
+    r->cq_tail = reinterpret_cast<unsigned*>(base + p.cq_off.tail);
+    r->cq_mask = *reinterpret_cast<unsigned*>(base + p.cq_off.ring_mask);
+    r->cqes = reinterpret_cast<struct io_uring_cqe*>(base + p.cq_off.cqes);
+
+    // Check the opcodes
+    const int kProbeOps = 256;
+    std::vector<char> probe_mem(sizeof(struct io_uring_probe) + kProbeOps * sizeof(struct io_uring_probe_op));
+    struct io_uring_probe* probe = reinterpret_cast<struct io_uring_probe*>(&probe_mem[0]);
+    if (IoUringRegister(r->fd, IORING_REGISTER_PROBE, probe, kProbeOps) != 0) {
+        _log_warn(myLog, "IORING_REGISTER_PROBE is not supported");
+        return false;
+    }
+
+    const int ops[] = { IORING_OP_RECV, IORING_OP_SEND, IORING_OP_ACCEPT, IORING_OP_ASYNC_CANCEL };
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        if (ops[i] > probe->last_op || !(probe->ops[ops[i]].flags & IO_URING_OP_SUPPORTED)) {
+            _log_warn(myLog, "io_uring opcode %d is not supported", ops[i]);
+            return false;
+        }
+    }
+
+    // The provided buffer ring
+    r->br_size = kBufferCount * sizeof(struct io_uring_buf);
+    m = ::mmap(nullptr, r->br_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (m == MAP_FAILED) {
+        _log_warn(myLog, "mmap the provided buffer ring failed");
+        return false;
+    }
+    r->br = static_cast<struct io_uring_buf_ring*>(m);
+    r->buffers = new char[size_t(kBufferCount) * kBufferSize];
+
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(r->br);
+    reg.ring_entries = kBufferCount;
+    reg.bgid = 0;
+    if (IoUringRegister(r->fd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0) {
+        int serrno = errno;
+        _log_warn(myLog, "IORING_REGISTER_PBUF_RING failed, err: %s", strerror(serrno).c_str());
+        return false;
+    }
+
+    event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0 || IoUringRegister(r->fd, IORING_REGISTER_EVENTFD, &event_fd_, 1) != 0) {
+        int serrno = errno;
+        _log_warn(myLog, "IORING_REGISTER_EVENTFD failed, err: %s", strerror(serrno).c_str());
+        return false;
+    }
+
+    ring_ = std::move(r);
+    for (int i = 0; i < kBufferCount; i++) {
+        RecycleBuffer(static_cast<uint16_t>(i));
+    }
+    PublishBuffers();
+
+    completion_event_ = new event;
+    memset(completion_event_, 0, sizeof(struct event));
+    ::event_set(completion_event_, event_fd_, EV_READ | EV_PERSIST, &IoUringEngine::HandleCompletion, this);
+    ::event_base_set(loop_->event_base(), completion_event_);
+
+    // It is activated when there are requests prepared, so they are submitted
+    // after the other callbacks of the current loop iteration
+    submit_event_ = new event;
+    memset(submit_event_, 0, sizeof(struct event));
+    ::event_set(submit_event_, -1, 0, &IoUringEngine::HandleSubmit, this);
+    ::event_base_set(loop_->event_base(), submit_event_);
+
+    reap_event_ = new event;
+    memset(reap_event_, 0, sizeof(struct event));
+    ::event_set(reap_event_, -1, 0, &IoUringEngine::HandleReap, this);
+    ::event_base_set(loop_->event_base(), reap_event_);
+    return true;
+}
+
+bool IoUringEngine::Attach() {
+    assert(completion_event_ && !attached_);
+    if (EventAdd(completion_event_, nullptr) != 0) {
+        _log_err(myLog, "io_uring eventfd=%d attach to event loop failed", event_fd_);
+        return false;
+    }
+    attached_ = true;
+    return true;
+}
+
+void IoUringEngine::Detach() {
+    if (attached_) {
+        EventDel(completion_event_);
+        attached_ = false;
+    }
+
+    if (submit_scheduled_) {
+        EventDel(submit_event_);
+        submit_scheduled_ = false;
+    }
+
+    if (reap_scheduled_) {
+        EventDel(reap_event_);
+        reap_scheduled_ = false;
+    }
+}
+
+void* IoUringEngine::PrepareSQE(const OperationPtr& op, const std::shared_ptr<void>& guard) {
+    Ring* r = ring_.get();
+    struct io_uring_sqe* sqe = nullptr;
+    if (r->backlog.empty() && r->sqe_tail - LoadAcquire(r->sq_head) < r->sq_entries) {
+        sqe = &r->sqes[r->sqe_tail & r->sq_mask];
+        ++r->sqe_tail;
+    } else {
+        // The submission queue is full, it is moved into the queue when submitting
+        r->backlog.push_back(io_uring_sqe());
+        sqe = &r->backlog.back();
+    }
+    memset(sqe, 0, sizeof(*sqe));
+
+    if (op) {
+        sqe->user_data = reinterpret_cast<uint64_t>(op.get());
+        if (!op->pending_) {
+            op->pending_ = true;
+            op->self_ = op;
+            op->guard_ = guard;
+            ++inflight_;
+        }
+    }
+
+    ScheduleSubmit();
+    return sqe;
+}
+
+bool IoUringEngine::PrepareRecv(const OperationPtr& op, const std::shared_ptr<void>& guard) {
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(PrepareSQE(op, guard));
+    if (!sqe) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = op->fd_;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    if (op->multishot_) {
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+    } else {
+        sqe->len = kBufferSize;
+    }
+    return true;
+}
+
+bool IoUringEngine::PrepareAccept(const OperationPtr& op, const std::shared_ptr<void>& guard) {
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(PrepareSQE(op, guard));
+    if (!sqe) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = op->fd_;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    if (op->multishot_) {
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    }
+    return true;
+}
+
+bool IoUringEngine::Recv(const OperationPtr& op, int fd, const std::shared_ptr<void>& guard) {
+    assert(loop_->IsInLoopThread());
+    assert(!op->pending_);
+    op->opcode_ = IORING_OP_RECV;
+    op->fd_ = fd;
+    op->multishot_ = multishot_recv_;
+    return PrepareRecv(op, guard);
+}
+
+bool IoUringEngine::Accept(const OperationPtr& op, int fd, const std::shared_ptr<void>& guard) {
+    assert(loop_->IsInLoopThread());
+    assert(!op->pending_);
+    op->opcode_ = IORING_OP_ACCEPT;
+    op->fd_ = fd;
+    op->multishot_ = multishot_accept_;
+    return PrepareAccept(op, guard);
+}
+
+bool IoUringEngine::Send(const OperationPtr& op, int fd, const void* data, size_t len, const std::shared_ptr<void>& guard) {
+    assert(loop_->IsInLoopThread());
+    assert(!op->pending_);
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(PrepareSQE(op, guard));
+    if (!sqe) {
+        return false;
+    }
+
+    op->opcode_ = IORING_OP_SEND;
+    op->fd_ = fd;
+    op->multishot_ = false;
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(data);
+    sqe->len = static_cast<uint32_t>(len);
+    sqe->msg_flags = MSG_NOSIGNAL;
+    return true;
+}
+
+void IoUringEngine::Cancel(const OperationPtr& op) {
+    assert(loop_->IsInLoopThread());
+    if (!op->pending_) {
+        return;
+    }
+
+    // The completion of the cancel request itself is ignored
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(PrepareSQE(OperationPtr(), std::shared_ptr<void>()));
+    if (sqe) {
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = reinterpret_cast<uint64_t>(op.get());
+    }
+}
+
+void IoUringEngine::ScheduleSubmit() {
+    if (submit_scheduled_ || stopping_) {
+        return;
+    }
+
+    // Adding it without a fd or a timeout only registers it, so it is
+    // owned by the loop thread like the other events, see Detach
+    submit_scheduled_ = true;
+    EventAdd(submit_event_, nullptr);
+    event_active(submit_event_, 0, 0);
+}
+
+void IoUringEngine::ScheduleReap() {
+    if (reap_scheduled_ || stopping_) {
+        return;
+    }
+
+    // Not event_active, which runs the callback again in the current loop iteration,
+    // and the other events of the loop are starved if the queue keeps overflowing.
+    // A zero timeout makes it run in the next loop iteration.
+    struct timeval tv = { 0, 0 };
+    reap_scheduled_ = true;
+    EventAdd(reap_event_, &tv);
+}
+
+void IoUringEngine::HandleReap(evpp_socket_t fd, short which, void* v) {
+    IoUringEngine* e = (IoUringEngine*)v;
+    // It has fired and is no longer pending, so this only balances the EventAdd
+    EventDel(e->reap_event_);
+    e->reap_scheduled_ = false;
+    e->Reap();
+}
+
+void IoUringEngine::HandleSubmit(evpp_socket_t fd, short which, void* v) {
+    IoUringEngine* e = (IoUringEngine*)v;
+    EventDel(e->submit_event_);
+    e->submit_scheduled_ = false;
+    e->Submit();
+}
+
+void IoUringEngine::Submit() {
+    Ring* r = ring_.get();
+
+    // The receiving requests re-armed in the handlers must see
+    // the buffers recycled before them, otherwise they fail with -ENOBUFS
+    PublishBuffers();
+
+    for (;;) {
+        while (!r->backlog.empty() && r->sqe_tail - LoadAcquire(r->sq_head) < r->sq_entries) {
+            r->sqes[r->sqe_tail & r->sq_mask] = r->backlog.front();
+            r->backlog.pop_front();
+            ++r->sqe_tail;
+        }
+
+        unsigned n = r->sqe_tail - r->sqe_head;
+        if (n == 0) {
+            return;
+        }
+
+        StoreRelease(r->sq_tail, r->sqe_tail);
+        int rc = IoUringEnter(r->fd, n, 0, 0);
+        if (rc < 0) {
+            int serrno = errno;
+            if (serrno == EBUSY || serrno == EAGAIN || serrno == EINTR) {
+                // The completion queue is overflowed. Reap it in the next loop iteration,
+                // and the requests are submitted again after that.
+                ScheduleReap();
+            } else {
+                _log_err(myLog, "io_uring_enter submit %d failed, err: %s", int(n), strerror(serrno).c_str());
+            }
+            return;
+        }
+
+        r->sqe_head += static_cast<unsigned>(rc);
+        if (r->backlog.empty()) {
+            break;
+        }
+    }
+
+    if (!Reaped()) {
+        ScheduleReap();
+    }
+}
+
+bool IoUringEngine::Reaped() const {
+    // The eventfd is not signaled for the overflowed completions,
+    // either when they are waiting or when they are flushed into the queue
+    // by io_uring_enter. So check the queue here.
+    const Ring* r = ring_.get();
+    return *r->cq_head == LoadAcquire(r->cq_tail) && !(LoadAcquire(r->sq_flags) & IORING_SQ_CQ_OVERFLOW);
+}
+
+void IoUringEngine::HandleCompletion(evpp_socket_t fd, short which, void* v) {
+    IoUringEngine* e = (IoUringEngine*)v;
+    uint64_t count = 0;
+    if (::read(fd, &count, sizeof(count)) < 0) {
+        // Nothing to do, the completions are reaped anyway
+    }
+    e->Reap();
+}
+
+void IoUringEngine::Reap() {
+    Ring* r = ring_.get();
+    if (LoadAcquire(r->sq_flags) & IORING_SQ_CQ_OVERFLOW) {
+        // Flush the overflowed completions into the queue
+        IoUringEnter(r->fd, 0, 0, IORING_ENTER_GETEVENTS);
+    }
+
+    // Only reap the completions posted so far, the later ones are reaped
+    // in the next loop iteration, otherwise the busy connections would
+    // starve the other events of the loop.
+    unsigned head = *r->cq_head;
+    unsigned tail = LoadAcquire(r->cq_tail);
+    if (head != tail) {
+        loop_->NoteActivity();
+    }
+    for (; head != tail; ++head) {
+        const struct io_uring_cqe* cqe = &r->cqes[head & r->cq_mask];
+        uint64_t user_data = cqe->user_data;
+        int res = cqe->res;
+        uint32_t flags = cqe->flags;
+        StoreRelease(r->cq_head, head + 1);
+        if (user_data) {
+            Complete(reinterpret_cast<Operation*>(user_data), res, flags);
+        }
+    }
+
+    PublishBuffers();
+
+    if (!Reaped()) {
+        ScheduleReap();
+    }
+
+    // Some requests may have failed to be submitted because of the overflow
+    if (r->sqe_tail != r->sqe_head || !r->backlog.empty()) {
+        ScheduleSubmit();
+    }
+}
+
+void IoUringEngine::Complete(Operation* op, int res, uint32_t flags) {
+    bool more = (flags & IORING_CQE_F_MORE) != 0;
+    const char* data = nullptr;
+    int bid = -1;
+    if (flags & IORING_CQE_F_BUFFER) {
+        bid = static_cast<int>(flags >> IORING_CQE_BUFFER_SHIFT);
+        data = ring_->buffers + size_t(bid) * kBufferSize;
+    }
+
+    if (res == -EINVAL && op->multishot_ && !more && !stopping_) {
+        // The kernel doesn't support the multishot one, use the single shot one from now on
+        op->multishot_ = false;
+        if (op->opcode_ == IORING_OP_RECV) {
+            _log_warn(myLog, "The multishot receiving is not supported");
+            multishot_recv_ = false;
+            if (PrepareRecv(op->self_, op->guard_)) {
+                return;
+            }
+        } else if (op->opcode_ == IORING_OP_ACCEPT) {
+            _log_warn(myLog, "The multishot accepting is not supported");
+            multishot_accept_ = false;
+            if (PrepareAccept(op->self_, op->guard_)) {
+                return;
+            }
+        }
+    }
+
+    // The handler may prepare the same op again, or release its owner
+    std::shared_ptr<Operation> self;
+    std::shared_ptr<void> guard;
+    if (!more) {
+        self.swap(op->self_);
+        guard.swap(op->guard_);
+        op->pending_ = false;
+        assert(inflight_ > 0);
+        --inflight_;
+    }
+
+    if (op->handler && !stopping_) {
+        op->handler(res, data, more);
+    }
+
+    if (bid >= 0) {
+        RecycleBuffer(static_cast<uint16_t>(bid));
+    }
+}
+
+void IoUringEngine::PublishBuffers() {
+    // Publish the recycled buffers at once
+    Ring* r = ring_.get();
+    if (r->br_published != r->br_tail) {
+        StoreRelease(&r->br->tail, r->br_tail);
+        r->br_published = r->br_tail;
+    }
+}
+
+void IoUringEngine::RecycleBuffer(uint16_t bid) {
+    Ring* r = ring_.get();
+    // Don't use io_uring_buf_ring::bufs, the empty struct before it
+    // in __DECLARE_FLEX_ARRAY takes one byte in C++ and shifts the array
+    struct io_uring_buf* b = reinterpret_cast<struct io_uring_buf*>(r->br) + (r->br_tail & (kBufferCount - 1));
+    b->addr = reinterpret_cast<uint64_t>(r->buffers + size_t(bid) * kBufferSize);
+    b->len = kBufferSize;
+    b->bid = bid;
+    ++r->br_tail;
+}
+#else
+struct IoUringEngine::Ring {
+};
+
+IoUringEngine::IoUringEngine(EventLoop* l)
+    : loop_(l), event_fd_(-1), completion_event_(nullptr), submit_event_(nullptr), reap_event_(nullptr), attached_(false)
+    , submit_scheduled_(false), reap_scheduled_(false), multishot_recv_(false), multishot_accept_(false), stopping_(false), inflight_(0) {
+}
+
+IoUringEngine::~IoUringEngine() {
+}
+
+bool IoUringEngine::Init() {
+    return false;
+}
+
+bool IoUringEngine::Attach() {
+    return false;
+}
+
+void IoUringEngine::Detach() {
+}
+
+bool IoUringEngine::Recv(const OperationPtr&, int, const std::shared_ptr<void>&) {
+    return false;
+}
+
+bool IoUringEngine::Send(const OperationPtr&, int, const void*, size_t, const std::shared_ptr<void>&) {
+    return false;
+}
+
+bool IoUringEngine::Accept(const OperationPtr&, int, const std::shared_ptr<void>&) {
+    return false;
+}
+
+void IoUringEngine::Cancel(const OperationPtr&) {
+}
+
+void IoUringEngine::Submit() {
+}
+#endif
+
+}
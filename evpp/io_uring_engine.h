@@ -0,0 +1,135 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+
+#include "evpp/inner_pre.h"
+#include "evpp/evlog.h"
+
+struct event;
+
+namespace evpp {
+
+class EventLoop;
+
+// An io_uring(7) engine of one EventLoop. See EventLoop::kIoUring.
+//
+// It does the socket I/O of the TCPConns and the Listener of the loop :
+//   - multishot receiving into a ring of provided buffers, so an idle
+//     connection doesn't hold any buffer and a busy one needs no syscall to re-arm
+//   - sending, the data of the sends in one loop iteration are submitted together
+//   - multishot accepting
+//
+// The prepared requests are submitted by one io_uring_enter in the same loop
+// iteration. The completions are signaled by an eventfd which is watched by
+// libevent, so the timers and the watchers of the loop are still driven by libevent.
+//
+// The io_uring is set up by the raw syscalls. Init returns false if the kernel
+// lacks any of the features above, and the loop falls back to libevent.
+//
+// @note All the methods MUST be called in the loop thread.
+class EVPP_EXPORT IoUringEngine {
+public:
+    enum {
+        kEntries = 256,             // The size of the submission queue
+        kCompletionEntries = 4096,  // The size of the completion queue
+        kBufferCount = 128,         // The count of the provided buffers, a power of 2
+        kBufferSize = 16384,        // The size of one provided buffer
+    };
+
+    // An asynchronous request and its completion handler.
+    // A multishot request completes many times, more is false at the last time.
+    class EVPP_EXPORT Operation {
+    public:
+        // @param res - The result of the request, or -errno
+        // @param data - The received data of a receiving request, or nullptr.
+        //  It is only valid in the handler.
+        typedef std::function<void(int res, const char* data, bool more)> Handler;
+
+        Operation() : pending_(false), multishot_(false), opcode_(0), fd_(-1) {}
+
+        // @brief Return true if the request is in flight
+        bool pending() const {
+            return pending_;
+        }
+
+        Handler handler;
+    private:
+        friend class IoUringEngine;
+        bool pending_;
+        std::shared_ptr<Operation> self_; // Keeps this alive while it is in flight
+        std::shared_ptr<void> guard_;     // Keeps the owner alive while it is in flight
+        bool multishot_;
+        int opcode_;
+        int fd_;
+    };
+    typedef std::shared_ptr<Operation> OperationPtr;
+
+    explicit IoUringEngine(EventLoop* loop);
+    ~IoUringEngine();
+
+    void SetLogger(logger* log_) { myLog = log_; }
+
+    // @brief Set up the io_uring
+    // @return false if io_uring or any of the features needed is not available
+    bool Init();
+
+    // @brief Watch the eventfd of the io_uring in the event_base of the loop,
+    //  or stop watching it and drop the scheduled submission and reaping.
+    //  EventLoop::Run calls them at its start and end, in the loop thread.
+    bool Attach();
+    void Detach();
+
+    // @brief Prepare the requests. They are submitted later in this loop iteration.
+    //  The op and the guard are held until the last completion of the request.
+    // @param guard - The owner of the memory used by the request, e.g. the send buffer.
+    // @return false if the request can't be prepared
+    bool Recv(const OperationPtr& op, int fd, const std::shared_ptr<void>& guard);
+    bool Send(const OperationPtr& op, int fd, const void* data, size_t len, const std::shared_ptr<void>& guard);
+    bool Accept(const OperationPtr& op, int fd, const std::shared_ptr<void>& guard);
+
+    // @brief Cancel an in-flight request. It completes with -ECANCELED, unless it has completed.
+    void Cancel(const OperationPtr& op);
+
+    // @brief Submit the prepared requests now
+    void Submit();
+
+    // @brief The count of the in-flight requests
+    size_t inflight() const {
+        return inflight_;
+    }
+
+private:
+    struct Ring;
+    void* PrepareSQE(const OperationPtr& op, const std::shared_ptr<void>& guard);
+    bool PrepareRecv(const OperationPtr& op, const std::shared_ptr<void>& guard);
+    bool PrepareAccept(const OperationPtr& op, const std::shared_ptr<void>& guard);
+    void ScheduleSubmit();
+    void ScheduleReap();
+    bool Reaped() const;
+    void Reap();
+    void Complete(Operation* op, int res, uint32_t flags);
+    void RecycleBuffer(uint16_t bid);
+    void PublishBuffers();
+    static void HandleSubmit(evpp_socket_t fd, short which, void* v);
+    static void HandleCompletion(evpp_socket_t fd, short which, void* v);
+    static void HandleReap(evpp_socket_t fd, short which, void* v);
+
+private:
+    EventLoop* loop_;
+    std::unique_ptr<Ring> ring_;
+    int event_fd_;
+    struct event* completion_event_;
+    struct event* submit_event_;
+    struct event* reap_event_;
+    bool attached_;
+    bool submit_scheduled_;
+    bool reap_scheduled_;
+    bool multishot_recv_;
+    bool multishot_accept_;
+    bool stopping_;
+    size_t inflight_;
+    logger* myLog{nullptr};
+};
+
+}
@@ -6,6 +6,10 @@
 #include "evpp/libevent.h"
 #include "evpp/sockets.h"
 
+#ifndef H_OS_WINDOWS
+#include <fcntl.h>
+#endif
+
 namespace evpp {
 Listener::Listener(EventLoop* l, const std::string& addr)
     : loop_(l), addr_(addr) {
@@ -15,6 +19,13 @@ Listener::~Listener() {
     chan_.reset();
     EVUTIL_CLOSESOCKET(fd_);
     fd_ = INVALID_SOCKET;
+
+#ifndef H_OS_WINDOWS
+    if (reserved_fd_ >= 0) {
+        ::close(reserved_fd_);
+        reserved_fd_ = -1;
+    }
+#endif
 }
 
 void Listener::Listen(int backlog) {
@@ -38,54 +49,191 @@ void Listener::Listen(int backlog) {
         int serrno = errno;
         _log_err(myLog, "Listen failed, err: %s", strerror(serrno).c_str());
     }
+
+#ifndef H_OS_WINDOWS
+    reserved_fd_ = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+#endif
 }
 
 void Listener::Accept() {
     // DLOG_TRACE;
+    if (loop_->io_uring()) {
+        loop_->RunInLoop(std::bind(&Listener::AcceptByIoUring, this));
+        _log_info(myLog, "TCPServer is running at %s", addr_.c_str());
+        return;
+    }
+
     chan_.reset(new FdChannel(loop_, fd_, true, false));
     chan_->SetReadCallback(std::bind(&Listener::HandleAccept, this));
     loop_->RunInLoop(std::bind(&FdChannel::AttachToLoop, chan_.get()));
     _log_info(myLog, "TCPServer is running at %s", addr_.c_str());
 }
 
+// The pending connections are accepted until none is left or accept_budget_
+// of them are accepted. The listening fd is level triggered, so the rest
+// are reported again in the next loop iteration.
 void Listener::HandleAccept() {
     _log_info(myLog, "A new connection is comming in");
     assert(loop_->IsInLoopThread());
-    struct sockaddr_storage ss;
-    socklen_t addrlen = sizeof(ss);
-    int nfd = -1;
-    if ((nfd = ::accept(fd_, sock::sockaddr_cast(&ss), &addrlen)) == -1) {
-        int serrno = errno;
-        if (serrno != EAGAIN && serrno != EINTR) {
-            _log_warn(myLog, "bad accept %s", strerror(serrno).c_str());
+    for (int i = 0; i < accept_budget_; i++) {
+        struct sockaddr_storage ss;
+        int serrno = 0;
+        evpp_socket_t nfd = AcceptOne(&ss, &serrno);
+        if (nfd == INVALID_SOCKET) {
+            if (serrno == EINTR || serrno == ECONNABORTED) {
+                continue;
+            }
+
+            if ((serrno == EMFILE || serrno == ENFILE) && HandleFdExhausted()) {
+                continue;
+            }
+
+            if (serrno != EAGAIN && serrno != EWOULDBLOCK) {
+                _log_warn(myLog, "bad accept %s", strerror(serrno).c_str());
+            }
+            break;
         }
-        return;
+
+        if (new_conns_fn_) {
+            AcceptedConn c;
+            if (PrepareNewConn(nfd, ss, &c)) {
+                accepted_.push_back(std::move(c));
+            }
+        } else {
+            HandleNewConn(nfd, ss);
+        }
+    }
+
+    if (!accepted_.empty()) {
+        new_conns_fn_(accepted_);
+        accepted_.clear();
     }
+}
 
-    if (evutil_make_socket_nonblocking(nfd) < 0) {
+// Accept a connection whose fd is nonblocking and close-on-exec
+evpp_socket_t Listener::AcceptOne(struct sockaddr_storage* ss, int* saved_errno) {
+    socklen_t addrlen = sizeof(*ss);
+#ifdef H_OS_LINUX
+    evpp_socket_t nfd = ::accept4(fd_, sock::sockaddr_cast(ss), &addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (nfd < 0) {
+        *saved_errno = errno;
+        return INVALID_SOCKET;
+    }
+#else
+    evpp_socket_t nfd = ::accept(fd_, sock::sockaddr_cast(ss), &addrlen);
+    if (nfd == INVALID_SOCKET) {
+        *saved_errno = errno;
+        return INVALID_SOCKET;
+    }
+
+    if (evutil_make_socket_nonblocking(nfd) < 0 || evutil_make_socket_closeonexec(nfd) < 0) {
+        *saved_errno = errno;
         _log_err(myLog, "set fd=%d nonblocking failed.", nfd);
         EVUTIL_CLOSESOCKET(nfd);
-        return;
+        return INVALID_SOCKET;
+    }
+#endif
+    return nfd;
+}
+
+// The process runs out of fds. Accept the pending connection by the
+// reserved fd and close it at once, which tells the peer we are busy.
+// @return true if one connection is dropped
+bool Listener::HandleFdExhausted() {
+#ifndef H_OS_WINDOWS
+    if (reserved_fd_ < 0) {
+        return false;
     }
 
+    ::close(reserved_fd_);
+    int nfd = ::accept(fd_, nullptr, nullptr);
+    if (nfd >= 0) {
+        ::close(nfd);
+        _log_warn(myLog, "Too many open files, a connection is dropped, listen fd=%d", fd_);
+    }
+    reserved_fd_ = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    return nfd >= 0;
+#else
+    return false;
+#endif
+}
+
+bool Listener::PrepareNewConn(int nfd, struct sockaddr_storage& ss, AcceptedConn* c) {
     sock::SetKeepAlive(nfd, true);
 
     std::string raddr = sock::ToIPPort(&ss);
     if (raddr.empty()) {
         _log_err(myLog, "sock::ToIPPort(&ss) failed.");
         EVUTIL_CLOSESOCKET(nfd);
-        return;
+        return false;
     }
 
     _log_trace(myLog, "accepted a connection from %s , listen fd=%d , client fd=%d", raddr.c_str(), fd_, nfd);
+    c->fd = nfd;
+    c->remote_addr.swap(raddr);
+    c->ss = ss;
+    return true;
+}
+
+void Listener::HandleNewConn(int nfd, struct sockaddr_storage& ss) {
+    AcceptedConn c;
+    if (!PrepareNewConn(nfd, ss, &c)) {
+        return;
+    }
+
+    if (new_conns_fn_) {
+        accepted_.push_back(std::move(c));
+        new_conns_fn_(accepted_);
+        accepted_.clear();
+    } else if (new_conn_fn_) {
+        new_conn_fn_(c.fd, c.remote_addr, sock::sockaddr_in_cast(&c.ss));
+    }
+}
 
-    if (new_conn_fn_) {
-        new_conn_fn_(nfd, raddr, sock::sockaddr_in_cast(&ss));
+void Listener::AcceptByIoUring() {
+    assert(loop_->IsInLoopThread());
+    accept_op_ = std::make_shared<IoUringEngine::Operation>();
+    accept_op_->handler = [this](int res, const char*, bool more) {
+        HandleIoUringAccept(res, more);
+    };
+    loop_->io_uring()->Accept(accept_op_, fd_, std::shared_ptr<void>());
+}
+
+void Listener::HandleIoUringAccept(int res, bool more) {
+    assert(loop_->IsInLoopThread());
+    if (res >= 0) {
+        struct sockaddr_storage ss;
+        socklen_t addrlen = sizeof(ss);
+        memset(&ss, 0, sizeof(ss));
+        if (::getpeername(res, sock::sockaddr_cast(&ss), &addrlen) != 0) {
+            int serrno = errno;
+            _log_warn(myLog, "getpeername of fd=%d failed %s", res, strerror(serrno).c_str());
+            EVUTIL_CLOSESOCKET(res);
+        } else {
+            HandleNewConn(res, ss);
+        }
+    } else if (res == -ECANCELED) {
+        return;
+    } else if (res != -EAGAIN && res != -EINTR) {
+        _log_warn(myLog, "bad accept %s", strerror(-res).c_str());
+    }
+
+    // A multishot request may be finished by the kernel, e.g. because of an error
+    if (!more && accept_op_ && !accept_op_->pending()) {
+        loop_->io_uring()->Accept(accept_op_, fd_, std::shared_ptr<void>());
     }
 }
 
 void Listener::Stop() {
     assert(loop_->IsInLoopThread());
+    if (accept_op_) {
+        // The op is held by the engine until its last completion, which is ignored
+        accept_op_->handler = IoUringEngine::Operation::Handler();
+        loop_->io_uring()->Cancel(accept_op_);
+        accept_op_.reset();
+        return;
+    }
+
     chan_->DisableAllEvent();
     chan_->Close();
 }
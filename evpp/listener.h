@@ -3,6 +3,9 @@
 #include "evpp/inner_pre.h"
 #include "evpp/timestamp.h"
 #include "evpp/evlog.h"
+#include "evpp/io_uring_engine.h"
+
+#include <vector>
 
 namespace evpp {
 class EventLoop;
@@ -15,6 +18,21 @@ public:
          const std::string& /*remote address with format "ip:port"*/,
          const struct sockaddr_in* /*remote address*/) >
     NewConnectionCallback;
+
+    // A connection accepted, whose fd is nonblocking
+    struct AcceptedConn {
+        evpp_socket_t fd;
+        std::string remote_addr; // ip:port
+        struct sockaddr_storage ss;
+    };
+
+    // The connections accepted by one wakeup. The callee takes over the fds.
+    typedef std::function<void(std::vector<AcceptedConn>& conns)> NewConnectionsCallback;
+
+    enum {
+        kDefaultAcceptBudget = 64,
+    };
+
     Listener(EventLoop* loop, const std::string& addr/*local listening address : ip:port*/);
     ~Listener();
 
@@ -31,15 +49,55 @@ public:
         new_conn_fn_ = cb;
     }
 
+    // @brief Hand over all the connections accepted by one wakeup at once,
+    //  instead of one by one by NewConnectionCallback, e.g. to dispatch them
+    //  to the working loops by one task per loop. It takes precedence
+    //  over NewConnectionCallback.
+    // @note The io_uring backend accepts the connections one by one,
+    //  and calls it with one connection at a time.
+    void SetNewConnectionsCallback(NewConnectionsCallback cb) {
+        new_conns_fn_ = cb;
+    }
+
+    // @brief The most connections accepted by one wakeup, so a storm of them
+    //  doesn't starve the other events of the loop. The rest are accepted
+    //  in the next loop iteration. It is kDefaultAcceptBudget by default.
+    void SetAcceptBudget(int n) {
+        assert(n > 0);
+        accept_budget_ = n;
+    }
+
+    // The listening socket fd
+    evpp_socket_t fd() const {
+        return fd_;
+    }
+
 private:
     void HandleAccept();
+    evpp_socket_t AcceptOne(struct sockaddr_storage* ss, int* saved_errno);
+    bool HandleFdExhausted();
+    bool PrepareNewConn(int nfd, struct sockaddr_storage& ss, AcceptedConn* c);
+    void HandleNewConn(int nfd, struct sockaddr_storage& ss);
+
+    // The multishot accepting of the io_uring backend, see EventLoop::kIoUring
+    void AcceptByIoUring();
+    void HandleIoUringAccept(int res, bool more);
 
 private:
     evpp_socket_t fd_ = -1;// The listening socket fd
     EventLoop* loop_;
     std::string addr_;
     std::unique_ptr<FdChannel> chan_;
+    IoUringEngine::OperationPtr accept_op_;
     NewConnectionCallback new_conn_fn_;
+    NewConnectionsCallback new_conns_fn_;
+    int accept_budget_ = kDefaultAcceptBudget;
+
+    // An fd kept open to be closed when the fds run out (EMFILE), so the pending
+    // connection can be accepted and closed. Otherwise it stays pending and
+    // the level triggered listening fd is reported again and again.
+    int reserved_fd_ = -1;
+    std::vector<AcceptedConn> accepted_;
 
     logger* myLog{nullptr};
 };
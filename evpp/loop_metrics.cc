@@ -0,0 +1,123 @@
+#include "evpp/inner_pre.h"
+
+#include <chrono>
+#include <sstream>
+
+#include "evpp/loop_metrics.h"
+
+namespace evpp {
+
+HistogramSnapshot::HistogramSnapshot()
+    : count(0), sum(0), max(0) {
+    memset(buckets, 0, sizeof(buckets));
+}
+
+void HistogramSnapshot::Merge(const HistogramSnapshot& rhs) {
+    count += rhs.count;
+    sum += rhs.sum;
+    if (rhs.max > max) {
+        max = rhs.max;
+    }
+
+    for (size_t i = 0; i < kBuckets; i++) {
+        buckets[i] += rhs.buckets[i];
+    }
+}
+
+uint64_t HistogramSnapshot::Percentile(double p) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    uint64_t threshold = static_cast<uint64_t>(double(count) * p / 100.0);
+    if (threshold == 0) {
+        threshold = 1;
+    }
+
+    uint64_t n = 0;
+    for (size_t i = 0; i < kBuckets; i++) {
+        n += buckets[i];
+        if (n >= threshold) {
+            uint64_t upper = (i + 1 == kBuckets) ? max : (2ULL << i) - 1;
+            return upper < max ? upper : max;
+        }
+    }
+
+    return max;
+}
+
+std::string HistogramSnapshot::ToString() const {
+    std::stringstream ss;
+    ss << "count=" << count
+       << " avg=" << static_cast<uint64_t>(Average())
+       << " p50=" << Percentile(50)
+       << " p99=" << Percentile(99)
+       << " p999=" << Percentile(99.9)
+       << " max=" << max;
+    return ss.str();
+}
+
+Histogram::Histogram()
+    : count_(0), sum_(0), max_(0) {
+    for (size_t i = 0; i < kBuckets; i++) {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t Histogram::BucketIndex(uint64_t v) {
+    size_t i = 0;
+    while (v > 1 && i + 1 < kBuckets) {
+        v >>= 1;
+        ++i;
+    }
+    return i;
+}
+
+HistogramSnapshot Histogram::Snapshot() const {
+    HistogramSnapshot s;
+    s.count = count_.load(std::memory_order_relaxed);
+    s.sum = sum_.load(std::memory_order_relaxed);
+    s.max = max_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kBuckets; i++) {
+        s.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+void LoopMetricsSnapshot::Merge(const LoopMetricsSnapshot& rhs) {
+    queue_latency.Merge(rhs.queue_latency);
+    pending_batch.Merge(rhs.pending_batch);
+    pending_depth.Merge(rhs.pending_depth);
+    fd_read.Merge(rhs.fd_read);
+    fd_write.Merge(rhs.fd_write);
+    timer_lateness.Merge(rhs.timer_lateness);
+}
+
+std::string LoopMetricsSnapshot::ToString() const {
+    std::stringstream ss;
+    ss << "queue_latency(ns): " << queue_latency.ToString() << "\n"
+       << "pending_batch(ns): " << pending_batch.ToString() << "\n"
+       << "pending_depth: " << pending_depth.ToString() << "\n"
+       << "fd_read(ns): " << fd_read.ToString() << "\n"
+       << "fd_write(ns): " << fd_write.ToString() << "\n"
+       << "timer_lateness(ns): " << timer_lateness.ToString() << "\n";
+    return ss.str();
+}
+
+int64_t LoopMetrics::Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+LoopMetricsSnapshot LoopMetrics::Snapshot() const {
+    LoopMetricsSnapshot s;
+    s.queue_latency = queue_latency.Snapshot();
+    s.pending_batch = pending_batch.Snapshot();
+    s.pending_depth = pending_depth.Snapshot();
+    s.fd_read = fd_read.Snapshot();
+    s.fd_write = fd_write.Snapshot();
+    s.timer_lateness = timer_lateness.Snapshot();
+    return s;
+}
+
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+
+#include "evpp/inner_pre.h"
+
+namespace evpp {
+
+// A snapshot of a Histogram. It can be merged with the snapshots of the other loops.
+struct EVPP_EXPORT HistogramSnapshot {
+    enum { kBuckets = 40, };
+
+    HistogramSnapshot();
+
+    // @brief Merge another snapshot into this one
+    void Merge(const HistogramSnapshot& rhs);
+
+    // @brief The approximate value of the percentile p (0.0 ~ 100.0).
+    //  It returns the upper bound of the bucket where the percentile falls in.
+    uint64_t Percentile(double p) const;
+
+    double Average() const {
+        return count == 0 ? 0.0 : double(sum) / double(count);
+    }
+
+    std::string ToString() const;
+
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+    uint64_t buckets[kBuckets];
+};
+
+// A log2 bucketed histogram : the bucket i counts the values in [2^i, 2^(i+1)),
+// and the bucket 0 counts 0 and 1. The last bucket holds all the larger values.
+//
+// It has only one writer, the thread of the EventLoop it belongs to, so Record
+// uses relaxed loads and stores instead of read-modify-write operations.
+// Snapshot can be called from any thread.
+class EVPP_EXPORT Histogram {
+public:
+    enum { kBuckets = HistogramSnapshot::kBuckets, };
+
+    Histogram();
+
+    // @note It MUST be called by the only writer thread
+    void Record(uint64_t v) {
+        Add(buckets_[BucketIndex(v)], 1);
+        Add(count_, 1);
+        Add(sum_, v);
+        if (v > max_.load(std::memory_order_relaxed)) {
+            max_.store(v, std::memory_order_relaxed);
+        }
+    }
+
+    HistogramSnapshot Snapshot() const;
+
+    static size_t BucketIndex(uint64_t v);
+private:
+    static void Add(std::atomic<uint64_t>& c, uint64_t v) {
+        c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+    std::atomic<uint64_t> buckets_[kBuckets];
+};
+
+// A snapshot of LoopMetrics. The durations are in nanoseconds.
+struct EVPP_EXPORT LoopMetricsSnapshot {
+    // @brief Merge another snapshot into this one. It is used to aggregate the loops of a pool.
+    void Merge(const LoopMetricsSnapshot& rhs);
+
+    std::string ToString() const;
+
+    HistogramSnapshot queue_latency;   // From QueueInLoop to the execution of a functor
+    HistogramSnapshot pending_batch;   // The time of one DoPendingFunctors batch
+    HistogramSnapshot pending_depth;   // The count of the pending functors when a batch starts
+    HistogramSnapshot fd_read;         // The time of FdChannel read callbacks
+    HistogramSnapshot fd_write;        // The time of FdChannel write callbacks
+    HistogramSnapshot timer_lateness;  // How late the timers are triggered
+};
+
+// The runtime metrics of one EventLoop, which are recorded only in its thread.
+// See EventLoop::EnableMetrics.
+class EVPP_EXPORT LoopMetrics {
+public:
+    // The monotonic clock used by the metrics, in nanoseconds
+    static int64_t Now();
+
+    LoopMetricsSnapshot Snapshot() const;
+
+    static void RecordElapsed(Histogram& h, int64_t start) {
+        int64_t d = Now() - start;
+        h.Record(d > 0 ? static_cast<uint64_t>(d) : 0);
+    }
+
+private:
+    // The padding keeps the counters of different loops on different cache lines
+    char pad0_[64];
+public:
+    Histogram queue_latency;
+    Histogram pending_batch;
+    Histogram pending_depth;
+    Histogram fd_read;
+    Histogram fd_write;
+    Histogram timer_lateness;
+private:
+    char pad1_[64];
+};
+
+// The statistics of the busy polling of an EventLoop, see EventLoop::SetBusyPoll
+struct BusyPollStats {
+    uint64_t spin_ns = 0;        // The time spent spinning, i.e. the CPU it costs
+    uint64_t idle_spin_ns = 0;   // The part of spin_ns which found nothing before the loop blocked
+    uint64_t hits = 0;           // The work found by spinning after it had been idle, each saved a wakeup
+    uint64_t blocks = 0;         // The times the loop gave up spinning and blocked
+    uint64_t wakeup_samples = 0; // The wakeups from blocking which are measured, see wakeup_ns
+    uint64_t wakeup_ns = 0;      // The sum of the latencies from queuing a task to running it, when the loop was blocked
+    int64_t spin_limit_ns = 0;   // The current spin limit, the largest one of the loops of a pool
+
+    // The mean latency of a wakeup from blocking
+    double avg_wakeup_ns() const {
+        return wakeup_samples == 0 ? 0.0 : double(wakeup_ns) / double(wakeup_samples);
+    }
+
+    // The latency saved, estimated as one wakeup from blocking for every hit
+    double saved_ns() const {
+        return double(hits) * avg_wakeup_ns();
+    }
+};
+
+}
@@ -0,0 +1,184 @@
+#include "evpp/inner_pre.h"
+#include "evpp/memsearch.h"
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EVPP_MEMSEARCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// The AVX2 kernel is compiled by the target attribute, so the library itself
+// still runs on the CPUs without AVX2
+#if defined(EVPP_MEMSEARCH_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EVPP_MEMSEARCH_AVX2 1
+#include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace evpp {
+namespace memsearch {
+
+namespace {
+
+inline int LowestBit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward(&i, mask);
+    return static_cast<int>(i);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// The candidates in mask are where the first and the last byte of delim match
+inline const char* Verify(const char* p, uint32_t mask, const char* delim, size_t n) {
+    while (mask) {
+        const char* c = p + LowestBit(mask);
+        if (n <= 2 || memcmp(c + 1, delim + 1, n - 2) == 0) {
+            return c;
+        }
+        mask &= mask - 1;
+    }
+    return nullptr;
+}
+
+const char* FindScalar(const char* begin, const char* end, const char* delim, size_t n) {
+    if (n == 0) {
+        return begin;
+    }
+
+    const char* p = begin;
+    while (static_cast<size_t>(end - p) >= n) {
+        // memchr is vectorized by the libc
+        const char* c = static_cast<const char*>(memchr(p, delim[0], end - p - n + 1));
+        if (c == nullptr) {
+            return nullptr;
+        }
+
+        if (memcmp(c + 1, delim + 1, n - 1) == 0) {
+            return c;
+        }
+        p = c + 1;
+    }
+    return nullptr;
+}
+
+#ifdef EVPP_MEMSEARCH_SSE2
+const char* FindSSE2(const char* begin, const char* end, const char* delim, size_t n) {
+    if (n < 2) {
+        return FindScalar(begin, end, delim, n);
+    }
+
+    const __m128i first = _mm_set1_epi8(delim[0]);
+    const __m128i last = _mm_set1_epi8(delim[n - 1]);
+    const char* p = begin;
+
+    // The 16 candidates at p need the bytes up to p + 16 + n - 1
+    while (static_cast<size_t>(end - p) >= 16 + n - 1) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + n - 1));
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+        if (mask) {
+            const char* c = Verify(p, mask, delim, n);
+            if (c) {
+                return c;
+            }
+        }
+        p += 16;
+    }
+
+    return FindScalar(p, end, delim, n);
+}
+#endif
+
+#ifdef EVPP_MEMSEARCH_AVX2
+__attribute__((target("avx2")))
+const char* FindAVX2(const char* begin, const char* end, const char* delim, size_t n) {
+    if (n < 2) {
+        return FindScalar(begin, end, delim, n);
+    }
+
+    const __m256i first = _mm256_set1_epi8(delim[0]);
+    const __m256i last = _mm256_set1_epi8(delim[n - 1]);
+    const char* p = begin;
+
+    while (static_cast<size_t>(end - p) >= 32 + n - 1) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + n - 1));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        if (mask) {
+            const char* c = Verify(p, mask, delim, n);
+            if (c) {
+                return c;
+            }
+        }
+        p += 32;
+    }
+
+    return FindSSE2(p, end, delim, n);
+}
+#endif
+
+struct Dispatch {
+    Dispatch() : kernel(&FindScalar), name("scalar") {
+#ifdef EVPP_MEMSEARCH_SSE2
+        kernel = &FindSSE2;
+        name = "sse2";
+#endif
+#ifdef EVPP_MEMSEARCH_AVX2
+        if (__builtin_cpu_supports("avx2")) {
+            kernel = &FindAVX2;
+            name = "avx2";
+        }
+#endif
+    }
+
+    Kernel kernel;
+    const char* name;
+};
+
+const Dispatch& GetDispatch() {
+    static const Dispatch d;
+    return d;
+}
+
+}
+
+const char* Find(const char* begin, const char* end, const char* delim, size_t n) {
+    assert(begin <= end);
+    return GetDispatch().kernel(begin, end, delim, n);
+}
+
+const char* KernelName() {
+    return GetDispatch().name;
+}
+
+Kernel ScalarKernel() {
+    return &FindScalar;
+}
+
+Kernel SSE2Kernel() {
+#ifdef EVPP_MEMSEARCH_SSE2
+    return &FindSSE2;
+#else
+    return nullptr;
+#endif
+}
+
+Kernel AVX2Kernel() {
+#ifdef EVPP_MEMSEARCH_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return &FindAVX2;
+    }
+#endif
+    return nullptr;
+}
+
+}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "evpp/inner_pre.h"
+
+namespace evpp {
+
+// The search of a short delimiter (CRLF, CRLFCRLF, etc.) in a block of memory,
+// which is what the line or header oriented codecs do for every read.
+//
+// The candidates are found by comparing 16 (SSE2) or 32 (AVX2) positions at
+// a time against the first and the last byte of the delimiter, so the bytes
+// in between are compared only at the few positions where both of them match.
+// The kernel is chosen at runtime by the features of the CPU.
+namespace memsearch {
+
+// @brief Find the first occurrence of delim[0, n) in [begin, end)
+// @return The position of it, or nullptr if it is not found. begin if n is 0.
+EVPP_EXPORT const char* Find(const char* begin, const char* end, const char* delim, size_t n);
+
+inline const char* FindCRLF(const char* begin, const char* end) {
+    return Find(begin, end, "\r\n", 2);
+}
+
+inline const char* FindCRLFCRLF(const char* begin, const char* end) {
+    return Find(begin, end, "\r\n\r\n", 4);
+}
+
+// @brief The name of the kernel used by Find : "avx2", "sse2" or "scalar"
+EVPP_EXPORT const char* KernelName();
+
+// The kernels, which are exposed for the tests and the benchmark.
+// The ones not supported by the target or the CPU are nullptr.
+typedef const char* (*Kernel)(const char* begin, const char* end, const char* delim, size_t n);
+EVPP_EXPORT Kernel ScalarKernel();
+EVPP_EXPORT Kernel SSE2Kernel();
+EVPP_EXPORT Kernel AVX2Kernel();
+
+}
+}
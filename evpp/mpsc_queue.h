@@ -0,0 +1,290 @@
+#pragma once
+
+#include <atomic>
+
+#include "evpp/inner_pre.h"
+
+namespace evpp {
+
+// An intrusive multi-producer/single-consumer queue based on
+// Dmitry Vyukov's non-intrusive MPSC node-based queue.
+// @see http://www.1024cores.net/home/lock-free-algorithms/queues/non-intrusive-mpsc-node-based-queue
+//
+// Push is wait-free for the producers : one atomic exchange plus one store.
+// PushBatch publishes a whole batch with the same single exchange.
+// Pop/Drain must only be called from the single consumer thread.
+//
+// Nodes are recycled to avoid allocation in the steady state.
+// The consumer returns used nodes to a lock-free free list of the queue, and the
+// producers take the whole free list at once into a thread local cache.
+// Only whole-list exchange is used to take nodes from the free list, so it is ABA free.
+template<typename T>
+class MPSCQueue {
+private:
+    struct Node {
+        Node() : next(nullptr) {}
+        std::atomic<Node*> next;
+        T value;
+    };
+
+    // The per-thread node cache of producers
+    class NodeCache {
+    public:
+        NodeCache() : head_(nullptr), count_(0) {}
+        ~NodeCache() {
+            while (head_) {
+                Node* n = head_;
+                head_ = head_->next.load(std::memory_order_relaxed);
+                delete n;
+            }
+        }
+
+        Node* Get() {
+            Node* n = head_;
+            if (n) {
+                head_ = n->next.load(std::memory_order_relaxed);
+                --count_;
+            }
+            return n;
+        }
+
+        void Put(Node* list) {
+            while (list) {
+                Node* n = list;
+                list = list->next.load(std::memory_order_relaxed);
+                if (count_ >= kMaxThreadCachedNodes) {
+                    delete n;
+                    continue;
+                }
+                n->next.store(head_, std::memory_order_relaxed);
+                head_ = n;
+                ++count_;
+            }
+        }
+    private:
+        Node* head_;
+        size_t count_;
+    };
+
+public:
+    enum {
+        kMaxFreeNodes = 4096, // The max node count retained by the free list of one queue
+        kMaxThreadCachedNodes = 1024, // The max node count retained by one producer thread
+    };
+
+    MPSCQueue() : drains_(nullptr), free_(nullptr), free_count_(0) {
+        Node* stub = new Node;
+        head_.store(stub, std::memory_order_relaxed);
+        tail_ = stub;
+    }
+
+    ~MPSCQueue() {
+        T v;
+        while (Pop(v)) {
+        }
+
+        delete tail_;
+        Node* n = free_.exchange(nullptr);
+        while (n) {
+            Node* next = n->next.load(std::memory_order_relaxed);
+            delete n;
+            n = next;
+        }
+    }
+
+    // @note It is thread safe.
+    void Push(const T& v) {
+        Node* n = NewNode();
+        n->value = v;
+        PushNode(n);
+    }
+
+    // @note It is thread safe.
+    void Push(T&& v) {
+        Node* n = NewNode();
+        n->value = std::move(v);
+        PushNode(n);
+    }
+
+    // @brief Move all the values of [first, last) into the queue.
+    //  The nodes are linked privately first and then published
+    //  with one atomic exchange, so the consumer sees the whole batch
+    //  contiguously and in order.
+    // @note It is thread safe.
+    // @return the count of values pushed
+    template<typename Iterator>
+    size_t PushBatch(Iterator first, Iterator last) {
+        return PushBatch(first, last, MoveAssign());
+    }
+
+    // @brief The same as above, but the values are stored by assign(T& dst, *it)
+    template<typename Iterator, typename Assign>
+    size_t PushBatch(Iterator first, Iterator last, Assign assign) {
+        Node* front = nullptr;
+        Node* back = nullptr;
+        size_t count = 0;
+        for (; first != last; ++first) {
+            Node* n = NewNode();
+            assign(n->value, *first);
+            if (back) {
+                back->next.store(n, std::memory_order_relaxed);
+            } else {
+                front = n;
+            }
+            back = n;
+            ++count;
+        }
+
+        if (front) {
+            // The release store in PushChain publishes the private links too
+            PushChain(front, back);
+        }
+        return count;
+    }
+
+    // @brief Pop one value from the queue.
+    // @note It MUST be called in the consumer thread.
+    // @return false if the queue is empty or a producer has not finished its Push yet.
+    bool Pop(T& v) {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+
+        v = std::move(next->value);
+        next->value = T();
+        Advance(next);
+        return true;
+    }
+
+    // @brief Pop and invoke f on all the values which have been pushed before this call.
+    //  The values pushed during the draining (e.g. by f itself) are left to the next call,
+    //  so a functor which re-queues itself can't starve the caller.
+    // @note It MUST be called in the consumer thread.
+    //  f may call Pop/Drain recursively. The values they consume are not passed
+    //  to f again, and this call still stops after the last value pushed before it,
+    //  even if that value was consumed by the recursive call.
+    // @return the count of values consumed by this call itself
+    template<typename F>
+    size_t Drain(F f) {
+        // seq_cst : it must be ordered with the notification flag of the consumer
+        DrainFrame frame(head_.load(), drains_);
+        frame.reached = tail_ == frame.last;
+        drains_ = &frame;
+
+        size_t count = 0;
+        T v;
+        while (!frame.reached) {
+            Node* next = tail_->next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                // A producer is in the middle of Push. It will notify the consumer again.
+                break;
+            }
+
+            v = std::move(next->value);
+            next->value = T();
+            Advance(next);
+            ++count;
+            f(v);
+        }
+
+        drains_ = frame.outer;
+        return count;
+    }
+
+    // @note It MUST be called in the consumer thread.
+    bool Empty() const {
+        return tail_->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    struct MoveAssign {
+        template<typename U>
+        void operator()(T& dst, U& src) const {
+            dst = std::move(src);
+        }
+    };
+
+    // The Drain calls in progress, the innermost first. The last node of a
+    // drain may be consumed by a recursive call, after which it may be recycled
+    // and pushed again, so its pointer can't be compared with tail_ afterwards.
+    // Instead, every consumption marks the drains whose last node it reaches.
+    struct DrainFrame {
+        DrainFrame(Node* l, DrainFrame* o) : last(l), outer(o), reached(false) {}
+        Node* last;
+        DrainFrame* outer;
+        bool reached;
+    };
+
+    // Consume next, which becomes the new stub
+    void Advance(Node* next) {
+        Node* tail = tail_;
+        tail_ = next;
+        for (DrainFrame* d = drains_; d; d = d->outer) {
+            if (d->last == next) {
+                d->reached = true;
+            }
+        }
+        Recycle(tail);
+    }
+
+    void PushNode(Node* n) {
+        PushChain(n, n);
+    }
+
+    void PushChain(Node* front, Node* back) {
+        Node* prev = head_.exchange(back);
+        prev->next.store(front, std::memory_order_release);
+    }
+
+    Node* NewNode() {
+        NodeCache& cache = ThreadNodeCache();
+        Node* n = cache.Get();
+        if (n == nullptr) {
+            Node* list = free_.exchange(nullptr, std::memory_order_acquire);
+            if (list) {
+                free_count_.store(0, std::memory_order_relaxed);
+                cache.Put(list);
+                n = cache.Get();
+            }
+        }
+
+        if (n == nullptr) {
+            n = new Node;
+        }
+
+        n->next.store(nullptr, std::memory_order_relaxed);
+        return n;
+    }
+
+    // Only the consumer thread pushes nodes to the free list
+    void Recycle(Node* n) {
+        if (free_count_.load(std::memory_order_relaxed) >= kMaxFreeNodes) {
+            delete n;
+            return;
+        }
+
+        free_count_.fetch_add(1, std::memory_order_relaxed);
+        Node* head = free_.load(std::memory_order_relaxed);
+        do {
+            n->next.store(head, std::memory_order_relaxed);
+        } while (!free_.compare_exchange_weak(head, n, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    static NodeCache& ThreadNodeCache() {
+        static thread_local NodeCache cache;
+        return cache;
+    }
+
+private:
+    std::atomic<Node*> head_; // The producers push nodes at head_
+    char pad_[64 - sizeof(std::atomic<Node*>)];
+    Node* tail_; // The consumer pops nodes from tail_
+    DrainFrame* drains_;
+
+    std::atomic<Node*> free_; // The recycled nodes
+    std::atomic<size_t> free_count_;
+};
+
+}
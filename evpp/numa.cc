@@ -0,0 +1,195 @@
+#include "evpp/inner_pre.h"
+#include "evpp/numa.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+#ifdef H_OS_LINUX
+#include <sched.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
+
+namespace evpp {
+namespace numa {
+
+namespace {
+const char* kNodeDir = "/sys/devices/system/node/";
+
+bool ReadFirstLine(const std::string& path, std::string* line) {
+    std::ifstream in(path.c_str());
+    return in && std::getline(in, *line);
+}
+
+// The topology doesn't change while the process is running
+struct Topology {
+    Topology() {
+        std::vector<int> allowed = AllowedCPUs();
+        std::string line;
+        if (ReadFirstLine(std::string(kNodeDir) + "online", &line)) {
+            for (int node : ParseCPUList(line)) {
+                std::string cpulist;
+                if (!ReadFirstLine(std::string(kNodeDir) + "node" + std::to_string(node) + "/cpulist", &cpulist)) {
+                    continue;
+                }
+
+                std::vector<int> cpus;
+                for (int cpu : ParseCPUList(cpulist)) {
+                    if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end()) {
+                        cpus.push_back(cpu);
+                    }
+                }
+
+                if (node >= static_cast<int>(nodes.size())) {
+                    nodes.resize(node + 1);
+                }
+                nodes[node] = cpus;
+            }
+        }
+
+        if (nodes.empty()) {
+            nodes.push_back(allowed);
+        }
+    }
+
+    std::vector<std::vector<int>> nodes; // Indexed by the node id
+};
+
+const Topology& GetTopology() {
+    static const Topology t;
+    return t;
+}
+}
+
+int NodeCount() {
+    return static_cast<int>(GetTopology().nodes.size());
+}
+
+std::vector<int> CPUsOfNode(int node) {
+    const Topology& t = GetTopology();
+    if (node < 0 || node >= static_cast<int>(t.nodes.size())) {
+        return std::vector<int>();
+    }
+    return t.nodes[node];
+}
+
+int NodeOfCPU(int cpu) {
+    const Topology& t = GetTopology();
+    for (size_t i = 0; i < t.nodes.size(); ++i) {
+        if (std::find(t.nodes[i].begin(), t.nodes[i].end(), cpu) != t.nodes[i].end()) {
+            return static_cast<int>(i);
+        }
+    }
+    return 0;
+}
+
+std::vector<int> AllowedCPUs() {
+    std::vector<int> cpus;
+#ifdef H_OS_LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &set)) {
+                cpus.push_back(i);
+            }
+        }
+        return cpus;
+    }
+#endif
+
+    unsigned n = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < n; ++i) {
+        cpus.push_back(static_cast<int>(i));
+    }
+    return cpus;
+}
+
+bool PinThread(const std::vector<int>& cpus) {
+#ifdef H_OS_LINUX
+    if (cpus.empty()) {
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+std::vector<int> ThreadAffinity() {
+    std::vector<int> cpus;
+#ifdef H_OS_LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (::pthread_getaffinity_np(::pthread_self(), sizeof(set), &set) == 0) {
+        for (int i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &set)) {
+                cpus.push_back(i);
+            }
+        }
+    }
+#endif
+    return cpus;
+}
+
+bool PreferNode(int node) {
+#if defined(H_OS_LINUX) && defined(SYS_set_mempolicy)
+    if (node < 0) {
+        return ::syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0) == 0;
+    }
+
+    const size_t kBits = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> mask(node / kBits + 1, 0);
+    mask[node / kBits] |= 1UL << (node % kBits);
+    // maxnode is the count of the bits, of which the kernel ignores the last one
+    return ::syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(), mask.size() * kBits + 1) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+std::vector<int> ParseCPUList(const std::string& s) {
+    std::vector<int> cpus;
+    size_t i = 0;
+    while (i < s.size()) {
+        size_t end = s.find(',', i);
+        if (end == std::string::npos) {
+            end = s.size();
+        }
+
+        std::string range = s.substr(i, end - i);
+        i = end + 1;
+        size_t dash = range.find('-');
+        char* stop = nullptr;
+        long lo = strtol(range.c_str(), &stop, 10);
+        if (stop == range.c_str()) {
+            continue;
+        }
+
+        long hi = lo;
+        if (dash != std::string::npos) {
+            hi = strtol(range.c_str() + dash + 1, nullptr, 10);
+        }
+        for (long c = lo; c <= hi; ++c) {
+            cpus.push_back(static_cast<int>(c));
+        }
+    }
+    return cpus;
+}
+
+}
+}
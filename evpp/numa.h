@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "evpp/inner_pre.h"
+
+namespace evpp {
+
+// The CPU and NUMA topology of the machine, and the placement of the calling
+// thread on it, which EventLoopThread uses to pin the loops.
+//
+// The topology is read from /sys/devices/system/node on Linux, so libnuma is
+// not needed. On the other systems, or if it can't be read, there is one
+// node with all the CPUs, and the pinning functions return false.
+namespace numa {
+
+// @brief The count of the NUMA nodes, 1 at least
+EVPP_EXPORT int NodeCount();
+
+// @brief The CPUs of the node, which this process is allowed to run on
+EVPP_EXPORT std::vector<int> CPUsOfNode(int node);
+
+// @brief The node of the CPU, or 0 if it is unknown
+EVPP_EXPORT int NodeOfCPU(int cpu);
+
+// @brief The CPUs this process is allowed to run on, by sched_getaffinity
+EVPP_EXPORT std::vector<int> AllowedCPUs();
+
+// @brief Pin the calling thread to the CPUs
+EVPP_EXPORT bool PinThread(const std::vector<int>& cpus);
+
+// @brief The CPUs the calling thread is allowed to run on
+EVPP_EXPORT std::vector<int> ThreadAffinity();
+
+// @brief Allocate the memory of the calling thread from the node if it has
+//  free memory (MPOL_PREFERRED), e.g. the buffers of an EventLoop pinned
+//  to it. -1 restores the default policy, which is the node of the CPU
+//  touching the memory first.
+EVPP_EXPORT bool PreferNode(int node);
+
+// @brief Parse a Linux CPU list, e.g. "0-3,8,10-11"
+EVPP_EXPORT std::vector<int> ParseCPUList(const std::string& s);
+
+}
+}
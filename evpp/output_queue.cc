@@ -0,0 +1,378 @@
+#include "evpp/inner_pre.h"
+#include "evpp/output_queue.h"
+#include "evpp/sockets.h"
+
+#include <limits.h>
+
+#ifdef H_OS_LINUX
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/sendfile.h>
+#include <linux/errqueue.h>
+#endif
+
+#ifndef H_OS_WINDOWS
+#include <sys/stat.h>
+#endif
+
+namespace evpp {
+
+namespace {
+#ifdef IOV_MAX
+const int kMaxIovecs = IOV_MAX;
+#else
+const int kMaxIovecs = 1024;
+#endif
+
+// The most bytes written by one sendfile or splice
+const size_t kMaxFileChunk = 1024 * 1024 * 1024;
+}
+
+void OutputQueue::Append(const void* d, size_t len) {
+    const char* p = static_cast<const char*>(d);
+
+    if (!blocks_.empty() && blocks_.back().appendable) {
+        // Fill the tail block first. It never grows, so the data in it doesn't move.
+        Block& b = blocks_.back();
+        size_t n = std::min(len, b.appendable->WritableBytes());
+        b.appendable->Append(p, n);
+        b.len += n;
+        length_ += n;
+        p += n;
+        len -= n;
+    }
+
+    if (len == 0) {
+        return;
+    }
+
+    // The rest goes into one new block, so a large piece of data is copied only once
+    BufferPtr h;
+    if (spare_ && spare_->capacity() >= len) {
+        h.swap(spare_);
+        h->Reset();
+    } else {
+        h = std::make_shared<Buffer>(std::max(len, size_t(kBlockSize)), 0);
+    }
+
+    h->Append(p, len);
+    Block b = { h, h->data(), len, h.get(), -1, 0, false, false, -1 };
+    blocks_.push_back(b);
+    length_ += len;
+}
+
+void OutputQueue::Append(const std::shared_ptr<void>& holder, const void* d, size_t len) {
+    if (len == 0) {
+        return;
+    }
+
+    bool zc = zerocopy_threshold_ > 0 && len >= zerocopy_threshold_;
+    Block b = { holder, static_cast<const char*>(d), len, nullptr, -1, 0, false, zc, -1 };
+    blocks_.push_back(b);
+    length_ += len;
+}
+
+void OutputQueue::AppendFile(int fd, int64_t offset, size_t len, const std::shared_ptr<void>& holder) {
+    assert(fd >= 0);
+    if (len == 0) {
+        return;
+    }
+
+    bool pipe = false;
+#ifndef H_OS_WINDOWS
+    struct stat st;
+    pipe = ::fstat(fd, &st) == 0 && S_ISFIFO(st.st_mode);
+#endif
+
+    Block b = { holder, nullptr, len, nullptr, fd, offset, pipe, false, -1 };
+    blocks_.push_back(b);
+    length_ += len;
+}
+
+void OutputQueue::Next(size_t len) {
+    assert(len <= length_);
+    length_ -= len;
+
+    while (len > 0) {
+        Block& b = blocks_.front();
+        if (len < b.len) {
+            if (b.file_fd >= 0) {
+                b.offset += len;
+            } else {
+                b.data += len;
+            }
+            b.len -= len;
+            return;
+        }
+
+        len -= b.len;
+        blocked_fd_ = -1;
+
+        KeepZeroCopyHolder(b);
+
+        // Don't keep a large block which is allocated for a large piece of data
+        if (keep_spare_ && b.appendable && b.appendable->capacity() <= size_t(kBlockSize)) {
+            spare_ = std::static_pointer_cast<Buffer>(b.holder);
+        }
+        blocks_.pop_front();
+    }
+}
+
+void OutputQueue::Reset() {
+    for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+        KeepZeroCopyHolder(*it);
+    }
+    blocks_.clear();
+    length_ = 0;
+    blocked_fd_ = -1;
+}
+
+// A block being dropped, which is sent by MSG_ZEROCOPY, is held
+// until its completion. The kernel may still be reading the memory.
+void OutputQueue::KeepZeroCopyHolder(const Block& b) {
+    if (b.zerocopy_seq >= 0) {
+        PendingHolder h = { static_cast<uint32_t>(b.zerocopy_seq), b.holder };
+        zerocopy_pending_.push_back(h);
+    }
+}
+
+void OutputQueue::Reserve(size_t len) {
+    if (!blocks_.empty() && blocks_.back().appendable && blocks_.back().appendable->WritableBytes() >= len) {
+        return;
+    }
+
+    if (spare_ && spare_->capacity() >= len) {
+        return;
+    }
+
+    spare_ = std::make_shared<Buffer>(std::max(len, size_t(kBlockSize)), 0);
+}
+
+size_t OutputQueue::footprint() const {
+    size_t n = spare_ ? spare_->capacity() : 0;
+    for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+        if (it->file_fd < 0) {
+            n += it->appendable ? it->appendable->capacity() : it->len;
+        }
+    }
+    return n;
+}
+
+// The blocks from the head of the queue which are sent in the same way
+int OutputQueue::Collect(struct iovec* iov, int n, bool zc) const {
+    int i = 0;
+    for (auto it = blocks_.begin(); it != blocks_.end() && it->file_fd < 0 && zerocopy(*it) == zc && i < n; ++it, ++i) {
+        iov[i].iov_base = const_cast<char*>(it->data);
+        iov[i].iov_len = it->len;
+    }
+    return i;
+}
+
+int OutputQueue::Peek(struct iovec* iov, int n) const {
+    int i = 0;
+    for (auto it = blocks_.begin(); it != blocks_.end() && it->file_fd < 0 && i < n; ++it, ++i) {
+        iov[i].iov_base = const_cast<char*>(it->data);
+        iov[i].iov_len = it->len;
+    }
+    return i;
+}
+
+ssize_t OutputQueue::WriteToFD(evpp_socket_t fd, int* saved_errno) {
+    struct iovec vec[kMaxIovecs];
+    ssize_t total = 0;
+    blocked_fd_ = -1;
+
+    while (!blocks_.empty()) {
+        size_t expected = 0;
+        ssize_t n = 0;
+        int serrno = 0;
+        if (front_is_file()) {
+            expected = std::min(blocks_.front().len, kMaxFileChunk);
+            n = WriteFileToFD(fd, blocks_.front(), expected, &serrno);
+        } else {
+            bool zc = zerocopy(blocks_.front());
+            int iovcnt = Collect(vec, kMaxIovecs, zc);
+            for (int i = 0; i < iovcnt; i++) {
+                expected += vec[i].iov_len;
+            }
+
+            if (zc) {
+                n = SendZeroCopy(fd, vec, iovcnt, &serrno);
+            } else {
+                n = ::writev(fd, vec, iovcnt);
+                serrno = errno;
+            }
+        }
+
+        if (n < 0) {
+            // The data written before is reported, and so is the error next time
+            if (total > 0) {
+                break;
+            }
+
+            *saved_errno = serrno;
+            return n;
+        }
+
+        Next(static_cast<size_t>(n));
+        total += n;
+
+        // The socket is full, or all the data has been written
+        if (static_cast<size_t>(n) < expected) {
+            break;
+        }
+    }
+
+    return total;
+}
+
+ssize_t OutputQueue::WriteFileToFD(evpp_socket_t fd, const Block& b, size_t len, int* saved_errno) {
+#ifdef H_OS_LINUX
+    ssize_t n = 0;
+    if (b.pipe) {
+        n = ::splice(b.file_fd, nullptr, fd, nullptr, len, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    } else {
+        off_t offset = static_cast<off_t>(b.offset);
+        n = ::sendfile(fd, b.file_fd, &offset, len);
+    }
+
+    if (n == 0) {
+        // The file is shorter than queued, or the writer of the pipe has closed it
+        *saved_errno = ENODATA;
+        return -1;
+    }
+
+    if (n < 0) {
+        *saved_errno = errno;
+    }
+
+    if (b.pipe && (n < 0 ? errno == EAGAIN : static_cast<size_t>(n) < len)) {
+        // Either the socket is full or the pipe is empty. It has to be told,
+        // since the socket stays writable while waiting for the pipe.
+        struct pollfd pfd = { b.file_fd, POLLIN, 0 };
+        if (::poll(&pfd, 1, 0) == 0) {
+            blocked_fd_ = b.file_fd;
+        }
+    }
+    return n;
+#elif !defined(H_OS_WINDOWS)
+    // Read a chunk of the file and send it. The pipes are not supported,
+    // since the data read but not sent can't be put back.
+    if (b.pipe) {
+        *saved_errno = ENOSYS;
+        return -1;
+    }
+
+    char buf[65536];
+    ssize_t r = ::pread(b.file_fd, buf, std::min(len, sizeof(buf)), static_cast<off_t>(b.offset));
+    if (r <= 0) {
+        *saved_errno = r == 0 ? ENODATA : errno;
+        return -1;
+    }
+
+    ssize_t n = ::send(fd, buf, r, 0);
+    if (n < 0) {
+        *saved_errno = errno;
+    }
+    return n;
+#else
+    (void)fd;
+    (void)b;
+    (void)len;
+    *saved_errno = ENOSYS;
+    return -1;
+#endif
+}
+
+ssize_t OutputQueue::SendZeroCopy(evpp_socket_t fd, struct iovec* iov, int iovcnt, int* saved_errno) {
+#if defined(H_OS_LINUX) && defined(MSG_ZEROCOPY)
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
+    ssize_t n = ::sendmsg(fd, &msg, MSG_ZEROCOPY | MSG_NOSIGNAL);
+    if (n < 0) {
+        if (errno != ENOBUFS) {
+            *saved_errno = errno;
+            return n;
+        }
+
+        // Out of the optmem to track the pages, copy it this time
+    } else {
+        // Every successful send has a sequence number, which is
+        // reported by the completion. Tag the blocks sent.
+        uint32_t seq = zerocopy_next_seq_++;
+        size_t tagged = 0;
+        for (auto it = blocks_.begin(); it != blocks_.end() && tagged < static_cast<size_t>(n); ++it) {
+            it->zerocopy_seq = seq;
+            tagged += it->len;
+        }
+        return n;
+    }
+#endif
+
+    ssize_t r = ::writev(fd, iov, iovcnt);
+    if (r < 0) {
+        *saved_errno = errno;
+    }
+    return r;
+}
+
+void OutputQueue::ReapZeroCopy(evpp_socket_t fd) {
+#if defined(H_OS_LINUX) && defined(SO_EE_ORIGIN_ZEROCOPY)
+    for (;;) {
+        char control[256];
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        if (::recvmsg(fd, &msg, MSG_ERRQUEUE) < 0) {
+            // EAGAIN, all the notifications are reaped
+            break;
+        }
+
+        for (struct cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+            if (!(cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR)
+                    && !(cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)) {
+                continue;
+            }
+
+            const struct sock_extended_err* ee = reinterpret_cast<const struct sock_extended_err*>(CMSG_DATA(cm));
+            if (ee->ee_errno != 0 || ee->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                continue;
+            }
+
+            if (ee->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+                // The kernel copied the data anyway, which is more expensive
+                // than a plain send, since the pages are pinned as well
+                zerocopy_threshold_ = 0;
+            }
+            CompleteZeroCopy(ee->ee_info, ee->ee_data);
+        }
+    }
+#else
+    (void)fd;
+#endif
+}
+
+void OutputQueue::CompleteZeroCopy(uint32_t lo, uint32_t hi) {
+    if (lo != zerocopy_completed_) {
+        zerocopy_ranges_[lo] = hi;
+        return;
+    }
+
+    zerocopy_completed_ = hi + 1;
+    for (auto it = zerocopy_ranges_.find(zerocopy_completed_); it != zerocopy_ranges_.end();
+            it = zerocopy_ranges_.find(zerocopy_completed_)) {
+        zerocopy_completed_ = it->second + 1;
+        zerocopy_ranges_.erase(it);
+    }
+
+    // The sequence numbers wrap around
+    while (!zerocopy_pending_.empty()
+            && static_cast<int32_t>(zerocopy_pending_.front().seq - zerocopy_completed_) < 0) {
+        zerocopy_pending_.pop_front();
+    }
+}
+
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <deque>
+#include <map>
+
+#include "evpp/inner_pre.h"
+#include "evpp/buffer.h"
+
+namespace evpp {
+
+// The queue of the data waiting to be sent by a TCPConn.
+//
+// The data is held by a chain of blocks instead of one contiguous Buffer,
+// so queuing more data never moves or reallocates the data queued before,
+// and the memory owned by the caller (a BufferPtr, a moved std::string, etc.)
+// can be queued without being copied. The queue is written
+// to the socket by writev, IOV_MAX blocks at most at a time.
+//
+// A range of a file or the data of a pipe can be queued as well, which is
+// written by sendfile or splice on Linux in its order in the queue, so the
+// data never goes through the user space.
+//
+// The large blocks queued without copying can be sent by MSG_ZEROCOPY on
+// Linux, see set_zerocopy_threshold. Their holders are kept after they
+// are written, until the kernel reports that it doesn't need the pages.
+class EVPP_EXPORT OutputQueue {
+public:
+    enum {
+        kBlockSize = 16 * 1024, // The size of the blocks holding the copied data
+    };
+
+    OutputQueue()
+        : length_(0), keep_spare_(true), blocked_fd_(-1),
+          zerocopy_threshold_(0), zerocopy_next_seq_(0), zerocopy_completed_(0) {}
+
+    // @brief Copy the data to the tail of the queue
+    void Append(const void* d, size_t len);
+
+    // @brief Queue the data without copying it
+    // @param holder - The owner of the memory of d, which is held until
+    //  the data is sent. The data MUST NOT be modified before that.
+    void Append(const std::shared_ptr<void>& holder, const void* d, size_t len);
+
+    // @brief Queue len bytes of the file fd from offset, or len bytes to be read
+    //  from fd if it is a pipe, in which case offset is ignored.
+    // @param holder - It is held until the data is sent, e.g. the owner of fd.
+    //  fd MUST stay open until then.
+    void AppendFile(int fd, int64_t offset, size_t len, const std::shared_ptr<void>& holder);
+
+    // @brief Drop len bytes from the head of the queue
+    void Next(size_t len);
+
+    // @brief Drop all the data queued. The holders of the data which is being
+    //  sent by MSG_ZEROCOPY are still held until the completions are reaped.
+    void Reset();
+
+    // @brief Make sure len bytes can be copied into the queue without allocating
+    void Reserve(size_t len);
+
+    // @brief Fill iov with the blocks from the head of the queue, until the first file block
+    // @return The count of the iovecs filled, n at most
+    int Peek(struct iovec* iov, int n) const;
+
+    // @brief Write the queue to fd by writev, sendfile and splice, and drop the data written
+    // @return The count of the bytes written, or -1 with *saved_errno set.
+    //  It is ENODATA if a file or a pipe ends before the length queued.
+    ssize_t WriteToFD(evpp_socket_t fd, int* saved_errno);
+
+public:
+    // The first block of the queue, which is contiguous
+    const char* data() const {
+        assert(!blocks_.empty());
+        assert(!front_is_file());
+        return blocks_.front().data;
+    }
+
+    // Whether the first block is queued by AppendFile, which has no data()
+    bool front_is_file() const {
+        return !blocks_.empty() && blocks_.front().file_fd >= 0;
+    }
+
+    // The pipe which has no data for the first block, or -1. It is set by
+    // WriteToFD, which should be called again when the pipe becomes readable.
+    int blocked_fd() const {
+        return blocked_fd_;
+    }
+
+    size_t front_length() const {
+        return blocks_.empty() ? 0 : blocks_.front().len;
+    }
+
+    // The count of the bytes in the queue
+    size_t length() const {
+        return length_;
+    }
+
+    bool empty() const {
+        return length_ == 0;
+    }
+
+    size_t block_count() const {
+        return blocks_.size();
+    }
+
+    // @brief Whether to keep a drained block for reuse. It is true by default.
+    void set_keep_spare(bool on) {
+        keep_spare_ = on;
+        if (!on) {
+            spare_.reset();
+        }
+    }
+
+    void ReleaseSpare() {
+        spare_.reset();
+    }
+
+    // @brief Send the blocks queued without copying, which are at least threshold
+    //  bytes, by sendmsg with MSG_ZEROCOPY. 0 turns it off, which is the default.
+    //  It affects the blocks queued after this call.
+    // @note SO_ZEROCOPY MUST be set on the socket. It is turned off automatically
+    //  when the kernel reports it copied the data anyway, e.g. on the loopback.
+    void set_zerocopy_threshold(size_t threshold) {
+        zerocopy_threshold_ = threshold;
+    }
+    size_t zerocopy_threshold() const {
+        return zerocopy_threshold_;
+    }
+
+    // @brief Release the holders whose zero-copy sends have completed,
+    //  by the notifications in the error queue of fd
+    void ReapZeroCopy(evpp_socket_t fd);
+
+    // Whether there are zero-copy sends not completed yet. The error queue
+    // of the socket MUST be reaped then whenever it is reported.
+    bool zerocopy_inflight() const {
+        return zerocopy_completed_ != zerocopy_next_seq_;
+    }
+
+    // The count of the holders of the data written, which are waiting for the completions
+    size_t zerocopy_pending() const {
+        return zerocopy_pending_.size();
+    }
+
+    // @brief The bytes of the memory held by the queue : the capacities of the
+    //  blocks allocated by the queue and the lengths of the ones queued without copying.
+    size_t footprint() const;
+
+private:
+    struct Block {
+        std::shared_ptr<void> holder;
+        const char* data;
+        size_t len;
+        Buffer* appendable; // Not null if the holder is a Buffer allocated by the queue, the copied data is appended to it
+
+        // The blocks queued by AppendFile, whose data is nullptr
+        int file_fd;
+        int64_t offset;
+        bool pipe;
+
+        // The blocks sent by MSG_ZEROCOPY, see set_zerocopy_threshold
+        bool zerocopy;
+        int64_t zerocopy_seq; // The sequence number of the last send of it, or -1
+    };
+
+    bool zerocopy(const Block& b) const {
+        return b.zerocopy && zerocopy_threshold_ > 0;
+    }
+
+    void KeepZeroCopyHolder(const Block& b);
+    int Collect(struct iovec* iov, int n, bool zc) const;
+    ssize_t WriteFileToFD(evpp_socket_t fd, const Block& b, size_t len, int* saved_errno);
+    ssize_t SendZeroCopy(evpp_socket_t fd, struct iovec* iov, int iovcnt, int* saved_errno);
+    void CompleteZeroCopy(uint32_t lo, uint32_t hi);
+
+    std::deque<Block> blocks_;
+    BufferPtr spare_; // A drained block, which is reused to avoid allocating again
+    size_t length_;
+    bool keep_spare_;
+    int blocked_fd_;
+
+    // The sequence numbers of the zero-copy sends are counted by the kernel
+    // from 0 for every socket, and the completions are reported as ranges.
+    size_t zerocopy_threshold_;
+    uint32_t zerocopy_next_seq_;
+    uint32_t zerocopy_completed_; // All the sends before it have completed
+    std::map<uint32_t, uint32_t> zerocopy_ranges_; // The ranges completed out of order
+    struct PendingHolder {
+        uint32_t seq;
+        std::shared_ptr<void> holder;
+    };
+    std::deque<PendingHolder> zerocopy_pending_;
+};
+
+}
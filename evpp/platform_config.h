@@ -4,6 +4,10 @@
 #define H_OS_MACOSX
 #endif
 
+#if defined(__linux__)
+#define H_OS_LINUX
+#endif
+
 #ifdef _DEBUG
 #ifndef H_DEBUG_MODE
 #define H_DEBUG_MODE
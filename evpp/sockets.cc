@@ -4,6 +4,10 @@
 #include "evpp/sockets.h"
 #include "evpp/duration.h"
 
+#ifdef H_OS_LINUX
+#include <linux/filter.h>
+#endif
+
 namespace evpp {
 
 static const std::string empty_string;
@@ -298,6 +302,50 @@ void SetReusePort(evpp_socket_t fd) {
 #endif
 }
 
+bool AttachReusePortCPUFilter(evpp_socket_t fd, uint32_t group_size) {
+#if defined(H_OS_LINUX) && defined(SO_ATTACH_REUSEPORT_CBPF)
+    assert(group_size > 0);
+    struct sock_filter code[] = {
+        // A = the id of the current CPU
+        { BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU) },
+        // A = A % group_size
+        { BPF_ALU | BPF_MOD | BPF_K, 0, 0, group_size },
+        // Return A, the index of the socket in the group
+        { BPF_RET | BPF_A, 0, 0, 0 },
+    };
+    struct sock_fprog prog = { static_cast<unsigned short>(sizeof(code) / sizeof(code[0])), code };
+    int rc = ::setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog));
+    return rc == 0;
+#else
+    (void)fd;
+    (void)group_size;
+    return false;
+#endif
+}
+
+int GetIncomingCPU(evpp_socket_t fd) {
+#if defined(H_OS_LINUX) && defined(SO_INCOMING_CPU)
+    int cpu = -1;
+    socklen_t len = static_cast<socklen_t>(sizeof cpu);
+    if (::getsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, &len) != 0) {
+        return -1;
+    }
+    return cpu;
+#else
+    (void)fd;
+    return -1;
+#endif
+}
+
+bool SetBusyPoll(evpp_socket_t fd, int usec) {
+#if defined(H_OS_LINUX) && defined(SO_BUSY_POLL)
+    return ::setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &usec, static_cast<socklen_t>(sizeof usec)) == 0;
+#else
+    (void)fd;
+    (void)usec;
+    return false;
+#endif
+}
 
 void SetTCPNoDelay(evpp_socket_t fd, bool on) {
     int optval = on ? 1 : 0;
@@ -323,4 +371,14 @@ int readv(evpp_socket_t sockfd, struct iovec* iov, int iovcnt) {
 
     return -1;
 }
+
+int writev(evpp_socket_t sockfd, struct iovec* iov, int iovcnt) {
+    DWORD written = 0;
+
+    if (::WSASend(sockfd, iov, iovcnt, &written, 0, nullptr, nullptr) == 0) {
+        return written;
+    }
+
+    return -1;
+}
 #endif
@@ -18,6 +18,24 @@ EVPP_EXPORT evpp_socket_t CreateUDPServer(int port);
 EVPP_EXPORT void SetKeepAlive(evpp_socket_t fd, bool on);
 EVPP_EXPORT void SetReuseAddr(evpp_socket_t fd);
 EVPP_EXPORT void SetReusePort(evpp_socket_t fd);
+
+// @brief Attach a classic BPF program to the SO_REUSEPORT group of the listening
+//  socket fd, which chooses the socket of the group to accept a connection by
+//  the CPU handling its packets : the CPU id modulo group_size. The sockets
+//  are numbered in the order they start listening.
+// @return false if it is not supported, which needs Linux 4.5 or later
+EVPP_EXPORT bool AttachReusePortCPUFilter(evpp_socket_t fd, uint32_t group_size);
+
+// @brief The CPU which handled the last packet received by the socket fd
+//  (SO_INCOMING_CPU), i.e. the CPU of the receive queue of the NIC with RSS
+// @return -1 if it is not supported, which needs Linux 3.19 or later
+EVPP_EXPORT int GetIncomingCPU(evpp_socket_t fd);
+
+// @brief Busy poll the receive queue of the NIC for up to usec microseconds
+//  when a read of the socket fd finds no data (SO_BUSY_POLL)
+// @return false if it is not supported, or usec is above net.core.busy_read
+//  without CAP_NET_ADMIN
+EVPP_EXPORT bool SetBusyPoll(evpp_socket_t fd, int usec);
 EVPP_EXPORT void SetTCPNoDelay(evpp_socket_t fd, bool on);
 EVPP_EXPORT void SetTimeout(evpp_socket_t fd, uint32_t timeout_ms);
 EVPP_EXPORT void SetTimeout(evpp_socket_t fd, const Duration& timeout);
@@ -123,4 +141,5 @@ inline const struct sockaddr_storage* sockaddr_storage_cast(const struct sockadd
 
 #ifdef H_OS_WINDOWS
 EVPP_EXPORT int readv(evpp_socket_t sockfd, struct iovec* iov, int iovcnt);
+EVPP_EXPORT int writev(evpp_socket_t sockfd, struct iovec* iov, int iovcnt);
 #endif
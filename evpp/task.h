@@ -0,0 +1,184 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <new>
+#include <cstddef>
+
+#include "evpp/inner_pre.h"
+
+// The inline storage size of evpp::Task. A callable larger than this
+// (or not nothrow move constructible) is allocated on heap.
+#ifndef EVPP_TASK_INLINE_SIZE
+#define EVPP_TASK_INLINE_SIZE 64
+#endif
+
+namespace evpp {
+
+// A move-only `void()` callable wrapper with small buffer optimization.
+//
+// std::function of libstdc++ only stores callables no larger than 16 bytes
+// inline. A lambda capturing a TCPConnPtr and a std::string is much larger than
+// that, so every cross-thread EventLoop::QueueInLoop of it allocates.
+// BasicTask stores callables up to kInlineSize bytes inline, and because it is
+// move-only it can also hold move-only captures.
+//
+// The converting constructor is explicit to avoid ambiguity with the
+// std::function overloads of EventLoop, e.g. :
+//     loop->QueueInLoop(evpp::Task([conn, s]() { conn->Send(s); }));
+template<size_t kInlineSize>
+class BasicTask {
+public:
+    BasicTask() : ops_(nullptr) {}
+
+    template<typename F,
+             typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, BasicTask>::value>::type>
+    explicit BasicTask(F&& f) : ops_(nullptr) {
+        typedef typename std::decay<F>::type Fn;
+        if (IsNull(f)) {
+            return;
+        }
+
+        Init<Fn>(std::forward<F>(f), std::integral_constant<bool, IsInline<Fn>()>());
+    }
+
+    BasicTask(BasicTask&& rhs) noexcept : ops_(rhs.ops_) {
+        if (ops_) {
+            ops_->move(&storage_, &rhs.storage_);
+            rhs.ops_ = nullptr;
+        }
+    }
+
+    BasicTask& operator=(BasicTask&& rhs) noexcept {
+        if (this != &rhs) {
+            Reset();
+            if (rhs.ops_) {
+                rhs.ops_->move(&storage_, &rhs.storage_);
+                ops_ = rhs.ops_;
+                rhs.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    ~BasicTask() {
+        Reset();
+    }
+
+    BasicTask(const BasicTask&) = delete;
+    BasicTask& operator=(const BasicTask&) = delete;
+
+    void operator()() {
+        assert(ops_);
+        ops_->invoke(&storage_);
+    }
+
+    explicit operator bool() const {
+        return ops_ != nullptr;
+    }
+
+    void Reset() {
+        if (ops_) {
+            ops_->destroy(&storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    // Return true if a callable of type F is stored inline, that is without heap allocation
+    template<typename F>
+    static constexpr bool IsInline() {
+        return sizeof(F) <= kInlineSize
+               && alignof(F) <= alignof(Storage)
+               && std::is_nothrow_move_constructible<F>::value;
+    }
+
+private:
+    typedef typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::type Storage;
+
+    struct Ops {
+        void (*invoke)(void* s);
+        void (*move)(void* dst, void* src); // Move src to dst and destroy src
+        void (*destroy)(void* s);
+    };
+
+    template<typename Fn>
+    struct InlineOps {
+        static void Invoke(void* s) {
+            (*static_cast<Fn*>(s))();
+        }
+        static void Move(void* dst, void* src) {
+            Fn* f = static_cast<Fn*>(src);
+            new (dst) Fn(std::move(*f));
+            f->~Fn();
+        }
+        static void Destroy(void* s) {
+            static_cast<Fn*>(s)->~Fn();
+        }
+        static const Ops ops;
+    };
+
+    template<typename Fn>
+    struct HeapOps {
+        static void Invoke(void* s) {
+            (**static_cast<Fn**>(s))();
+        }
+        static void Move(void* dst, void* src) {
+            *static_cast<Fn**>(dst) = *static_cast<Fn**>(src);
+        }
+        static void Destroy(void* s) {
+            delete *static_cast<Fn**>(s);
+        }
+        static const Ops ops;
+    };
+
+    template<typename Fn, typename F>
+    void Init(F&& f, std::true_type /*inline*/) {
+        new (&storage_) Fn(std::forward<F>(f));
+        ops_ = &InlineOps<Fn>::ops;
+    }
+
+    template<typename Fn, typename F>
+    void Init(F&& f, std::false_type /*inline*/) {
+        *reinterpret_cast<Fn**>(&storage_) = new Fn(std::forward<F>(f));
+        ops_ = &HeapOps<Fn>::ops;
+    }
+
+    template<typename F>
+    static bool IsNull(const F&) {
+        return false;
+    }
+
+    template<typename R>
+    static bool IsNull(const std::function<R()>& f) {
+        return !f;
+    }
+
+    template<typename R>
+    static bool IsNull(R (*f)()) {
+        return f == nullptr;
+    }
+
+private:
+    Storage storage_;
+    const Ops* ops_;
+};
+
+template<size_t kInlineSize>
+template<typename Fn>
+const typename BasicTask<kInlineSize>::Ops BasicTask<kInlineSize>::InlineOps<Fn>::ops = {
+    &BasicTask<kInlineSize>::InlineOps<Fn>::Invoke,
+    &BasicTask<kInlineSize>::InlineOps<Fn>::Move,
+    &BasicTask<kInlineSize>::InlineOps<Fn>::Destroy
+};
+
+template<size_t kInlineSize>
+template<typename Fn>
+const typename BasicTask<kInlineSize>::Ops BasicTask<kInlineSize>::HeapOps<Fn>::ops = {
+    &BasicTask<kInlineSize>::HeapOps<Fn>::Invoke,
+    &BasicTask<kInlineSize>::HeapOps<Fn>::Move,
+    &BasicTask<kInlineSize>::HeapOps<Fn>::Destroy
+};
+
+typedef BasicTask<EVPP_TASK_INLINE_SIZE> Task;
+
+}
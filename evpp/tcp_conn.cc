@@ -8,7 +8,58 @@
 #include "evpp/sockets.h"
 #include "evpp/invoke_timer.h"
 
+#ifdef H_OS_LINUX
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
 namespace evpp {
+
+namespace {
+// The interval to reap the zero-copy completions which no event reports
+const double kZeroCopyReapInterval = 0.01;
+
+#ifdef H_OS_LINUX
+
+// Holds the data sent by MSG_ZEROCOPY by a closed TCPConn, which the kernel may
+// still be sending or retransmitting, until the completions are reaped from the
+// error queue of the socket. fd is a dup of the fd of the TCPConn, which keeps
+// the socket open, and is closed then. No event is reliable to watch for the
+// completions of a socket which is shut down, so they are polled by a timer.
+class ZeroCopyLinger {
+public:
+    ZeroCopyLinger(evpp_socket_t fd, OutputQueue&& q)
+        : fd_(fd), queue_(std::move(q)) {}
+
+    ~ZeroCopyLinger() {
+        EVUTIL_CLOSESOCKET(fd_);
+    }
+
+    static void Start(EventLoop* loop, evpp_socket_t fd, OutputQueue&& q) {
+        std::shared_ptr<ZeroCopyLinger> l = std::make_shared<ZeroCopyLinger>(fd, std::move(q));
+
+        // The timer holds l until it is canceled
+        l->timer_ = loop->RunEvery(Duration(kZeroCopyReapInterval),
+                                   Task(std::bind(&ZeroCopyLinger::Reap, l)),
+                                   InvokeTimer::kWheelTimer);
+    }
+
+private:
+    void Reap() {
+        queue_.ReapZeroCopy(fd_);
+        if (!queue_.zerocopy_inflight()) {
+            timer_->Cancel();
+            timer_.reset();
+        }
+    }
+
+    evpp_socket_t fd_;
+    OutputQueue queue_;
+    InvokeTimerPtr timer_;
+};
+#endif
+}
+
 TCPConn::TCPConn(EventLoop* l,
                  const std::string& n,
                  evpp_socket_t sockfd,
@@ -21,10 +72,23 @@ TCPConn::TCPConn(EventLoop* l,
     , name_(n)
     , local_addr_(laddr)
     , remote_addr_(raddr)
+    , outbound_scheduled_(false)
     , type_(kIncoming)
     , status_(kDisconnected) {
     if (sockfd >= 0) {
         chan_.reset(new FdChannel(l, sockfd, false, false));
+        chan_->SetEdgeTriggered(l->io_backend() == EventLoop::kEpollET);
+
+        if (l->io_uring()) {
+            recv_op_ = std::make_shared<IoUringEngine::Operation>();
+            recv_op_->handler = [this](int res, const char* data, bool more) {
+                HandleIoUringRecv(res, data, more);
+            };
+            send_op_ = std::make_shared<IoUringEngine::Operation>();
+            send_op_->handler = [this](int res, const char*, bool) {
+                HandleIoUringSend(res);
+            };
+        }
         chan_->SetReadCallback(std::bind(&TCPConn::HandleRead, this));
         chan_->SetWriteCallback(std::bind(&TCPConn::HandleWrite, this));
     }
@@ -73,9 +137,22 @@ void TCPConn::Send(const std::string& d) {
     }
 
     if (loop_->IsInLoopThread()) {
-        SendInLoop(d);
+        SendInLoop(d.data(), d.size());
     } else {
-        loop_->RunInLoop(std::bind(&TCPConn::SendStringInLoop, shared_from_this(), d));
+        Send(std::string(d));
+    }
+}
+
+void TCPConn::Send(std::string&& d) {
+    if (status_ != kConnected) {
+        return;
+    }
+
+    if (loop_->IsInLoopThread()) {
+        SendInLoop(d.data(), d.size());
+    } else {
+        auto s = std::make_shared<std::string>(std::move(d));
+        QueueOutbound(s, s->data(), s->size());
     }
 }
 
@@ -87,7 +164,7 @@ void TCPConn::Send(const Slice& message) {
     if (loop_->IsInLoopThread()) {
         SendInLoop(message);
     } else {
-        loop_->RunInLoop(std::bind(&TCPConn::SendStringInLoop, shared_from_this(), message.ToString()));
+        Send(message.ToString());
     }
 }
 
@@ -108,7 +185,23 @@ void TCPConn::Send(Buffer* buf) {
         SendInLoop(buf->data(), buf->length());
         buf->Reset();
     } else {
-        loop_->RunInLoop(std::bind(&TCPConn::SendStringInLoop, shared_from_this(), buf->NextAllString()));
+        Send(buf->NextAllString());
+    }
+}
+
+void TCPConn::Send(Buffer&& buf) {
+    if (status_ != kConnected) {
+        return;
+    }
+
+    if (loop_->IsInLoopThread()) {
+        SendInLoop(buf.data(), buf.length());
+        buf.Reset();
+    } else {
+        // Take over the memory of buf and leave an empty one to the caller
+        BufferPtr b(new Buffer(0, 0));
+        b->Swap(buf);
+        QueueOutbound(b, b->data(), b->length());
     }
 }
 
@@ -118,9 +211,34 @@ void TCPConn::Send(BufferPtr buf) {
     }
 
     if (loop_->IsInLoopThread()) {
-        SendInLoop(buf->data(), buf->length());
+        SendInLoop(buf->data(), buf->length(), buf);
     } else {
-        loop_->RunInLoop(std::bind(&TCPConn::SendBufferInLoop, shared_from_this(), buf));
+        QueueOutbound(buf, buf->data(), buf->length());
+    }
+}
+
+void TCPConn::Send(const SharedSlice& s) {
+    if (status_ != kConnected) {
+        return;
+    }
+
+    if (loop_->IsInLoopThread()) {
+        SendInLoop(s.data(), s.size(), s.holder());
+    } else {
+        QueueOutbound(s.holder(), s.data(), s.size());
+    }
+}
+
+void TCPConn::SendFile(int fd, int64_t offset, size_t len, const std::shared_ptr<void>& holder) {
+    if (status_ != kConnected) {
+        return;
+    }
+
+    if (loop_->IsInLoopThread()) {
+        SendFileInLoop(fd, offset, len, holder);
+    } else {
+        OutboundMessage m = { holder, nullptr, len, fd, offset };
+        QueueOutbound(std::move(m));
     }
 }
 
@@ -131,29 +249,56 @@ void TCPConn::SendTotal(BufferPtr buf)
     }
 
     if (loop_->IsInLoopThread()) {
-        SendInLoop(buf->begin(), buf->total());
+        SendInLoop(buf->begin(), buf->total(), buf);
     } else {
-        loop_->RunInLoop(std::bind(&TCPConn::SendTotalBufferInLoop, shared_from_this(), buf));
+        QueueOutbound(buf, buf->begin(), buf->total());
     }
 }
 
-void TCPConn::SendInLoop(const Slice& message) {
-    SendInLoop(message.data(), message.size());
+// It is called by the threads other than the loop thread. The data is handed
+// over to the loop thread by outbound_, and sent there without copying.
+void TCPConn::QueueOutbound(const std::shared_ptr<void>& holder, const void* data, size_t len) {
+    OutboundMessage m = { holder, static_cast<const char*>(data), len, -1, 0 };
+    QueueOutbound(std::move(m));
 }
 
-void TCPConn::SendStringInLoop(const std::string& message) {
-    SendInLoop(message.data(), message.size());
+void TCPConn::QueueOutbound(OutboundMessage&& m) {
+    outbound_.Push(std::move(m));
+
+    // Only the first message after the last draining queues a task,
+    // the following ones are drained by the same task.
+    if (!outbound_scheduled_.exchange(true)) {
+        loop_->RunInLoop(Task(std::bind(&TCPConn::DrainOutbound, shared_from_this())));
+    }
 }
 
-void TCPConn::SendBufferInLoop(BufferPtr buf) {
-    SendInLoop(buf->data(), buf->length());
+void TCPConn::DrainOutbound() {
+    assert(loop_->IsInLoopThread());
+
+    // It must be a read-modify-write. It makes the messages pushed by the
+    // producers which saw the flag set and didn't queue a task visible here.
+    outbound_scheduled_.exchange(false);
+
+    outbound_.Drain([this](OutboundMessage& m) {
+        if (m.file_fd >= 0) {
+            SendFileInLoop(m.file_fd, m.offset, m.len, m.holder);
+        } else {
+            SendInLoop(m.data, m.len, m.holder);
+        }
+    });
 }
 
-void TCPConn::SendTotalBufferInLoop(BufferPtr buf) {
-    SendInLoop(buf->begin(), buf->total());
+void TCPConn::SendInLoop(const Slice& message) {
+    SendInLoop(message.data(), message.size());
 }
 
 void TCPConn::SendInLoop(const void* data, size_t len) {
+    SendInLoop(data, len, std::shared_ptr<void>());
+}
+
+// If holder is given, the data which can't be sent right now is queued
+// without copying, and holder is held until the data is sent.
+void TCPConn::SendInLoop(const void* data, size_t len, const std::shared_ptr<void>& holder) {
     assert(loop_->IsInLoopThread());
 
     if (status_ == kDisconnected) {
@@ -166,7 +311,17 @@ void TCPConn::SendInLoop(const void* data, size_t len) {
     bool write_error = false;
 
     // if no data in output queue, writing directly
-    if (!chan_->IsWritable() && output_buffer_.length() == 0) {
+    if (!auto_cork_ && !send_op_ && !chan_->IsWritable() && output_buffer_.length() == 0) {
+        if (holder && output_buffer_.zerocopy_threshold() > 0 && len >= output_buffer_.zerocopy_threshold()) {
+            // It is sent by the queue, which holds holder until the completion
+            output_buffer_.Append(holder, data, len);
+            HandleWrite();
+            if (output_buffer_.length() >= high_water_mark_ && high_water_mark_fn_) {
+                loop_->QueueInLoop(std::bind(high_water_mark_fn_, shared_from_this(), output_buffer_.length()));
+            }
+            return;
+        }
+
         nwritten = ::send(chan_->fd(), static_cast<const char*>(data), len, MSG_NOSIGNAL);
         if (nwritten >= 0) {
             remaining = len - nwritten;
@@ -195,52 +350,172 @@ void TCPConn::SendInLoop(const void* data, size_t len) {
 
     if (remaining > 0) {
         size_t old_len = output_buffer_.length();
-        if (old_len + remaining >= high_water_mark_
-                && old_len < high_water_mark_
-                && high_water_mark_fn_) {
-            loop_->QueueInLoop(std::bind(high_water_mark_fn_, shared_from_this(), old_len + remaining));
+        if (holder) {
+            output_buffer_.Append(holder, static_cast<const char*>(data) + nwritten, remaining);
+        } else {
+            output_buffer_.Append(static_cast<const char*>(data) + nwritten, remaining);
         }
+        OnOutputQueued(old_len);
+    }
+}
 
-        output_buffer_.Append(static_cast<const char*>(data) + nwritten, remaining);
+void TCPConn::SendFileInLoop(int fd, int64_t offset, size_t len, const std::shared_ptr<void>& holder) {
+    assert(loop_->IsInLoopThread());
 
+    if (status_ == kDisconnected) {
+        _log_warn(myLog, "disconnected, give up sending the file");
+        return;
+    }
+
+    if (len == 0) {
+        return;
+    }
+
+    // It is always queued, and written as the data queued before it is written
+    size_t old_len = output_buffer_.length();
+    output_buffer_.AppendFile(fd, offset, len, holder);
+    OnOutputQueued(old_len);
+}
+
+// It is called after the data which can't be sent right now is
+// appended to output_buffer_, which had old_len bytes before.
+void TCPConn::OnOutputQueued(size_t old_len) {
+    size_t new_len = output_buffer_.length();
+    if (new_len >= high_water_mark_
+            && old_len < high_water_mark_
+            && high_water_mark_fn_) {
+        loop_->QueueInLoop(std::bind(high_water_mark_fn_, shared_from_this(), new_len));
+    }
+
+    if (auto_cork_) {
+        if (!flush_scheduled_) {
+            flush_scheduled_ = true;
+            loop_->RunBeforeWait(Task(std::bind(&TCPConn::Flush, shared_from_this())));
+        }
+    } else if (send_op_) {
+        SendByIoUring();
+    } else {
+        WaitForWritable();
+    }
+}
+
+// The rest of output_buffer_ is written when the socket becomes writable,
+// or when the pipe spliced by the head block becomes readable.
+void TCPConn::WaitForWritable() {
+    int pipe_fd = output_buffer_.blocked_fd();
+    if (pipe_fd < 0) {
         if (!chan_->IsWritable()) {
             chan_->EnableWriteEvent();
         }
+        return;
+    }
+
+    if (chan_->IsWritable()) {
+        chan_->DisableWriteEvent();
+    }
+
+    if (pipe_chan_ && pipe_chan_->fd() != pipe_fd) {
+        pipe_chan_->DisableAllEvent();
+        pipe_chan_->Close();
+        pipe_chan_.reset();
+    }
+
+    if (!pipe_chan_) {
+        pipe_chan_.reset(new FdChannel(loop_, pipe_fd, false, false));
+        pipe_chan_->SetReadCallback(std::bind(&TCPConn::HandlePipeReadable, this));
+    }
+
+    if (!pipe_chan_->IsReadable()) {
+        pipe_chan_->EnableReadEvent();
+    }
+}
+
+void TCPConn::HandlePipeReadable() {
+    assert(loop_->IsInLoopThread());
+    pipe_chan_->DisableReadEvent();
+    if (status_ == kDisconnected) {
+        return;
+    }
+
+    if (send_op_) {
+        // Written by HandleWrite, see SendByIoUring
+        chan_->EnableWriteEvent();
+    } else {
+        HandleWrite();
+    }
+}
+
+void TCPConn::Flush() {
+    if (!loop_->IsInLoopThread()) {
+        loop_->RunInLoop(Task(std::bind(&TCPConn::Flush, shared_from_this())));
+        return;
+    }
+
+    flush_scheduled_ = false;
+    if (status_ == kDisconnected || output_buffer_.length() == 0) {
+        return;
+    }
+
+    if (send_op_) {
+        SendByIoUring();
+        return;
+    }
+
+    if (chan_->IsWritable()) {
+        // The rest will be written by HandleWrite
+        return;
+    }
+
+    int serrno = 0;
+    ssize_t n = output_buffer_.WriteToFD(fd_, &serrno);
+    if (n < 0 && !EVUTIL_ERR_RW_RETRIABLE(serrno)) {
+        _log_err(myLog, "TCPConn::Flush errno=%d err=%s", serrno, strerror(serrno).c_str());
+        HandleError();
+        return;
+    }
+
+    if (output_buffer_.length() == 0) {
+        if (write_complete_fn_) {
+            loop_->QueueInLoop(std::bind(write_complete_fn_, shared_from_this()));
+        }
+    } else {
+        WaitForWritable();
     }
+    UpdateZeroCopyReaping();
 }
 
 void TCPConn::HandleRead() {
     assert(loop_->IsInLoopThread());
+    if (output_buffer_.zerocopy_inflight()) {
+        // The completions are reported as an error, which comes here
+        output_buffer_.ReapZeroCopy(fd_);
+    }
+
     int serrno = 0;
-    ssize_t n = input_buffer_.ReadFromFD(chan_->fd(), &serrno);
-    if (n > 0) {
+    ssize_t n = input_buffer_.ReadFromFD(chan_->fd(), &serrno, ExpectedReadSize());
+    while (n > 0) {
+        RecordReadSize(static_cast<size_t>(n));
         msg_fn_(shared_from_this(), &input_buffer_);
-    } else if (n == 0) {
-        if (type() == kOutgoing) {
-            // This is an outgoing connection, we own it and it's done. so close it
-            _log_trace(myLog, "fd=%d. We read 0 bytes and close the socket.", fd_);
-            status_ = kDisconnecting;
-            HandleClose();
-        } else {
-            // Fix the half-closing problem : https://github.com/chenshuo/muduo/pull/117
-
-            chan_->DisableReadEvent();
-            if (close_delay_.IsZero()) {
-                _log_trace(myLog, "channel (fd=%d) DisableReadEvent. delay time %lf s. We close this connection immediately",
-                           chan_->fd(), close_delay_.Seconds());
-                DelayClose();
-            } else {
-                // This is an incoming connection, we need to preserve the
-                // connection for a while so that we can reply to it.
-                // And we set a timer to close the connection eventually.
-                _log_trace(myLog, "channel (fd=%d) DisableReadEvent. And set a timer to delay close this TCPConn, delay time %lf s",
-                           chan_->fd(), close_delay_.Seconds());
-                delay_close_timer_ = loop_->RunAfter(close_delay_, std::bind(&TCPConn::DelayClose, shared_from_this())); // TODO leave it to user layer close.
-            }
+        ShrinkInputBuffer();
+        CheckInputHighWaterMark();
+
+        // An edge triggered fd is not reported again until it is drained.
+        // The read event is disabled if the reading is paused.
+        if (status_ != kConnected || !chan_->edge_triggered() || !chan_->IsReadable()) {
+            return;
         }
+
+        n = input_buffer_.ReadFromFD(chan_->fd(), &serrno, ExpectedReadSize());
+    }
+
+    if (n == 0) {
+        HandleReadEOF();
     } else {
         if (EVUTIL_ERR_RW_RETRIABLE(serrno)) {
             _log_trace(myLog, "errno=%d err=%s", serrno, strerror(serrno).c_str());
+
+            // The buffer may be grown for the expected read, which got nothing
+            ShrinkInputBuffer();
         } else {
             _log_trace(myLog, "errno=%d err=%s We are closing this connection now.", serrno, strerror(serrno).c_str());
             HandleError();
@@ -248,29 +523,332 @@ void TCPConn::HandleRead() {
     }
 }
 
+// The expected size of the next read is twice of the moving average of the
+// recent reads. When the input buffer has been released, FIONREAD tells the
+// size exactly, so the buffer is allocated once at the right size.
+size_t TCPConn::ExpectedReadSize() const {
+    size_t expected = std::min(read_size_ema_ * 2, size_t(kMaxExpectedReadSize));
+#ifdef H_OS_LINUX
+    if (input_buffer_.capacity() <= Buffer::kCheapPrependSize) {
+        int readable = 0;
+        if (::ioctl(fd_, FIONREAD, &readable) == 0 && readable > 0) {
+            expected = std::min(static_cast<size_t>(readable), size_t(kMaxExpectedReadSize));
+        }
+    }
+#endif
+    return expected;
+}
+
+void TCPConn::RecordReadSize(size_t n) {
+    read_size_ema_ = read_size_ema_ - read_size_ema_ / 8 + n / 8;
+}
+
+// It is called after the MessageCallback consumed the input. A burst of data
+// grows the input buffer, and it is shrunk here after the burst is over, to
+// about the size the recent reads need.
+void TCPConn::ShrinkInputBuffer() {
+    if (input_buffer_.length() != 0) {
+        return;
+    }
+
+    if (release_buffers_when_idle_) {
+        input_buffer_.Release();
+        return;
+    }
+
+    size_t keep = std::max(size_t(Buffer::kInitialSize), ExpectedReadSize());
+    if (input_buffer_.capacity() > keep * 4) {
+        input_buffer_.Shrink(keep);
+    }
+}
+
+void TCPConn::ReleaseBuffers() {
+    assert(loop_->IsInLoopThread());
+    input_buffer_.Release();
+    output_buffer_.ReleaseSpare();
+}
+
+void TCPConn::SetReleaseBuffersWhenIdle(bool on) {
+    assert(loop_->IsInLoopThread());
+    release_buffers_when_idle_ = on;
+    output_buffer_.set_keep_spare(!on);
+    if (on) {
+        ReleaseBuffers();
+    }
+}
+
+// It is called after the MessageCallback consumed the input
+void TCPConn::CheckInputHighWaterMark() {
+    bool over = input_high_water_mark_ > 0 && input_buffer_.length() >= input_high_water_mark_;
+    if (over && !input_over_mark_) {
+        _log_trace(myLog, "fd=%d pause reading, the input buffer has %d bytes", fd_, int(input_buffer_.length()));
+        input_over_mark_ = true;
+        UpdateReading();
+    }
+}
+
+// Enable or disable reading by the paused flags. The readiness based
+// backends disable the read event, and the io_uring one cancels the
+// receiving request, so the data is left in the socket buffer.
+void TCPConn::UpdateReading() {
+    assert(loop_->IsInLoopThread());
+    if (status_ != kConnected || read_eof_) {
+        return;
+    }
+
+    bool paused = read_paused_ || input_over_mark_;
+    if (recv_op_) {
+        if (paused && recv_op_->pending()) {
+            loop_->io_uring()->Cancel(recv_op_);
+        } else if (!paused && !recv_op_->pending()) {
+            loop_->io_uring()->Recv(recv_op_, fd_, shared_from_this());
+        }
+        return;
+    }
+
+    if (paused && chan_->IsReadable()) {
+        chan_->DisableReadEvent();
+    } else if (!paused && !chan_->IsReadable()) {
+        // An edge triggered fd is reported again if it has data
+        chan_->EnableReadEvent();
+    }
+    UpdateZeroCopyReaping();
+}
+
+// The zero-copy completions are reaped when the socket is reported. Neither
+// event is enabled while reading is paused and there is nothing to write,
+// so they are polled by a timer then, until they are all reaped.
+void TCPConn::UpdateZeroCopyReaping() {
+    bool polling = status_ == kConnected && output_buffer_.zerocopy_inflight()
+                   && !chan_->IsReadable() && !chan_->IsWritable();
+    if (polling && !zerocopy_reap_timer_) {
+        std::weak_ptr<TCPConn> weak_conn(shared_from_this());
+        auto f = [weak_conn]() {
+            TCPConnPtr c = weak_conn.lock();
+            if (c) {
+                c->ReapZeroCopy();
+            }
+        };
+        zerocopy_reap_timer_ = loop_->RunEvery(Duration(kZeroCopyReapInterval), Task(std::move(f)), InvokeTimer::kWheelTimer);
+    } else if (!polling && zerocopy_reap_timer_) {
+        zerocopy_reap_timer_->Cancel();
+        zerocopy_reap_timer_.reset();
+    }
+}
+
+void TCPConn::ReapZeroCopy() {
+    assert(loop_->IsInLoopThread());
+    output_buffer_.ReapZeroCopy(fd_);
+    UpdateZeroCopyReaping();
+}
+
+void TCPConn::PauseRead() {
+    if (!loop_->IsInLoopThread()) {
+        loop_->RunInLoop(Task(std::bind(&TCPConn::PauseRead, shared_from_this())));
+        return;
+    }
+
+    read_paused_ = true;
+    UpdateReading();
+}
+
+void TCPConn::ResumeRead() {
+    if (!loop_->IsInLoopThread()) {
+        loop_->RunInLoop(Task(std::bind(&TCPConn::ResumeRead, shared_from_this())));
+        return;
+    }
+
+    read_paused_ = false;
+    if (input_buffer_.length() > 0) {
+        // Not called from here, since it may be called by the MessageCallback.
+        // input_over_mark_ is checked again after the delivery.
+        loop_->QueueInLoop(Task(std::bind(&TCPConn::DeliverInput, shared_from_this())));
+    } else {
+        input_over_mark_ = false;
+    }
+    UpdateReading();
+}
+
+// The MessageCallback is called with the data buffered while reading is paused
+void TCPConn::DeliverInput() {
+    assert(loop_->IsInLoopThread());
+    if (status_ != kConnected || read_paused_) {
+        return;
+    }
+
+    if (input_buffer_.length() > 0) {
+        msg_fn_(shared_from_this(), &input_buffer_);
+        ShrinkInputBuffer();
+    }
+
+    if (input_over_mark_ && input_buffer_.length() < input_high_water_mark_) {
+        input_over_mark_ = false;
+        UpdateReading();
+    }
+}
+
+void TCPConn::SetInputHighWaterMark(size_t mark) {
+    assert(loop_->IsInLoopThread());
+    input_high_water_mark_ = mark;
+    if (mark == 0 && input_over_mark_) {
+        input_over_mark_ = false;
+        UpdateReading();
+    }
+}
+
+void TCPConn::HandleReadEOF() {
+    read_eof_ = true;
+    if (type() == kOutgoing) {
+        // This is an outgoing connection, we own it and it's done. so close it
+        _log_trace(myLog, "fd=%d. We read 0 bytes and close the socket.", fd_);
+        status_ = kDisconnecting;
+        HandleClose();
+    } else {
+        // Fix the half-closing problem : https://github.com/chenshuo/muduo/pull/117
+
+        chan_->DisableReadEvent();
+        UpdateZeroCopyReaping();
+        if (close_delay_.IsZero()) {
+            _log_trace(myLog, "channel (fd=%d) DisableReadEvent. delay time %lf s. We close this connection immediately",
+                       chan_->fd(), close_delay_.Seconds());
+            DelayClose();
+        } else {
+            // This is an incoming connection, we need to preserve the
+            // connection for a while so that we can reply to it.
+            // And we set a timer to close the connection eventually.
+            _log_trace(myLog, "channel (fd=%d) DisableReadEvent. And set a timer to delay close this TCPConn, delay time %lf s",
+                       chan_->fd(), close_delay_.Seconds());
+            delay_close_timer_ = loop_->RunAfter(close_delay_, Task(std::bind(&TCPConn::DelayClose, shared_from_this())), InvokeTimer::kWheelTimer); // TODO leave it to user layer close.
+        }
+    }
+}
+
 void TCPConn::HandleWrite() {
     assert(loop_->IsInLoopThread());
-    assert(!chan_->attached() || chan_->IsWritable());
+    if (output_buffer_.zerocopy_inflight()) {
+        output_buffer_.ReapZeroCopy(fd_);
+    }
 
-    ssize_t n = ::send(fd_, output_buffer_.data(), output_buffer_.length(), MSG_NOSIGNAL);
+    int serrno = 0;
+    ssize_t n = output_buffer_.WriteToFD(fd_, &serrno);
     if (n > 0) {
-        output_buffer_.Next(n);
-
         if (output_buffer_.length() == 0) {
-            chan_->DisableWriteEvent();
+            if (chan_->IsWritable()) {
+                chan_->DisableWriteEvent();
+            }
 
             if (write_complete_fn_) {
                 loop_->QueueInLoop(std::bind(write_complete_fn_, shared_from_this()));
             }
+            UpdateZeroCopyReaping();
+            return;
         }
     } else {
-        int serrno = errno;
-
         if (EVUTIL_ERR_RW_RETRIABLE(serrno)) {
             _log_warn(myLog, "TCPConn::HandleWrite errno=%d err=%s", serrno, strerror(serrno).c_str());
         } else {
             HandleError();
+            return;
+        }
+    }
+
+    WaitForWritable();
+    UpdateZeroCopyReaping();
+}
+
+void TCPConn::HandleIoUringRecv(int res, const char* data, bool more) {
+    assert(loop_->IsInLoopThread());
+    if (status_ != kConnected) {
+        return;
+    }
+
+    if (res > 0) {
+        input_buffer_.Append(data, static_cast<size_t>(res));
+        RecordReadSize(static_cast<size_t>(res));
+        msg_fn_(shared_from_this(), &input_buffer_);
+        ShrinkInputBuffer();
+        CheckInputHighWaterMark();
+    } else if (res == -ECANCELED) {
+        // Canceled by UpdateReading, which may have been resumed since then
+    } else if (res == 0) {
+        // The receiving request is finished, it is not submitted again
+        HandleReadEOF();
+        return;
+    } else if (res == -ENOBUFS) {
+        // The data has arrived but all the provided buffers are in use,
+        // read it into input_buffer_ directly as the readiness based backends do
+        HandleRead();
+    } else {
+        int serrno = -res;
+        if (EVUTIL_ERR_RW_RETRIABLE(serrno)) {
+            _log_trace(myLog, "errno=%d err=%s", serrno, strerror(serrno).c_str());
+        } else {
+            _log_trace(myLog, "errno=%d err=%s We are closing this connection now.", serrno, strerror(serrno).c_str());
+            HandleError();
+            return;
+        }
+    }
+
+    if (!more) {
+        UpdateReading();
+    }
+}
+
+void TCPConn::HandleIoUringSend(int res) {
+    assert(loop_->IsInLoopThread());
+    if (res < 0) {
+        int serrno = -res;
+        if (res != -ECANCELED && !EVUTIL_ERR_RW_RETRIABLE(serrno)) {
+            _log_err(myLog, "TCPConn::HandleIoUringSend errno=%d err=%s", serrno, strerror(serrno).c_str());
+            if (status_ == kConnected) {
+                HandleError();
+            }
+            return;
+        }
+    } else {
+        output_buffer_.Next(static_cast<size_t>(res));
+    }
+
+    if (status_ == kDisconnected) {
+        return;
+    }
+
+    if (output_buffer_.length() == 0) {
+        if (write_complete_fn_) {
+            loop_->QueueInLoop(std::bind(write_complete_fn_, shared_from_this()));
         }
+        return;
+    }
+
+    SendByIoUring();
+}
+
+void TCPConn::SendByIoUring() {
+    if (send_op_->pending()) {
+        // The data will be sent when the current request completes
+        return;
+    }
+
+    if (output_buffer_.length() == 0) {
+        return;
+    }
+
+    if (chan_->IsWritable() || (pipe_chan_ && pipe_chan_->IsReadable())) {
+        // A file block is being written by HandleWrite
+        return;
+    }
+
+    if (output_buffer_.front_is_file()) {
+        // It can't be sent by a request, it is written by sendfile or splice
+        // in HandleWrite when the socket is writable, and so is the data after it
+        chan_->EnableWriteEvent();
+        return;
+    }
+
+    // The data appended to the queue later doesn't move the data being sent
+    if (!loop_->io_uring()->Send(send_op_, fd_, output_buffer_.data(), output_buffer_.front_length(), shared_from_this())
+            && status_ == kConnected) {
+        HandleError();
     }
 }
 
@@ -298,9 +876,38 @@ void TCPConn::HandleClose() {
 
     status_ = kDisconnecting;
     assert(loop_->IsInLoopThread());
+
+    if (flush_scheduled_) {
+        // The data corked in this iteration is written before closing, as it
+        // would have been written by SendInLoop directly. The errors are ignored.
+        flush_scheduled_ = false;
+        if (send_op_) {
+            SendByIoUring();
+        } else if (!chan_->IsWritable()) {
+            int serrno = 0;
+            output_buffer_.WriteToFD(fd_, &serrno);
+        }
+    }
+
     chan_->DisableAllEvent();
     chan_->Close();
 
+    if (pipe_chan_) {
+        pipe_chan_->DisableAllEvent();
+        pipe_chan_->Close();
+    }
+
+    if (output_buffer_.zerocopy_inflight()) {
+        LingerZeroCopy();
+    }
+
+    if (recv_op_) {
+        // The in-flight sending request, if any, is not canceled, so the data
+        // sent before closing still goes out. The fd is closed in ~TCPConn
+        // after all the requests complete.
+        loop_->io_uring()->Cancel(recv_op_);
+    }
+
     TCPConnPtr conn(shared_from_this());
 
     if (delay_close_timer_) {
@@ -309,6 +916,11 @@ void TCPConn::HandleClose() {
         delay_close_timer_.reset();
     }
 
+    if (zerocopy_reap_timer_) {
+        zerocopy_reap_timer_->Cancel();
+        zerocopy_reap_timer_.reset();
+    }
+
     if (conn_fn_) {
         // This callback must be invoked at status kDisconnecting
         // e.g. when the TCPClient disconnects with remote server,
@@ -325,6 +937,31 @@ void TCPConn::HandleClose() {
     status_ = kDisconnected;
 }
 
+// The memory of the zero-copy sends MUST NOT be released before the completions,
+// even after the connection is closed. It is held by a ZeroCopyLinger then, and
+// the data queued but not sent yet is dropped, as it is without MSG_ZEROCOPY.
+void TCPConn::LingerZeroCopy() {
+#ifdef H_OS_LINUX
+    output_buffer_.ReapZeroCopy(fd_);
+    if (!output_buffer_.zerocopy_inflight()) {
+        return;
+    }
+
+    evpp_socket_t fd = ::dup(fd_);
+    if (fd < 0) {
+        int serrno = errno;
+        _log_err(myLog, "dup failed, the zero-copy sends are not waited for fd=%d errno=%d err=%s",
+                 fd_, serrno, strerror(serrno).c_str());
+        return;
+    }
+
+    // The peer reads the end of the stream after the data sent, as if the socket were closed
+    ::shutdown(fd, SHUT_WR);
+    output_buffer_.Reset();
+    ZeroCopyLinger::Start(loop_, fd, std::move(output_buffer_));
+#endif
+}
+
 void TCPConn::HandleError() {
     _log_warn(myLog, "fd=%d status=%s", fd_, StatusToString().c_str());
     status_ = kDisconnecting;
@@ -334,7 +971,7 @@ void TCPConn::HandleError() {
 void TCPConn::OnAttachedToLoop() {
     assert(loop_->IsInLoopThread());
     status_ = kConnected;
-    chan_->EnableReadEvent();
+    UpdateReading();
 
     if (conn_fn_) {
         conn_fn_(shared_from_this());
@@ -346,6 +983,27 @@ void TCPConn::SetHighWaterMarkCallback(const HighWaterMarkCallback& cb, size_t m
     high_water_mark_ = mark;
 }
 
+bool TCPConn::SetZeroCopyThreshold(size_t threshold) {
+    assert(loop_->IsInLoopThread());
+    if (threshold == 0) {
+        output_buffer_.set_zerocopy_threshold(0);
+        return true;
+    }
+
+#if defined(H_OS_LINUX) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    if (!send_op_) {
+        int on = 1;
+        if (::setsockopt(fd_, SOL_SOCKET, SO_ZEROCOPY, &on, sizeof(on)) == 0) {
+            output_buffer_.set_zerocopy_threshold(threshold);
+            return true;
+        }
+        int serrno = errno;
+        _log_warn(myLog, "SO_ZEROCOPY is not supported fd=%d errno=%d err=%s", fd_, serrno, strerror(serrno).c_str());
+    }
+#endif
+    return false;
+}
+
 void TCPConn::SetTCPNoDelay(bool on) {
     sock::SetTCPNoDelay(fd_, on);
 }
@@ -4,11 +4,14 @@
 
 #include "evpp/inner_pre.h"
 #include "evpp/buffer.h"
+#include "evpp/output_queue.h"
+#include "evpp/mpsc_queue.h"
 #include "evpp/tcp_callbacks.h"
 #include "evpp/slice.h"
 #include "evpp/any.h"
 #include "evpp/duration.h"
 #include "evpp/evlog.h"
+#include "evpp/io_uring_engine.h"
 
 namespace evpp {
 
@@ -44,12 +47,41 @@ public:
     void Send(const char* s) {
         Send(s, strlen(s));
     }
+    // @note When they are called by the threads other than the loop thread,
+    //  the data is copied once and handed over to the loop thread.
     void Send(const void* d, size_t dlen);
     void Send(const std::string& d);
     void Send(const Slice& message);
     void Send(Buffer* buf);
+
+    // @brief The same as above, but the memory of d or buf is taken over
+    //  without copying when they are called by the threads other than the
+    //  loop thread. buf is left empty.
+    void Send(std::string&& d);
+    void Send(Buffer&& buf);
+
+    // @brief Send the readable data of buf. The data which can't be sent
+    //  right now is queued without copying.
+    // @note buf is held until its data is sent, and it MUST NOT be modified before that.
     void Send(BufferPtr buf);
     void SendTotal(BufferPtr buf);
+
+    // @brief Send the bytes of s, e.g. a message decoded by Buffer::NextShared,
+    //  which are queued without copying as Send(BufferPtr) does.
+    void Send(const SharedSlice& s);
+
+    // @brief Send len bytes of the file fd from offset, in order with the data
+    //  of the other Send methods. It is written by sendfile(2) as the socket
+    //  becomes writable, and never read into the user space. If fd is a pipe,
+    //  offset is ignored and len bytes are moved from it by splice(2) as they arrive.
+    // @param holder - It is held until the data is sent or the connection is
+    //  closed, e.g. an object which closes fd in its destructor.
+    // @note fd MUST stay open until the data is sent, see WriteCompleteCallback.
+    //  The connection is closed if the file or the pipe ends before len bytes.
+    //  The data is read and copied on the platforms other than Linux, and the
+    //  pipes are only supported on Linux.
+    void SendFile(int fd, int64_t offset, size_t len,
+                  const std::shared_ptr<void>& holder = std::shared_ptr<void>());
 public:
     EventLoop* loop() const {
         return loop_;
@@ -130,11 +162,90 @@ public:
     void ReserveInputBuffer(size_t len) { input_buffer_.Reserve(len); }
     void ReserveOutputBuffer(size_t len) { output_buffer_.Reserve(len); }
 
+    // @brief Give the storage of the input and output buffers back to the
+    //  allocator if they are empty, e.g. when the connection is found idle.
+    //  The storage is allocated again at the next read or send, which is
+    //  cheap with a BufferPool, see Buffer::SetDefaultAllocator.
+    // @note It MUST be called in the loop thread.
+    void ReleaseBuffers();
+
+    // @brief Release the buffers whenever they become empty : the input buffer after
+    //  all the received data is consumed by the MessageCallback and the output
+    //  buffer after all the data is sent. It suits a large number of mostly idle
+    //  connections. It is off by default, and then the input buffer is only shrunk
+    //  when it is much larger than the recent reads need.
+    // @note It MUST be called in the loop thread.
+    void SetReleaseBuffersWhenIdle(bool on);
+
+    // @brief The bytes of the memory held by the input and output buffers of this
+    //  connection, which can be summed up to enforce a memory budget.
+    // @note It MUST be called in the loop thread.
+    size_t memory_footprint() const {
+        return input_buffer_.capacity() + output_buffer_.footprint();
+    }
+
     void SetWriteCompleteCallback(const WriteCompleteCallback cb) {
         write_complete_fn_ = cb;
     }
 
     void SetHighWaterMarkCallback(const HighWaterMarkCallback& cb, size_t mark);
+
+    // @brief Turn on or off the auto-cork mode. It is off by default.
+    //  When it is on, the data sent in a loop iteration is queued and written
+    //  by one writev right before the loop waits for the next events, instead of
+    //  one send per call. It suits the protocols which send many small messages
+    //  in one callback, e.g. the pipelined responses.
+    // @note It MUST be called in the loop thread.
+    void SetAutoCork(bool on) {
+        auto_cork_ = on;
+    }
+    bool auto_cork() const {
+        return auto_cork_;
+    }
+
+    // @brief Send the data queued without copying, by Send(BufferPtr) or
+    //  Send(const SharedSlice&), by MSG_ZEROCOPY if it is at least threshold bytes.
+    //  The kernel sends the pages of the memory directly instead of copying them
+    //  to the socket buffer, which pays off for the payloads of megabytes, and the
+    //  BufferPtr is held until the kernel reports the completion by the error queue
+    //  of the socket, which is reaped when the loop reports the socket. If the
+    //  connection is closed before that, the socket is kept open until it is reported.
+    // @param threshold - 0 turns it off, which is the default. 1MB is a good start.
+    // @return false if it is not supported, by the kernel (Linux 4.14 or later is
+    //  required) or by the io_uring backend, and the data is sent normally then.
+    // @note It MUST be called in the loop thread. It is turned off when the kernel
+    //  reports it copied the data anyway, e.g. on the loopback.
+    bool SetZeroCopyThreshold(size_t threshold);
+
+    // @brief Write the queued data now instead of at the end of the current
+    //  loop iteration, for the latency-critical messages in the auto-cork mode.
+    void Flush();
+
+    // @brief Stop reading from the socket. The data sent by the peer is left
+    //  in the socket buffer, and the TCP flow control slows the peer down when
+    //  it is full. It suits the MessageCallback which hands the messages over
+    //  to a slower worker, which calls ResumeRead when it catches up.
+    // @note They can be called in any thread.
+    void PauseRead();
+
+    // @brief Start reading again. If the input buffer is not empty, the
+    //  MessageCallback is called with it again in the next loop iteration.
+    void ResumeRead();
+
+    // @brief Pause reading automatically when the input buffer still has
+    //  mark bytes or more after the MessageCallback returns, i.e. the
+    //  application doesn't consume the data as fast as it arrives. Reading
+    //  is resumed by ResumeRead, which delivers the buffered data again.
+    // @param mark - 0 turns it off, which is the default.
+    // @note It MUST be called in the loop thread. With the io_uring backend,
+    //  the data already received by the kernel (up to the size of the provided
+    //  buffers, see IoUringEngine) is still delivered after the pause.
+    void SetInputHighWaterMark(size_t mark);
+
+    // Whether reading is paused, by PauseRead or by the input high-water mark
+    bool IsReadPaused() const {
+        return read_paused_ || input_over_mark_;
+    }
 protected:
     friend class TCPClient;
     friend class TCPServer;
@@ -157,15 +268,36 @@ protected:
     std::string StatusToString() const;
 private:
     void HandleRead();
+    size_t ExpectedReadSize() const;
+    void RecordReadSize(size_t n);
+    void ShrinkInputBuffer();
+    void CheckInputHighWaterMark();
+    void UpdateReading();
+    void UpdateZeroCopyReaping();
+    void ReapZeroCopy();
+    void DeliverInput();
+    void HandleReadEOF();
     void HandleWrite();
     void HandleClose();
     void DelayClose();
+    void LingerZeroCopy();
     void HandleError();
     void SendInLoop(const Slice& message);
     void SendInLoop(const void* data, size_t len);
-    void SendStringInLoop(const std::string& message);
-    void SendBufferInLoop(BufferPtr buf);
-    void SendTotalBufferInLoop(BufferPtr buf);
+    void SendInLoop(const void* data, size_t len, const std::shared_ptr<void>& holder);
+    void SendFileInLoop(int fd, int64_t offset, size_t len, const std::shared_ptr<void>& holder);
+    void OnOutputQueued(size_t old_len);
+    void WaitForWritable();
+    void HandlePipeReadable();
+    void QueueOutbound(const std::shared_ptr<void>& holder, const void* data, size_t len);
+    struct OutboundMessage;
+    void QueueOutbound(OutboundMessage&& m);
+    void DrainOutbound();
+
+    // The I/O by the IoUringEngine of loop_, see EventLoop::kIoUring
+    void HandleIoUringRecv(int res, const char* data, bool more);
+    void HandleIoUringSend(int res);
+    void SendByIoUring();
 
 protected:
     logger* myLog{nullptr};
@@ -179,7 +311,41 @@ private:
     std::string remote_addr_; // the remote address with form : "ip:port"
     std::unique_ptr<FdChannel> chan_;
     Buffer input_buffer_;
-    Buffer output_buffer_; // TODO use a list<Slice> ??
+    OutputQueue output_buffer_;
+
+    // The moving average of the sizes of the recent reads, which sizes the next read
+    size_t read_size_ema_ = 0;
+    bool release_buffers_when_idle_ = false;
+
+    // The reading is paused if either of them is set, see UpdateReading
+    bool read_paused_ = false; // By PauseRead
+    bool input_over_mark_ = false; // By input_high_water_mark_
+    bool read_eof_ = false;
+    size_t input_high_water_mark_ = 0;
+    enum {
+        kMaxExpectedReadSize = 64 * 1024, // The same as the extra buffer of Buffer::ReadFromFD
+    };
+
+    // Only used by the io_uring backend. The first block of output_buffer_
+    // is sent by one request at a time.
+    IoUringEngine::OperationPtr recv_op_;
+    IoUringEngine::OperationPtr send_op_;
+
+    // Watches the pipe which the head of output_buffer_ is waiting
+    // for, see SendFile and OutputQueue::blocked_fd
+    std::unique_ptr<FdChannel> pipe_chan_;
+
+    // The data sent by the threads other than the loop thread, which
+    // is held by holder and drained to output_buffer_ in the loop thread.
+    struct OutboundMessage {
+        std::shared_ptr<void> holder;
+        const char* data;
+        size_t len;
+        int file_fd; // Not -1 if it is sent by SendFile
+        int64_t offset;
+    };
+    MPSCQueue<OutboundMessage> outbound_;
+    std::atomic<bool> outbound_scheduled_; // A DrainOutbound task is queued
 
     enum { kContextCount = 16, };
     Any context_[kContextCount];
@@ -187,10 +353,14 @@ private:
     std::atomic<Status> status_;
     size_t high_water_mark_ = 128 * 1024 * 1024; // Default 128MB
 
+    bool auto_cork_ = false;
+    bool flush_scheduled_ = false; // A Flush is queued by EventLoop::RunBeforeWait
+
     // The delay time to close a incoming connection which has been shutdown by peer normally.
     // Default is 0 second which means we disable this feature by default.
     Duration close_delay_ = Duration(0.0);
     std::shared_ptr<InvokeTimer> delay_close_timer_; // The timer to delay close this TCPConn
+    std::shared_ptr<InvokeTimer> zerocopy_reap_timer_; // See UpdateZeroCopyReaping
 
     ConnectionCallback conn_fn_; // This will be called to the user application layer
     MessageCallback msg_fn_; // This will be called to the user application layer
@@ -4,6 +4,7 @@
 #include "evpp/listener.h"
 #include "evpp/tcp_conn.h"
 #include "evpp/libevent.h"
+#include "evpp/sockets.h"
 
 #include <condition_variable>
 #include <mutex>
@@ -18,14 +19,15 @@ TCPServer::TCPServer(EventLoop* loop,
     , name_(name)
     , conn_fn_(&internal::DefaultConnectionCallback)
     , msg_fn_(&internal::DefaultMessageCallback)
-    , next_conn_id_(0) {
+    , next_conn_id_(0)
+    , connection_count_(0) {
     _log_trace(myLog, "name=%s listening addr %s thread_num %d", name.c_str(), laddr.c_str(), thread_num);
     tpool_.reset(new EventLoopThreadPool(loop_, thread_num));
 }
 
 TCPServer::~TCPServer() {
     // DLOG_TRACE;
-    assert(connections_.empty());
+    assert(connection_count_.load() == 0);
     assert(!listener_);
     if (tpool_) {
         assert(tpool_->IsStopped());
@@ -36,12 +38,42 @@ TCPServer::~TCPServer() {
 bool TCPServer::Init() {
     // DLOG_TRACE;
     assert(status_ == kNull);
-    listener_.reset(new Listener(loop_, listen_addr_));
-    listener_->Listen();
+    if (!reuse_port_listeners_) {
+        listener_.reset(new Listener(loop_, listen_addr_));
+        listener_->Listen();
+    }
     status_.store(kInitialized);
     return true;
 }
 
+void TCPServer::SetReusePortListeners(bool on, bool cpu_steering) {
+    assert(status_ == kNull || status_ == kInitialized);
+#ifdef H_OS_LINUX
+    if (on && tpool_->thread_num() == 0) {
+        _log_warn(myLog, "name=%s There is no working loop, accept the connections in the listening loop", name_.c_str());
+        on = false;
+    }
+#else
+    if (on) {
+        _log_warn(myLog, "name=%s The listeners by SO_REUSEPORT are only supported on Linux", name_.c_str());
+        on = false;
+    }
+#endif
+
+    if (status_ == kInitialized && on != reuse_port_listeners_) {
+        // The listener of the listening loop has been created by Init
+        if (on) {
+            listener_.reset();
+        } else {
+            listener_.reset(new Listener(loop_, listen_addr_));
+            listener_->Listen();
+        }
+    }
+
+    reuse_port_listeners_ = on;
+    cpu_steering_ = on && cpu_steering;
+}
+
 void TCPServer::AfterFork() {
     tpool_->AfterFork();
 }
@@ -50,16 +82,21 @@ bool TCPServer::Start() {
     // DLOG_TRACE;
     assert(status_ == kInitialized);
     status_.store(kStarting);
-    assert(listener_.get());
+    assert(listener_.get() || reuse_port_listeners_);
     bool rc = tpool_->Start(true);
     if (rc) {
+        CreateShards();
+    }
+
+    if (rc && reuse_port_listeners_) {
+        ListenInLoops();
+    } else if (rc) {
         assert(tpool_->IsRunning());
-        listener_->SetNewConnectionCallback(
-            std::bind(&TCPServer::HandleNewConn,
+        listener_->SetAcceptBudget(accept_budget_);
+        listener_->SetNewConnectionsCallback(
+            std::bind(&TCPServer::HandleNewConns,
                       this,
-                      std::placeholders::_1,
-                      std::placeholders::_2,
-                      std::placeholders::_3));
+                      std::placeholders::_1));
 
         // We must set status_ to kRunning firstly and then we can accept new
         // connections. If we use the following code :
@@ -121,33 +158,31 @@ void TCPServer::Stop(bool wait_thread_exited, DoneCallback on_stopped_cb)
 void TCPServer::StopInLoop(DoneCallback on_stopped_cb) {
     _log_trace(myLog, "Entering ...");
     assert(loop_->IsInLoopThread());
-    listener_->Stop();
-    listener_.reset();
+    if (listener_) {
+        listener_->Stop();
+        listener_.reset();
+    }
 
-    if (connections_.empty()) {
+    if (!reuse_port_listeners_ && connection_count_.load() == 0) {
+        // No connection is left in the working loops, and no more will come.
         // Stop all the working threads now.
         _log_trace(myLog, "no connections");
         StopThreadPool();
+        shards_.clear();
+        shard_of_loop_.clear();
         if (on_stopped_cb) {
             on_stopped_cb();
             on_stopped_cb = DoneCallback();
         }
         status_.store(kStopped);
     } else {
+        // Every loop stops its listener, if any, and closes its connections.
+        // The working threads will be stopped after all of them are done.
         _log_trace(myLog, "close connections");
-        for (auto& c : connections_) {
-            if (c.second->IsConnected()) {
-                _log_trace(myLog, "close connection id=%d fd=%d", c.second->id(), c.second->fd());
-                c.second->Close();
-            } else {
-                _log_trace(myLog, "Do not need to call Close for this TCPConn it may be doing disconnecting."
-                           " fd=%d status=%s", c.second->fd(), StatusToString().c_str());
-            }
-        }
-
         stopped_cb_ = on_stopped_cb;
-
-        // The working threads will be stopped after all the connections closed.
+        for (auto& sh : shards_) {
+            sh->loop->RunInLoop(std::bind(&TCPServer::StopShard, this, sh.get()));
+        }
     }
 
     _log_trace(myLog, "exited, status=%s", StatusToString().c_str());
@@ -180,50 +215,248 @@ void TCPServer::HandleNewConn(evpp_socket_t sockfd,
     }
 
     assert(IsRunning());
-    EventLoop* io_loop = GetNextLoop(raddr);
+    EventLoop* io_loop = GetNextLoop(sockfd, raddr);
+    TCPConnPtr conn = NewConn(io_loop, sockfd, remote_addr);
+    io_loop->RunInLoop(std::bind(&TCPServer::AttachConn, this, GetShard(io_loop), conn));
+}
+
+// It is counted right away, so the server knows there are connections
+// to be closed when it stops before they are attached to their loops.
+TCPConnPtr TCPServer::NewConn(EventLoop* io_loop, evpp_socket_t sockfd, const std::string& remote_addr) {
+    uint64_t id = ++next_conn_id_;
+    connection_count_.fetch_add(1, std::memory_order_relaxed);
+    tpool_->AddLoad(io_loop, 1);
+    if (socket_busy_poll_us_ > 0 && !sock::SetBusyPoll(sockfd, socket_busy_poll_us_)) {
+        _log_warn(myLog, "setsockopt(SO_BUSY_POLL) failed, fd=%d errno=%d", sockfd, errno);
+    }
 #ifdef H_DEBUG_MODE
-    std::string n = name_ + "-" + remote_addr + "#" + std::to_string(next_conn_id_);
+    std::string n = name_ + "-" + remote_addr + "#" + std::to_string(id - 1);
 #else
     std::string n = remote_addr;
 #endif
-    ++next_conn_id_;
-    TCPConnPtr conn(new TCPConn(io_loop, n, sockfd, listen_addr_, remote_addr, next_conn_id_));
+    TCPConnPtr conn(new TCPConn(io_loop, n, sockfd, listen_addr_, remote_addr, id));
     assert(conn->type() == TCPConn::kIncoming);
     conn->SetMessageCallback(msg_fn_);
     conn->SetConnectionCallback(conn_fn_);
-    conn->SetCloseCallback(std::bind(&TCPServer::RemoveConnection, this, std::placeholders::_1));
-    io_loop->RunInLoop(std::bind(&TCPConn::OnAttachedToLoop, conn));
-    connections_[conn->id()] = conn;
+    return conn;
+}
+
+TCPServer::LoopShard* TCPServer::GetShard(EventLoop* io_loop) const {
+    auto it = shard_of_loop_.find(io_loop);
+    assert(it != shard_of_loop_.end());
+    return it->second;
+}
+
+// One shard for every working loop, or one for the listening loop, which is
+// where the connections go when there is no working loop.
+void TCPServer::CreateShards() {
+    assert(tpool_->IsRunning());
+    uint32_t n = std::max(tpool_->thread_num(), uint32_t(1));
+    for (uint32_t i = 0; i < n; i++) {
+        std::unique_ptr<LoopShard> sh(new LoopShard);
+        sh->loop = tpool_->GetNextLoopWithHash(i);
+        sh->stopping = false;
+        shard_of_loop_[sh->loop] = sh.get();
+        shards_.push_back(std::move(sh));
+    }
+    live_shards_ = n;
+}
+
+void TCPServer::AttachConn(LoopShard* s, const TCPConnPtr& conn) {
+    assert(s->loop->IsInLoopThread());
+    assert(!s->stopping);
+    conn->SetCloseCallback(std::bind(&TCPServer::RemoveConnection, this, s, std::placeholders::_1));
+    s->connections.Insert(conn);
+    conn->OnAttachedToLoop();
+}
+
+void TCPServer::ForEachConnection(const ConnectionCallback& fn) {
+    assert(IsRunning());
+    for (auto& sh : shards_) {
+        LoopShard* s = sh.get();
+        s->loop->RunInLoop([s, fn]() {
+            // Copied out, since fn may close the connections
+            std::vector<TCPConnPtr> conns;
+            conns.reserve(s->connections.size());
+            s->connections.ForEach([&conns](const TCPConnPtr& c) {
+                conns.push_back(c);
+            });
+
+            for (auto& c : conns) {
+                fn(c);
+            }
+        });
+    }
+}
+
+void TCPServer::Broadcast(const Slice& msg) {
+    BufferPtr buf(new Buffer(msg.size(), 0));
+    buf->Append(msg.data(), msg.size());
+    ForEachConnection([buf](const TCPConnPtr& conn) {
+        conn->Send(buf);
+    });
+}
+
+// Every working loop listens on the same address, in the order of the loops,
+// which is also the order of the listeners in the SO_REUSEPORT group.
+void TCPServer::ListenInLoops() {
+    for (auto& sh : shards_) {
+        LoopShard* s = sh.get();
+        s->listener.reset(new Listener(s->loop, listen_addr_));
+        s->listener->Listen();
+        s->listener->SetAcceptBudget(accept_budget_);
+        s->listener->SetNewConnectionCallback(
+            std::bind(&TCPServer::HandleNewConnInLoop,
+                      this,
+                      s,
+                      std::placeholders::_1,
+                      std::placeholders::_2));
+    }
+
+    if (cpu_steering_ && !sock::AttachReusePortCPUFilter(shards_[0]->listener->fd(), uint32_t(shards_.size()))) {
+        _log_warn(myLog, "name=%s Steering the connections by CPU is not supported", name_.c_str());
+    }
+
+    status_.store(kRunning);
+    for (auto& sh : shards_) {
+        sh->listener->Accept();
+    }
+}
+
+void TCPServer::HandleNewConnInLoop(LoopShard* s, evpp_socket_t sockfd, const std::string& remote_addr) {
+    _log_trace(myLog, "fd=%d", sockfd);
+    assert(s->loop->IsInLoopThread());
+    if (IsStopping() || s->stopping) {
+        _log_warn(myLog, "The server is at stopping status. Discard this socket fd=%d remote_addr=%s",
+                  sockfd, remote_addr.c_str());
+        EVUTIL_CLOSESOCKET(sockfd);
+        return;
+    }
+
+    AttachConn(s, NewConn(s->loop, sockfd, remote_addr));
+}
+
+void TCPServer::RemoveConnection(LoopShard* s, const TCPConnPtr& conn) {
+    _log_trace(myLog, "fd=%d connections.size()=%d", conn->fd(), int(s->connections.size()));
+    assert(s->loop->IsInLoopThread());
+    s->connections.Erase(conn->id());
+    tpool_->AddLoad(s->loop, -1);
+    connection_count_.fetch_sub(1, std::memory_order_relaxed);
+    if (s->stopping && s->connections.empty()) {
+        loop_->QueueInLoop(std::bind(&TCPServer::OnShardStopped, this));
+    }
+}
+
+// The listening loop is told by a queued task, so the shards are never
+// destroyed while any of their methods is running.
+void TCPServer::StopShard(LoopShard* s) {
+    assert(s->loop->IsInLoopThread());
+    if (s->listener) {
+        s->listener->Stop();
+        s->listener.reset();
+    }
+    s->stopping = true;
+
+    if (s->connections.empty()) {
+        loop_->QueueInLoop(std::bind(&TCPServer::OnShardStopped, this));
+        return;
+    }
+
+    // They are closed right here, which removes them from s->connections.
+    // The last one tells the listening loop this shard is stopped.
+    std::vector<TCPConnPtr> conns;
+    conns.reserve(s->connections.size());
+    s->connections.ForEach([&conns](const TCPConnPtr& c) {
+        conns.push_back(c);
+    });
+
+    for (auto& c : conns) {
+        if (c->IsConnected()) {
+            _log_trace(myLog, "close connection id=%d fd=%d", c->id(), c->fd());
+            c->Close();
+        } else {
+            _log_trace(myLog, "Do not need to call Close for this TCPConn it may be doing disconnecting."
+                       " fd=%d status=%s", c->fd(), c->StatusToString().c_str());
+        }
+    }
+}
+
+void TCPServer::OnShardStopped() {
+    assert(loop_->IsInLoopThread());
+    assert(live_shards_ > 0);
+    if (--live_shards_ > 0) {
+        return;
+    }
+
+    // At last, we stop all the working threads
+    StopThreadPool();
+    shards_.clear();
+    shard_of_loop_.clear();
+    if (stopped_cb_) {
+        stopped_cb_();
+        stopped_cb_ = DoneCallback();
+    }
+    status_.store(kStopped);
 }
 
-EventLoop* TCPServer::GetNextLoop(const struct sockaddr_in* raddr) {
+// The connections accepted by one wakeup of the listener are handed over
+// to the working loops by one task per loop, instead of one per connection.
+void TCPServer::HandleNewConns(std::vector<Listener::AcceptedConn>& accepted) {
+    assert(loop_->IsInLoopThread());
+    if (IsStopping()) {
+        for (auto& a : accepted) {
+            _log_warn(myLog, "The server is at stopping status. Discard this socket fd=%d remote_addr=%s",
+                      a.fd, a.remote_addr.c_str());
+            EVUTIL_CLOSESOCKET(a.fd);
+        }
+        return;
+    }
+
+    if (accepted.size() == 1) {
+        HandleNewConn(accepted[0].fd, accepted[0].remote_addr, sock::sockaddr_in_cast(&accepted[0].ss));
+        return;
+    }
+
+    assert(IsRunning());
+    std::vector<std::pair<LoopShard*, std::vector<TCPConnPtr>>> batches;
+    for (auto& a : accepted) {
+        EventLoop* io_loop = GetNextLoop(a.fd, sock::sockaddr_in_cast(&a.ss));
+        LoopShard* sh = GetShard(io_loop);
+        auto it = batches.begin();
+        while (it != batches.end() && it->first != sh) {
+            ++it;
+        }
+        if (it == batches.end()) {
+            batches.push_back(std::make_pair(sh, std::vector<TCPConnPtr>()));
+            it = batches.end() - 1;
+        }
+        it->second.push_back(NewConn(io_loop, a.fd, a.remote_addr));
+    }
+
+    for (auto& b : batches) {
+        LoopShard* sh = b.first;
+        auto conns = std::make_shared<std::vector<TCPConnPtr>>(std::move(b.second));
+        sh->loop->RunInLoop([this, sh, conns]() {
+            for (auto& c : *conns) {
+                AttachConn(sh, c);
+            }
+        });
+    }
+}
+
+EventLoop* TCPServer::GetNextLoop(evpp_socket_t sockfd, const struct sockaddr_in* raddr) {
+    if (incoming_cpu_steering_ && tpool_->placed()) {
+        EventLoop* loop = tpool_->GetLoopForCPU(sock::GetIncomingCPU(sockfd));
+        if (loop) {
+            return loop;
+        }
+    }
+
     if (IsRoundRobin()) {
         return tpool_->GetNextLoop();
     } else {
-        return tpool_->GetNextLoopWithHash(raddr->sin_addr.s_addr);
-    }
-}
-
-void TCPServer::RemoveConnection(const TCPConnPtr& conn) {
-    _log_trace(myLog, "fd=%d connections_.size()=%d", conn->fd(), connections_.size());
-    auto f = [this, conn]() {
-        // Remove the connection in the listening EventLoop
-        _log_trace(myLog, "fd=%d connections_.size()=%d", conn->fd(), connections_.size());
-        assert(this->loop_->IsInLoopThread());
-        this->connections_.erase(conn->id());
-        if (IsStopping() && this->connections_.empty()) {
-            // At last, we stop all the working threads
-            _log_trace(myLog, "Stop thread pool");
-            assert(substatus_.load() == kStoppingListener);
-            StopThreadPool();
-            if (stopped_cb_) {
-                stopped_cb_();
-                stopped_cb_ = DoneCallback();
-            }
-            status_.store(kStopped);
-        }
-    };
-    loop_->RunInLoop(f);
+        return tpool_->GetNextLoop(policy_, raddr->sin_addr.s_addr);
+    }
 }
 
 }
@@ -4,17 +4,19 @@
 #include "evpp/event_loop.h"
 #include "evpp/event_loop_thread_pool.h"
 #include "evpp/tcp_callbacks.h"
+#include "evpp/slice.h"
 
 #include "evpp/thread_dispatch_policy.h"
 #include "evpp/server_status.h"
+#include "evpp/listener.h"
+#include "evpp/connection_table.h"
 #include "evpp/evlog.h"
 
 #include <map>
+#include <vector>
 
 namespace evpp {
 
-class Listener;
-
 // We can use this class to create a TCP server.
 // The typical usage is :
 //      1. Create a TCPServer object
@@ -99,20 +101,96 @@ public:
         msg_fn_ = cb;
     }
 
+    // @brief Accept the connections in every working loop by a listener of its
+    //  own, instead of accepting all of them in the listening loop and handing
+    //  them over to the working loops. The listeners are bound to the same
+    //  address by SO_REUSEPORT, and the kernel distributes the connections among
+    //  them, by the hash of the addresses by default. The connections accepted by
+    //  a loop are managed in it, so the listening loop is not involved at all.
+    //  ThreadDispatchPolicy is ignored then.
+    // @param on - It is off by default
+    // @param cpu_steering - Choose the listener by the CPU which handles the
+    //  packets of the connection, see sock::AttachReusePortCPUFilter. It suits
+    //  the working loops pinned to the CPUs receiving the packets.
+    // @note It MUST be called before Start. It only works on Linux, and
+    //  it is ignored when thread_num is 0.
+    void SetReusePortListeners(bool on, bool cpu_steering = false);
+
+    // @brief The most connections accepted by a listener in one wakeup,
+    //  see Listener::SetAcceptBudget.
+    // @note It MUST be called before Start.
+    void SetAcceptBudget(int n) {
+        assert(n > 0);
+        accept_budget_ = n;
+    }
+
+    // @brief Hand a connection over to the working loop placed nearest to the
+    //  CPU receiving its packets (SO_INCOMING_CPU), so the loop runs on the
+    //  NUMA node of the NIC queue. It needs the loops placed by
+    //  EventLoopThreadPool::SetCPUAffinity or SpreadAcrossNUMANodes, see
+    //  EventLoopThreadPool::GetLoopForCPU. ThreadDispatchPolicy is used when
+    //  no loop is near the CPU, or SO_INCOMING_CPU is not supported.
+    // @param on - It is off by default
+    // @note It MUST be called before Start.
+    void SetIncomingCPUSteering(bool on) {
+        incoming_cpu_steering_ = on;
+    }
+
+    // @brief Set SO_BUSY_POLL of usec microseconds on the accepted sockets, see
+    //  sock::SetBusyPoll. It suits the working loops which busy poll as well,
+    //  see EventLoopThreadPool::SetBusyPoll. It is 0 by default, i.e. not set.
+    // @note It MUST be called before Start.
+    void SetSocketBusyPoll(int usec) {
+        socket_busy_poll_us_ = usec;
+    }
+
+    // The pool of the working loops, which can be placed on the CPUs before Start
+    std::shared_ptr<EventLoopThreadPool> pool() const {
+        return tpool_;
+    }
+
+    // @brief Call fn with every connection, in the loop of that connection.
+    //  The loops call it concurrently, and it returns before they are done.
+    // @note It can be called in any thread while the server is running.
+    void ForEachConnection(const ConnectionCallback& fn);
+
+    // @brief Send msg to every connection. It is copied once, and
+    //  the copy is shared by all the connections without copying.
+    void Broadcast(const Slice& msg);
+
 public:
     const std::string& listen_addr() const {
         return listen_addr_;
     }
 
+    // The count of the connections, which can be read in any thread
+    size_t connection_count() const {
+        return connection_count_.load(std::memory_order_relaxed);
+    }
+
 protected:
     logger* myLog{nullptr};
 
 private:
+    struct LoopShard;
     void StopThreadPool();
     void StopInLoop(DoneCallback on_stopped_cb);
-    void RemoveConnection(const TCPConnPtr& conn);
     void HandleNewConn(evpp_socket_t sockfd, const std::string& remote_addr/*ip:port*/, const struct sockaddr_in* raddr);
-    EventLoop* GetNextLoop(const struct sockaddr_in* raddr);
+    void HandleNewConns(std::vector<Listener::AcceptedConn>& accepted);
+    EventLoop* GetNextLoop(evpp_socket_t sockfd, const struct sockaddr_in* raddr);
+    TCPConnPtr NewConn(EventLoop* io_loop, evpp_socket_t sockfd, const std::string& remote_addr);
+    LoopShard* GetShard(EventLoop* io_loop) const;
+
+    // The connections are managed by the loops they belong to
+    void CreateShards();
+    void AttachConn(LoopShard* s, const TCPConnPtr& conn);
+    void RemoveConnection(LoopShard* s, const TCPConnPtr& conn);
+    void StopShard(LoopShard* s);
+    void OnShardStopped();
+
+    // The per loop listeners, see SetReusePortListeners
+    void ListenInLoops();
+    void HandleNewConnInLoop(LoopShard* s, evpp_socket_t sockfd, const std::string& remote_addr);
 private:
     EventLoop* loop_;  // the listening loop
     const std::string listen_addr_; // ip:port
@@ -124,9 +202,26 @@ private:
 
     DoneCallback stopped_cb_;
 
-    // always in the listening loop thread
-    uint64_t next_conn_id_ = 0;
-    typedef std::map<uint64_t/*the id of the connection*/, TCPConnPtr> ConnectionMap;
-    ConnectionMap connections_;
+    std::atomic<uint64_t> next_conn_id_;
+    std::atomic<size_t> connection_count_;
+
+    // The connections of a working loop (or the listening loop when thread_num is 0),
+    // which are only accessed in that loop, so closing a connection doesn't involve
+    // the listening loop. The listener is the one of SetReusePortListeners.
+    struct LoopShard {
+        EventLoop* loop;
+        std::unique_ptr<Listener> listener;
+        ConnectionTable connections;
+        bool stopping;
+    };
+    std::vector<std::unique_ptr<LoopShard>> shards_; // Created by Start, in the order of the loops
+    std::map<EventLoop*, LoopShard*> shard_of_loop_;
+    uint32_t live_shards_ = 0; // The shards not stopped yet, in the listening loop thread
+
+    int accept_budget_ = Listener::kDefaultAcceptBudget;
+    bool reuse_port_listeners_ = false;
+    bool cpu_steering_ = false;
+    bool incoming_cpu_steering_ = false;
+    int socket_busy_poll_us_ = 0;
 };
 }
\ No newline at end of file
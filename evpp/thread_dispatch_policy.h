@@ -6,6 +6,16 @@ public:
     enum Policy {
         kRoundRobin,
         kIPAddressHashing,
+
+        // The load aware ones, see EventLoopThreadPool::GetNextLoop(Policy, uint64_t)
+        kLeastConnections,      // The loop with the least load, i.e. the connections or the requests in process
+        kLeastPendingFunctors,  // The loop with the least tasks waiting in its queue, see EventLoop::pending_functor_count
+        kPowerOfTwoChoices,     // The less loaded one of two random loops, which avoids the herding of the least ones
+
+        // The address hashing which only moves 1/n of the addresses to other
+        // loops when the count of the loops changes, e.g. after a restart with
+        // more threads, so the state cached per loop mostly stays valid
+        kConsistentHashing,
     };
 
     ThreadDispatchPolicy() : policy_(kRoundRobin) {}
@@ -17,6 +27,10 @@ public:
     bool IsRoundRobin() const {
         return policy_ == kRoundRobin;
     }
+
+    Policy policy() const {
+        return policy_;
+    }
 protected:
     Policy policy_;
 };
@@ -0,0 +1,258 @@
+#include "evpp/inner_pre.h"
+
+#include <chrono>
+
+#include "evpp/timing_wheel.h"
+#include "evpp/event_watcher.h"
+#include "evpp/event_loop.h"
+
+namespace evpp {
+
+TimingWheel::TimingWheel(EventLoop* loop, Duration tick)
+    : loop_(loop), tick_ns_(tick.Nanoseconds()), current_(0), size_(0), armed_(false), armed_tick_(0) {
+    assert(tick_ns_ > 0);
+    origin_ns_ = NowNanoseconds();
+
+    for (size_t i = 0; i < kRootSize; i++) {
+        InitSlot(&root_[i]);
+    }
+
+    for (size_t level = 0; level < kLevels; level++) {
+        for (size_t i = 0; i < kLevelSize; i++) {
+            InitSlot(&levels_[level][i]);
+        }
+    }
+
+    memset(root_bitmap_, 0, sizeof(root_bitmap_));
+
+    timer_.reset(new TimerEventWatcher(loop_, std::bind(&TimingWheel::OnTick, this), tick));
+    timer_->Init();
+}
+
+TimingWheel::~TimingWheel() {
+    // Detach the remaining nodes, they are owned by their creators
+    for (size_t i = 0; i < kRootSize; i++) {
+        while (!IsSlotEmpty(&root_[i])) {
+            Unlink(root_[i].next);
+        }
+    }
+
+    for (size_t level = 0; level < kLevels; level++) {
+        for (size_t i = 0; i < kLevelSize; i++) {
+            while (!IsSlotEmpty(&levels_[level][i])) {
+                Unlink(levels_[level][i].next);
+            }
+        }
+    }
+
+    timer_.reset();
+}
+
+void TimingWheel::Add(Node* n, Duration delay) {
+    assert(loop_->IsInLoopThread());
+    Remove(n);
+
+    if (size_ == 0) {
+        // The wheel is empty, so we can jump over the idle ticks at once
+        uint64_t now = NowTick();
+        if (current_ < now) {
+            current_ = now;
+        }
+    }
+
+    int64_t d = delay.Nanoseconds();
+    if (d < 0) {
+        d = 0;
+    }
+
+    // Round up, so a timer never expires earlier than its delay
+    int64_t deadline = NowNanoseconds() - origin_ns_ + d;
+    n->expire_ = static_cast<uint64_t>((deadline + tick_ns_ - 1) / tick_ns_);
+    Insert(n);
+    ++size_;
+    Schedule();
+}
+
+void TimingWheel::Remove(Node* n) {
+    if (!n->linked()) {
+        return;
+    }
+
+    // The bit of root_bitmap_ is left as it is, NextTick() clears the stale bits
+    Unlink(n);
+    assert(size_ > 0);
+    --size_;
+}
+
+int64_t TimingWheel::NowNanoseconds() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t TimingWheel::NowTick() const {
+    return static_cast<uint64_t>((NowNanoseconds() - origin_ns_) / tick_ns_);
+}
+
+void TimingWheel::Insert(Node* n) {
+    uint64_t expire = n->expire_;
+    if (expire < current_) {
+        // It is already expired, run it at the next processed tick
+        expire = current_;
+    }
+
+    uint64_t idx = expire - current_;
+    if (idx < kRootSize) {
+        size_t i = static_cast<size_t>(expire & kRootMask);
+        root_bitmap_[i / 64] |= (1ULL << (i % 64));
+        PushBack(&root_[i], n);
+        return;
+    }
+
+    if (idx > kMaxTicks) {
+        // Too far away. It is cascaded down again and again
+        // until it falls into the range of the wheel.
+        expire = current_ + kMaxTicks;
+        idx = kMaxTicks;
+    }
+
+    for (size_t level = 0; level < kLevels; level++) {
+        size_t shift = kRootBits + level * kLevelBits;
+        if (idx < (1ULL << (shift + kLevelBits))) {
+            PushBack(&levels_[level][(expire >> shift) & kLevelMask], n);
+            return;
+        }
+    }
+
+    assert(false && "never goes here");
+}
+
+void TimingWheel::Unlink(Link* n) {
+    n->prev->next = n->next;
+    n->next->prev = n->prev;
+    n->prev = nullptr;
+    n->next = nullptr;
+}
+
+void TimingWheel::InitSlot(Link* head) {
+    head->prev = head;
+    head->next = head;
+}
+
+void TimingWheel::PushBack(Link* head, Link* n) {
+    n->prev = head->prev;
+    n->next = head;
+    head->prev->next = n;
+    head->prev = n;
+}
+
+void TimingWheel::MoveSlot(Link* from, Link* to) {
+    if (IsSlotEmpty(from)) {
+        InitSlot(to);
+        return;
+    }
+
+    to->next = from->next;
+    to->prev = from->prev;
+    to->next->prev = to;
+    to->prev->next = to;
+    InitSlot(from);
+}
+
+size_t TimingWheel::Cascade(int level) {
+    size_t index = static_cast<size_t>((current_ >> (kRootBits + level * kLevelBits)) & kLevelMask);
+    Link list;
+    MoveSlot(&levels_[level][index], &list);
+    while (!IsSlotEmpty(&list)) {
+        Link* l = list.next;
+        Unlink(l);
+        Insert(static_cast<Node*>(l));
+    }
+    return index;
+}
+
+void TimingWheel::OnTick() {
+    armed_ = false;
+    uint64_t now = NowTick();
+    while (current_ <= now && size_ > 0) {
+        size_t index = static_cast<size_t>(current_ & kRootMask);
+        if (index == 0) {
+            // The root wraps around, cascade the upper levels down
+            for (int level = 0; level < kLevels && Cascade(level) == 0; level++) {
+            }
+        }
+
+        Link expired;
+        MoveSlot(&root_[index], &expired);
+        root_bitmap_[index / 64] &= ~(1ULL << (index % 64));
+        ++current_;
+
+        // The callbacks may add or remove any other nodes, even the ones in expired
+        while (!IsSlotEmpty(&expired)) {
+            Node* n = static_cast<Node*>(expired.next);
+            Unlink(n);
+            --size_;
+            n->OnWheelTimeout();
+        }
+    }
+
+    if (size_ == 0 && current_ <= now) {
+        current_ = now + 1;
+    }
+
+    Schedule();
+}
+
+uint64_t TimingWheel::NextTick() {
+    size_t index = static_cast<size_t>(current_ & kRootMask);
+    if (index == 0) {
+        // The upper levels are cascaded down at this tick
+        return current_;
+    }
+
+    for (size_t i = index; i < kRootSize; i++) {
+        uint64_t word = root_bitmap_[i / 64] >> (i % 64);
+        if (word == 0) {
+            // Skip to the next word
+            i = (i / 64) * 64 + 63;
+            continue;
+        }
+
+        if ((word & 1) == 0) {
+            continue;
+        }
+
+        if (IsSlotEmpty(&root_[i])) {
+            root_bitmap_[i / 64] &= ~(1ULL << (i % 64));
+            continue;
+        }
+
+        return current_ + (i - index);
+    }
+
+    // No timer in the rest of the root, wake up at the next cascading
+    return (current_ | kRootMask) + 1;
+}
+
+void TimingWheel::Schedule() {
+    if (size_ == 0) {
+        // The armed timer, if any, is left as it is. It will find nothing to do.
+        return;
+    }
+
+    uint64_t target = NextTick();
+    if (armed_ && armed_tick_ <= target) {
+        return;
+    }
+
+    int64_t delay = static_cast<int64_t>(target) * tick_ns_ + origin_ns_ - NowNanoseconds();
+    if (delay < Duration::kMicrosecond) {
+        // A zero timeout means waiting forever for EventWatcher
+        delay = Duration::kMicrosecond;
+    }
+
+    armed_ = true;
+    armed_tick_ = target;
+    timer_->AsyncWait(Duration(delay));
+}
+
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "evpp/inner_pre.h"
+#include "evpp/duration.h"
+#include "evpp/evlog.h"
+
+namespace evpp {
+class EventLoop;
+class TimerEventWatcher;
+
+// A hierarchical timing wheel owned by one EventLoop.
+//
+// It has 4 levels : 256 slots for the nearest ticks and 64 slots for each
+// of the upper levels, which covers 2^26 ticks (about 18 hours with the
+// default 1ms tick). A timer is an intrusive Node linked into one slot, so
+// Add and Remove are O(1) and don't allocate. The timers of an upper level
+// slot are cascaded to the lower levels when the lower level wraps around.
+//
+// The wheel is driven by one libevent timer which is only armed when the
+// wheel is not empty, and only for the next tick which has timers or
+// needs a cascading, so an idle wheel never wakes up the loop.
+//
+// @note All the methods MUST be called in the loop thread.
+class EVPP_EXPORT TimingWheel {
+private:
+    struct Link {
+        Link() : prev(nullptr), next(nullptr) {}
+        Link* prev;
+        Link* next;
+    };
+
+public:
+    class EVPP_EXPORT Node : private Link {
+    public:
+        Node() : expire_(0) {}
+        virtual ~Node() {
+            assert(!linked());
+        }
+
+        // Return true if this node is in a wheel
+        bool linked() const { return next != nullptr; }
+    protected:
+        // Invoked by the wheel when this node is expired.
+        // The node has been removed from the wheel before this call.
+        virtual void OnWheelTimeout() = 0;
+    private:
+        friend class TimingWheel;
+        uint64_t expire_; // in ticks
+    };
+
+    TimingWheel(EventLoop* loop, Duration tick);
+    ~TimingWheel();
+
+    void SetLogger(logger* log_) { myLog = log_; }
+
+    // @brief Add a node which will be expired after delay.
+    //  The delay is rounded up to the tick of this wheel.
+    void Add(Node* n, Duration delay);
+
+    // @brief Remove a node from this wheel. It is ok if the node is not in the wheel.
+    void Remove(Node* n);
+
+    // The count of the nodes in this wheel
+    size_t size() const { return size_; }
+
+    Duration tick() const { return Duration(tick_ns_); }
+
+private:
+    enum {
+        kRootBits = 8,
+        kLevelBits = 6,
+        kRootSize = 1 << kRootBits,
+        kLevelSize = 1 << kLevelBits,
+        kRootMask = kRootSize - 1,
+        kLevelMask = kLevelSize - 1,
+        kLevels = 3, // The upper levels
+    };
+
+    // The max delay in ticks the wheel can hold directly
+    static const uint64_t kMaxTicks = (1ULL << (kRootBits + kLevels * kLevelBits)) - 1;
+
+    int64_t NowNanoseconds() const;
+    uint64_t NowTick() const;
+    void Insert(Node* n);
+    static void Unlink(Link* n);
+    static void InitSlot(Link* head);
+    static void PushBack(Link* head, Link* n);
+    static bool IsSlotEmpty(const Link* head) { return head->next == head; }
+    static void MoveSlot(Link* from, Link* to);
+    size_t Cascade(int level);
+    uint64_t NextTick();
+    void OnTick();
+    void Schedule();
+
+private:
+    EventLoop* loop_;
+    int64_t tick_ns_;
+    int64_t origin_ns_;
+    uint64_t current_; // The next tick to process
+    size_t size_;
+
+    Link root_[kRootSize];
+    Link levels_[kLevels][kLevelSize];
+    uint64_t root_bitmap_[kRootSize / 64]; // The maybe non-empty slots of root_
+
+    std::unique_ptr<TimerEventWatcher> timer_;
+    bool armed_;
+    uint64_t armed_tick_; // The tick timer_ is armed for
+
+    logger* myLog{nullptr};
+};
+
+}
@@ -232,7 +232,7 @@ void Server::RecvingLoop(RecvThread* thread) {
                 if (IsRoundRobin()) {
                     loop = tpool_->GetNextLoop();
                 } else {
-                    loop = tpool_->GetNextLoopWithHash(sock::sockaddr_in_cast(recv_msg->remote_addr())->sin_addr.s_addr);
+                    loop = tpool_->GetNextLoop(policy_, sock::sockaddr_in_cast(recv_msg->remote_addr())->sin_addr.s_addr);
                 }
                 loop->RunInLoop(std::bind(this->message_handler_, loop, recv_msg));
             } else {
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "evpp/inner_pre.h"
+
+namespace evpp {
+
+// The Chase-Lev work stealing deque, in the C11 memory model version by
+// Le, Pop, Cohen and Zappa Nardelli.
+//
+// The owner thread pushes and pops at the bottom, like a stack, so the task
+// it has just created runs next while its data is still in the cache. The
+// other threads steal from the top, i.e. the oldest tasks, which are usually
+// the largest ones. The owner never takes a lock, and contends with the
+// thieves only for the last item.
+//
+// The array grows when it is full. The old arrays are kept until the deque
+// is destroyed, since a thief may still be reading one of them.
+//
+// T MUST be trivially copyable, e.g. a pointer.
+template<class T>
+class WorkStealingDeque {
+public:
+    // @param capacity - The initial capacity, rounded up to a power of 2
+    explicit WorkStealingDeque(size_t capacity = 256) : top_(0), bottom_(0) {
+        size_t n = 2;
+        while (n < capacity) {
+            n <<= 1;
+        }
+        arrays_.emplace_back(new Array(n));
+        array_.store(arrays_.back().get(), std::memory_order_relaxed);
+    }
+
+    // @brief Push x to the bottom. It MUST only be called by the owner.
+    void Push(T x) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        Array* a = array_.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(a->mask)) {
+            a = Grow(a, t, b);
+        }
+        a->Put(b, x);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // @brief Pop the bottom item, the last one pushed. It MUST only be called by the owner.
+    // @return false if the deque is empty
+    bool Pop(T* x) {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Array* a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Empty
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        *x = a->Get(b);
+        if (t == b) {
+            // The last item, which a thief may be taking at the same time
+            bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // @brief Steal the top item, the oldest one. It is thread safe.
+    // @return false if the deque is empty, or another thread took the item first
+    bool Steal(T* x) {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+
+        // memory_order_consume is promoted to acquire by the compilers anyway
+        Array* a = array_.load(std::memory_order_acquire);
+        T v = a->Get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        *x = v;
+        return true;
+    }
+
+    // The count of the items, which is only a hint when the other threads are using the deque
+    size_t size() const {
+        int64_t b = bottom_.load(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_seq_cst);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_t capacity() const {
+        return array_.load(std::memory_order_relaxed)->mask + 1;
+    }
+
+private:
+    struct Array {
+        explicit Array(size_t n) : mask(n - 1), slots(new std::atomic<T>[n]) {}
+
+        T Get(int64_t i) const {
+            return slots[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed);
+        }
+
+        void Put(int64_t i, T x) {
+            slots[static_cast<size_t>(i) & mask].store(x, std::memory_order_relaxed);
+        }
+
+        size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    Array* Grow(Array* a, int64_t t, int64_t b) {
+        Array* bigger = new Array((a->mask + 1) * 2);
+        for (int64_t i = t; i < b; i++) {
+            bigger->Put(i, a->Get(i));
+        }
+        arrays_.emplace_back(bigger);
+        array_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    // top_ is written by the thieves and bottom_ by the owner
+    std::atomic<int64_t> top_;
+    char padding_[64 - sizeof(std::atomic<int64_t>)];
+    std::atomic<int64_t> bottom_;
+    std::atomic<Array*> array_;
+    std::vector<std::unique_ptr<Array>> arrays_; // Only modified by the owner
+};
+
+}
@@ -1,5 +1,6 @@
 #include <evpp/tcp_server.h>
 #include <evpp/buffer.h>
+#include <evpp/buffer_pool.h>
 #include <evpp/tcp_conn.h>
 
 #ifdef _WIN32
@@ -59,6 +60,8 @@ void OnMessage(const evpp::TCPConnPtr& conn,
 void OnConnection(const evpp::TCPConnPtr& conn) {
     if (conn->IsConnected()) {
         // LOG_INFO << "Accept a new connection " << conn->AddrToString();
+        // Most of the connections are idle, don't keep their buffers
+        conn->SetReleaseBuffersWhenIdle(true);
         g_connected++;
         g_current_round_connected++;
     } else {
@@ -74,6 +77,7 @@ int main(int argc, char* argv[]) {
         port = argv[1];
     }
     std::string addr = std::string("0.0.0.0:") + port;
+    evpp::Buffer::SetDefaultAllocator(evpp::BufferPool::instance());
     evpp::EventLoop loop;
     loop.RunEvery(evpp::Duration(1.0), &Print);
     evpp::TCPServer server(&loop, addr, "c10m", 23);
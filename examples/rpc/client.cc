@@ -91,15 +91,15 @@ void ConnectionRPC::OnMessage(const evpp::TCPConnPtr& conn, evpp::Buffer* buf)
         buf->Skip(sizeof(uint32_t));
         uint32_t seqno = buf->ReadInt32();
 
-        evpp::Slice msg = buf->Next(expect_len - 2*sizeof(uint32_t));
+        // The response is handed to the callback without copying
+        evpp::SharedSlice msg = buf->NextShared(expect_len - 2*sizeof(uint32_t));
 
         // _log_info(myLog, "recv: %d %d seq: %d %.*s", total, expect_len, seqno, msg.size(), msg.data());
 
         auto iter = ctxs.find(seqno);
         if (iter != ctxs.end()) {
             ContextXPtr ctx = iter->second;
-            ctx->rspbuf = std::make_shared<evpp::Buffer>();
-            ctx->rspbuf->Append(msg);
+            ctx->rspbuf = msg;
 
             ctx->timer->Cancel();
             ctxs.erase(iter);
@@ -73,7 +73,7 @@ public:
 public:
     uint32_t                seqno{0};
     evpp::BufferPtr         reqbuf{nullptr};
-    evpp::BufferPtr         rspbuf{nullptr};
+    evpp::SharedSlice       rspbuf;
 
     Callback                cb{nullptr};
     Status                  status{Status::OK};
@@ -22,9 +22,9 @@ int main(int argc, char* argv[]) {
     conn->Wait();
 
     auto func = [my_logger] (rpc::ContextXPtr ctx) {
-        auto buf = ctx->rspbuf;
+        const evpp::SharedSlice& buf = ctx->rspbuf;
 
-        _log_info(my_logger, "seqno: %d status: %d %s", ctx->seqno, ctx->status, buf->ToString().c_str());
+        _log_info(my_logger, "seqno: %d status: %d %s", ctx->seqno, ctx->status, buf.ToString().c_str());
     };
 
     for (int i = 0; i < 100; i++) {
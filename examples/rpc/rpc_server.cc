@@ -7,6 +7,8 @@ void OnConnection(const evpp::TCPConnPtr& conn)
 {
     if (conn->IsConnected()) {
         conn->SetTCPNoDelay(true);
+        // The responses of a batch of pipelined requests are written together
+        conn->SetAutoCork(true);
     }
 }
 
@@ -26,20 +28,19 @@ void OnMessage(const evpp::TCPConnPtr& conn, evpp::Buffer* reqbuf)
         reqbuf->Skip(sizeof(uint32_t));
         uint32_t seqno = reqbuf->ReadInt32();
 
-        evpp::Slice msg = reqbuf->Next(expect_len - 2*sizeof(uint32_t));
+        evpp::SharedSlice msg = reqbuf->NextShared(expect_len - 2*sizeof(uint32_t));
 
         _log_info(my_logger, "recv: %d %d seq: %d %.*s", total, expect_len, seqno, msg.size(), msg.data());
         // _log_info(my_logger, "recv: %d %d seq: %d", total, expect_len, seqno);
 
-        evpp::BufferPtr rspbuf = std::make_shared<evpp::Buffer>();
+        // The body is echoed without copying, it goes out with the header
+        // in one writev since the connection is corked
+        evpp::BufferPtr rspbuf = std::make_shared<evpp::Buffer>(2*sizeof(uint32_t), 0);
+        rspbuf->AppendInt32(expect_len);
+        rspbuf->AppendInt32(seqno);
 
-        rspbuf->Append(msg);
-        uint32_t total_size = rspbuf->total();
-
-        rspbuf->PrependInt32(seqno);
-        rspbuf->PrependInt32(total_size);
-
-        conn->SendTotal(rspbuf);
+        conn->Send(rspbuf);
+        conn->Send(msg);
     }
 }
 
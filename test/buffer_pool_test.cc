@@ -0,0 +1,107 @@
+#include "test_common.h"
+
+#include <evpp/buffer.h>
+#include <evpp/buffer_pool.h>
+
+#include <thread>
+
+using evpp::BufferPool;
+using evpp::BufferPoolStats;
+
+TEST_UNIT(testBufferPoolSizeClass) {
+    H_TEST_EQUAL(BufferPool::SizeClass(0), 0);
+    H_TEST_EQUAL(BufferPool::SizeClass(1), 0);
+    H_TEST_EQUAL(BufferPool::SizeClass(64), 0);
+    H_TEST_EQUAL(BufferPool::SizeClass(65), 1);
+    H_TEST_EQUAL(BufferPool::SizeClass(1032), 5);
+    H_TEST_EQUAL(BufferPool::ClassSize(5), 2048u);
+    H_TEST_EQUAL(BufferPool::SizeClass(1024 * 1024), BufferPool::kClassCount - 1);
+    H_TEST_EQUAL(BufferPool::SizeClass(1024 * 1024 + 1), -1);
+}
+
+TEST_UNIT(testBufferPoolThreadCache) {
+    BufferPool* pool = BufferPool::instance();
+    BufferPoolStats s0 = pool->Stats();
+
+    char* p = pool->Allocate(1000);
+    memset(p, 'x', 1024);
+    pool->Deallocate(p, 1000);
+
+    // The same block is reused by the same thread
+    char* q = pool->Allocate(1024);
+    H_TEST_EQUAL(p, q);
+    pool->Deallocate(q, 1024);
+
+    BufferPoolStats s1 = pool->Stats();
+    H_TEST_EQUAL(s1.allocations - s0.allocations, 2u);
+    H_TEST_ASSERT(s1.thread_cache_hits - s0.thread_cache_hits >= 1u);
+    H_TEST_ASSERT(s1.thread_cache_bytes >= 1024u);
+
+    // Not pooled
+    char* large = pool->Allocate(2 * 1024 * 1024);
+    pool->Deallocate(large, 2 * 1024 * 1024);
+    H_TEST_EQUAL(pool->Stats().oversize - s0.oversize, 1u);
+}
+
+TEST_UNIT(testBufferPoolCrossThread) {
+    BufferPool* pool = BufferPool::instance();
+    const size_t kSize = 256 * 1024; // A class which is not used by the other tests
+    const int kCount = 16;
+
+    std::vector<char*> blocks;
+    for (int i = 0; i < kCount; i++) {
+        blocks.push_back(pool->Allocate(kSize));
+    }
+
+    // Freed by another thread, which returns them to the depot at its exit
+    std::thread t([pool, &blocks, kSize]() {
+        for (auto p : blocks) {
+            pool->Deallocate(p, kSize);
+        }
+    });
+    t.join();
+    H_TEST_ASSERT(pool->Stats().depot_bytes >= kCount * kSize);
+
+    BufferPoolStats s0 = pool->Stats();
+    char* p = pool->Allocate(kSize);
+    BufferPoolStats s1 = pool->Stats();
+    H_TEST_EQUAL(s1.depot_hits - s0.depot_hits, 1u);
+    H_TEST_ASSERT(std::find(blocks.begin(), blocks.end(), p) != blocks.end());
+    H_TEST_ASSERT(s1.hit_rate() > 0.0);
+    pool->Deallocate(p, kSize);
+}
+
+TEST_UNIT(testBufferWithPool) {
+    evpp::Buffer::SetDefaultAllocator(BufferPool::instance());
+    H_TEST_EQUAL(evpp::Buffer::default_allocator(), BufferPool::instance());
+    BufferPoolStats s0 = BufferPool::instance()->Stats();
+    {
+        evpp::Buffer buf;
+
+        // The whole block of the size class is used
+        const size_t block = BufferPool::ClassSize(BufferPool::SizeClass(evpp::Buffer::kCheapPrependSize + evpp::Buffer::kInitialSize));
+        H_TEST_EQUAL(buf.capacity(), block);
+        H_TEST_EQUAL(buf.WritableBytes(), block - evpp::Buffer::kCheapPrependSize);
+        buf.Append(std::string(block - evpp::Buffer::kCheapPrependSize, 'x'));
+        H_TEST_EQUAL(buf.capacity(), block);
+        buf.Reset();
+
+        std::string s;
+        for (int i = 0; i < 10000; i++) {
+            s += char('a' + i % 26);
+        }
+
+        // Grow in the pool
+        buf.Append(s);
+        H_TEST_EQUAL(buf.ToString(), s);
+
+        // Swap with a Buffer of the other allocator, each one is freed by its own allocator
+        evpp::Buffer::SetDefaultAllocator(nullptr);
+        evpp::Buffer other;
+        other.Append("hello");
+        buf.Swap(other);
+        H_TEST_EQUAL(buf.ToString(), std::string("hello"));
+        H_TEST_EQUAL(other.ToString(), s);
+    }
+    H_TEST_ASSERT(BufferPool::instance()->Stats().allocations - s0.allocations >= 2u);
+}
@@ -1,6 +1,11 @@
 #include "test_common.h"
 
+#include <evpp/libevent.h>
 #include <evpp/buffer.h>
+#include <evpp/memsearch.h>
+
+#include <thread>
+#include <vector>
 
 using evpp::Buffer;
 using std::string;
@@ -164,6 +169,73 @@ TEST_UNIT(testBufferFindEOL) {
 }
 
 
+TEST_UNIT(testBufferFindCRLF) {
+    Buffer buf;
+    const char* null = nullptr;
+    buf.Append(string(1000, 'x'));
+    buf.Append("\r\r\n\r");
+    H_TEST_EQUAL(buf.FindCRLF(), buf.data() + 1001);
+    H_TEST_EQUAL(buf.FindCRLF(buf.data() + 1002), null);
+    H_TEST_EQUAL(buf.FindCRLFCRLF(), null);
+    buf.Append("\n");
+    H_TEST_EQUAL(buf.FindCRLFCRLF(), buf.data() + 1001);
+    H_TEST_EQUAL(buf.Find("x\r", 2), buf.data() + 999);
+    H_TEST_EQUAL(buf.Find("\n\r\n", 3), buf.data() + 1002);
+}
+
+TEST_UNIT(testBufferFindResumable) {
+    // The header arrives byte by byte, the delimiter is split across the reads
+    const string header = "GET / HTTP/1.1\r\nHost: localhost\r\n" + string(8000, 'h') + "\r\n\r\nbody";
+    Buffer buf;
+    size_t scanned = 0;
+    const char* found = nullptr;
+    size_t i = 0;
+    for (; i < header.size() && found == nullptr; i++) {
+        buf.Append(header.data() + i, 1);
+        found = buf.Find("\r\n\r\n", 4, &scanned);
+        H_TEST_ASSERT(scanned <= buf.length());
+    }
+    H_TEST_ASSERT(found != nullptr);
+    H_TEST_EQUAL(size_t(found - buf.data()), header.find("\r\n\r\n"));
+    H_TEST_EQUAL(buf.length(), header.find("\r\n\r\n") + 4);
+}
+
+TEST_UNIT(testMemSearchKernels) {
+    std::vector<evpp::memsearch::Kernel> kernels;
+    kernels.push_back(evpp::memsearch::ScalarKernel());
+    if (evpp::memsearch::SSE2Kernel()) {
+        kernels.push_back(evpp::memsearch::SSE2Kernel());
+    }
+    if (evpp::memsearch::AVX2Kernel()) {
+        kernels.push_back(evpp::memsearch::AVX2Kernel());
+    }
+
+    // Every delimiter position relative to the vector width, the partial
+    // matches near it, and the delimiter cut by the end of the data
+    const char* delims[] = { "\n", "\r\n", "\n\r\n", "\r\n\r\n", "\r\n\r\n\r\n" };
+    for (size_t d = 0; d < sizeof(delims) / sizeof(delims[0]); d++) {
+        const string delim = delims[d];
+        for (size_t len = 0; len < 100; len++) {
+            for (size_t pos = 0; pos <= len; pos++) {
+                string s(len, 'a');
+                for (size_t j = 0; j < len; j += 7) {
+                    s[j] = delim[j % delim.size()];
+                }
+                s.replace(pos, std::min(delim.size(), len - pos), delim.substr(0, len - pos));
+                const char* end = s.data() + s.size();
+                const char* expected = std::search(s.data(), end, delim.begin(), delim.end());
+                if (expected == end) {
+                    expected = nullptr;
+                }
+                for (auto k : kernels) {
+                    H_TEST_EQUAL(k(s.data(), end, delim.data(), delim.size()), expected);
+                }
+            }
+        }
+    }
+    H_TEST_ASSERT(string(evpp::memsearch::KernelName()).size() > 0);
+}
+
 TEST_UNIT(testBufferTruncate) {
     Buffer buf;
     buf.Append("HTTP");
@@ -256,3 +328,109 @@ TEST_UNIT(testBufferReserve) {
     H_TEST_EQUAL(buf.PrependableBytes(), Buffer::kCheapPrependSize);
 }
 
+
+TEST_UNIT(testBufferRelease) {
+    Buffer buf;
+    buf.Append(string(10000, 'x'));
+    H_TEST_ASSERT(buf.capacity() > 10000);
+
+    // Not empty
+    buf.Release();
+    H_TEST_ASSERT(buf.capacity() > 10000);
+
+    buf.Reset();
+    buf.Release();
+    H_TEST_EQUAL(buf.length(), 0);
+    H_TEST_EQUAL(buf.capacity(), Buffer::kCheapPrependSize);
+
+    buf.Append("hello");
+    H_TEST_EQUAL(buf.ToString(), string("hello"));
+}
+
+TEST_UNIT(testBufferReadFromFDExpected) {
+    evpp_socket_t fds[2];
+    H_TEST_EQUAL(evutil_socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    const string data(3000, 'x');
+    H_TEST_EQUAL(::send(fds[0], data.data(), data.size(), 0), ssize_t(data.size()));
+
+    // The writable bytes are ensured before reading
+    Buffer buf(0);
+    int serrno = 0;
+    H_TEST_EQUAL(buf.ReadFromFD(fds[1], &serrno, data.size()), ssize_t(data.size()));
+    H_TEST_EQUAL(buf.ToString(), data);
+
+    EVUTIL_CLOSESOCKET(fds[0]);
+    EVUTIL_CLOSESOCKET(fds[1]);
+}
+
+TEST_UNIT(testBufferNextShared) {
+    Buffer buf;
+    buf.Append("hello world");
+    evpp::SharedSlice hello = buf.NextShared(5);
+    const char* storage = hello.data();
+    H_TEST_EQUAL(hello.ToString(), string("hello"));
+    H_TEST_EQUAL(buf.ToString(), string(" world"));
+
+    // Neither compacted nor overwritten while hello is referenced
+    const string x(Buffer::kInitialSize - 8, 'x');
+    buf.Append(x);
+    H_TEST_ASSERT(buf.data() != storage);
+    H_TEST_EQUAL(hello.ToString(), string("hello"));
+
+    evpp::SharedSlice rest = buf.NextShared(buf.length() + 100);
+    H_TEST_EQUAL(rest.size(), 6 + x.size());
+    H_TEST_EQUAL(buf.length(), 0u);
+    buf.Append("again");
+    buf.PrependInt32(5);
+    H_TEST_EQUAL(hello.ToString(), string("hello"));
+    H_TEST_EQUAL(rest.ToString(), " world" + x);
+
+    // The slices outlive the buffer
+    {
+        Buffer tmp;
+        tmp.Swap(buf);
+    }
+    H_TEST_EQUAL(hello.ToString(), string("hello"));
+
+    // The storage is reused again once the slices are released
+    Buffer b2;
+    b2.Append("abcdef");
+    { evpp::SharedSlice s = b2.NextShared(3); }
+    const char* before = b2.begin();
+    b2.Reset();
+    b2.Append("xyz");
+    H_TEST_EQUAL(b2.begin(), before);
+}
+
+TEST_UNIT(testBufferNextSharedOtherThread) {
+    // The messages are decoded from one buffer and consumed by another thread
+    Buffer buf;
+    std::vector<evpp::SharedSlice> messages;
+    for (int i = 0; i < 1000; i++) {
+        buf.Append(string(100, char('a' + i % 26)));
+        if (i % 3 == 2) {
+            while (buf.length() >= 150) {
+                messages.push_back(buf.NextShared(150));
+            }
+        }
+    }
+
+    std::thread consumer([&messages]() {
+        for (size_t i = 0; i < messages.size(); i++) {
+            const evpp::SharedSlice& m = messages[i];
+            for (size_t j = 0; j < m.size(); j++) {
+                size_t offset = i * 150 + j;
+                H_TEST_EQUAL(m.data()[j], char('a' + (offset / 100) % 26));
+            }
+        }
+        messages.clear();
+    });
+
+    // The buffer keeps being written meanwhile
+    for (int i = 0; i < 1000; i++) {
+        buf.Append(string(100, 'z'));
+        buf.Skip(100);
+    }
+    consumer.join();
+}
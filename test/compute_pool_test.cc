@@ -0,0 +1,170 @@
+#include "test_common.h"
+
+#include <evpp/compute_pool.h>
+#include <evpp/event_loop.h>
+#include <evpp/event_loop_thread.h>
+#include <evpp/work_stealing_deque.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_UNIT(testWorkStealingDeque) {
+    evpp::WorkStealingDeque<intptr_t> d(4);
+    H_TEST_ASSERT(d.capacity() == 4);
+    intptr_t x = 0;
+    H_TEST_ASSERT(!d.Pop(&x));
+    H_TEST_ASSERT(!d.Steal(&x));
+
+    // It grows, and the owner pops the last one while the thieves steal the first one
+    for (intptr_t i = 1; i <= 10; i++) {
+        d.Push(i);
+    }
+    H_TEST_ASSERT(d.size() == 10);
+    H_TEST_ASSERT(d.capacity() == 16);
+    H_TEST_ASSERT(d.Pop(&x) && x == 10);
+    H_TEST_ASSERT(d.Steal(&x) && x == 1);
+    H_TEST_ASSERT(d.Steal(&x) && x == 2);
+    for (intptr_t i = 9; i >= 3; i--) {
+        H_TEST_ASSERT(d.Pop(&x) && x == i);
+    }
+    H_TEST_ASSERT(d.empty());
+    H_TEST_ASSERT(!d.Pop(&x));
+}
+
+TEST_UNIT(testWorkStealingDequeConcurrent) {
+    // Every item is taken exactly once, by the owner or one of the thieves
+    const intptr_t kItems = 200000;
+    const int kThieves = 3;
+    evpp::WorkStealingDeque<intptr_t> d(16);
+    std::vector<std::atomic<int>> taken(kItems);
+    for (auto& t : taken) {
+        t.store(0);
+    }
+    std::atomic<intptr_t> count(0);
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < kThieves; i++) {
+        thieves.emplace_back([&]() {
+            intptr_t x = 0;
+            while (!done.load()) {
+                if (d.Steal(&x)) {
+                    taken[x]++;
+                    count++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    intptr_t x = 0;
+    for (intptr_t i = 0; i < kItems; i++) {
+        d.Push(i);
+        // Pop about a third of them, so the owner and the thieves race for the last item
+        if (i % 3 == 0 && d.Pop(&x)) {
+            taken[x]++;
+            count++;
+        }
+    }
+    while (d.Pop(&x)) {
+        taken[x]++;
+        count++;
+    }
+    while (count.load() < kItems) {
+        std::this_thread::yield();
+    }
+    done.store(true);
+    for (auto& t : thieves) {
+        t.join();
+    }
+
+    H_TEST_ASSERT(count.load() == kItems);
+    for (auto& t : taken) {
+        H_TEST_ASSERT(t.load() == 1);
+    }
+}
+
+TEST_UNIT(testComputePool) {
+    evpp::EventLoopThread loop;
+    loop.Start(true);
+    evpp::ComputePool pool(4);
+    H_TEST_ASSERT(pool.Start());
+    H_TEST_ASSERT(!pool.IsInWorkerThread());
+
+    // The results are delivered to the loop which asks for them
+    const int kTasks = 1000;
+    std::atomic<int> delivered(0);
+    std::atomic<int> wrong_thread(0);
+    evpp::EventLoop* l = loop.loop();
+    for (int i = 0; i < kTasks; i++) {
+        l->RunInLoop([&pool, &delivered, &wrong_thread, l, i]() {
+            pool.Compute(l, [&pool, &wrong_thread, i]() {
+                wrong_thread += !pool.IsInWorkerThread();
+                return std::to_string(i * i);
+            }, [&delivered, &wrong_thread, l, i](std::string result) {
+                wrong_thread += !l->IsInLoopThread();
+                wrong_thread += result != std::to_string(i * i);
+                delivered++;
+            });
+        });
+    }
+
+    // A task splits its work into the tasks pushed to the deque of its worker,
+    // which are run by it or stolen by the others. Stop waits for all of them.
+    std::atomic<int> leaves(0);
+    const int kLeaves = 256;
+    std::function<void(int)> split = [&](int n) {
+        if (n == 1) {
+            usleep(100);
+            leaves++;
+            return;
+        }
+        pool.Submit(std::bind(split, n / 2));
+        pool.Submit(std::bind(split, n - n / 2));
+    };
+    H_TEST_ASSERT(pool.Submit(std::bind(split, kLeaves)));
+
+    bool run = false;
+    H_TEST_ASSERT(pool.Run(l, []() {}, [&run]() { run = true; }));
+
+    while (delivered.load() < kTasks) {
+        usleep(1000);
+    }
+    pool.Stop();
+    H_TEST_ASSERT(pool.IsStopped());
+    H_TEST_ASSERT(leaves.load() == kLeaves);
+    H_TEST_ASSERT(wrong_thread.load() == 0);
+    H_TEST_ASSERT(pool.executed_count() >= uint64_t(kTasks + 2 * kLeaves));
+    H_TEST_ASSERT(!pool.Submit([]() {}));
+
+    loop.Stop(true);
+    H_TEST_ASSERT(run);
+}
+
+TEST_UNIT(testComputePoolSubmitWhileStopping) {
+    // Every task accepted is run, even if it is submitted while the pool is stopping
+    for (int round = 0; round < 20; round++) {
+        evpp::ComputePool pool(2);
+        H_TEST_ASSERT(pool.Start());
+
+        std::atomic<bool> done(false);
+        std::atomic<uint64_t> accepted(0);
+        std::atomic<uint64_t> ran(0);
+        std::thread submitter([&]() {
+            while (!done.load()) {
+                if (pool.Submit([&ran]() { ran++; })) {
+                    accepted++;
+                }
+            }
+        });
+
+        usleep(1000);
+        pool.Stop();
+        done = true;
+        submitter.join();
+        H_TEST_EQUAL(ran.load(), accepted.load());
+        H_TEST_EQUAL(pool.executed_count(), accepted.load());
+    }
+}
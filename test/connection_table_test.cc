@@ -0,0 +1,90 @@
+#include "test_common.h"
+
+#include <evpp/connection_table.h>
+#include <evpp/tcp_conn.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+using evpp::ConnectionTable;
+using evpp::TCPConn;
+using evpp::TCPConnPtr;
+
+namespace {
+// A connection without a socket, which is only used as a value of the table
+TCPConnPtr NewConn(uint64_t id) {
+    return TCPConnPtr(new TCPConn(nullptr, "conn", -1, "", "", id));
+}
+}
+
+TEST_UNIT(testConnectionTableInsertFindErase) {
+    ConnectionTable t;
+    H_TEST_ASSERT(t.empty());
+    H_TEST_ASSERT(!t.Find(1));
+    H_TEST_ASSERT(!t.Erase(1));
+
+    TCPConnPtr c1 = NewConn(1);
+    H_TEST_ASSERT(t.Insert(c1));
+    H_TEST_ASSERT(!t.Insert(c1));
+    H_TEST_ASSERT(t.Insert(NewConn(2)));
+    H_TEST_EQUAL(t.size(), 2);
+    H_TEST_ASSERT(t.Find(1) == c1);
+    H_TEST_ASSERT(t.Find(2)->id() == 2);
+    H_TEST_ASSERT(!t.Find(3));
+
+    H_TEST_ASSERT(t.Erase(1));
+    H_TEST_ASSERT(!t.Erase(1));
+    H_TEST_ASSERT(!t.Find(1));
+    H_TEST_EQUAL(c1.use_count(), 1);
+    H_TEST_EQUAL(t.size(), 1);
+
+    t.Clear();
+    H_TEST_ASSERT(t.empty());
+    H_TEST_ASSERT(!t.Find(2));
+}
+
+// The ids of the connections of one loop are strided by the count of the loops
+TEST_UNIT(testConnectionTableStridedIds) {
+    const int kCount = 20000;
+    const uint64_t kStride = 8;
+    ConnectionTable t;
+    std::map<uint64_t, TCPConnPtr> expected;
+    std::vector<uint64_t> ids;
+    for (int i = 0; i < kCount; i++) {
+        uint64_t id = 3 + i * kStride;
+        TCPConnPtr c = NewConn(id);
+        H_TEST_ASSERT(t.Insert(c));
+        expected[id] = c;
+        ids.push_back(id);
+    }
+    H_TEST_EQUAL(t.size(), size_t(kCount));
+    H_TEST_ASSERT(t.capacity() >= size_t(kCount) * 2);
+
+    size_t visited = 0;
+    t.ForEach([&](const TCPConnPtr& c) {
+        H_TEST_ASSERT(expected[c->id()] == c);
+        visited++;
+    });
+    H_TEST_EQUAL(visited, size_t(kCount));
+
+    // Erase them in a random order, checking the rest can still be found,
+    // which fails if the backward shifting breaks a probe sequence
+    std::mt19937 rng(7);
+    std::shuffle(ids.begin(), ids.end(), rng);
+    for (size_t i = 0; i < ids.size(); i++) {
+        H_TEST_ASSERT(t.Erase(ids[i]));
+        expected.erase(ids[i]);
+        if (i % 997 == 0) {
+            for (auto& e : expected) {
+                H_TEST_ASSERT(t.Find(e.first) == e.second);
+            }
+            H_TEST_ASSERT(!t.Find(ids[i]));
+        }
+    }
+    H_TEST_ASSERT(t.empty());
+
+    // The memory is given back
+    H_TEST_EQUAL(t.capacity(), size_t(ConnectionTable::kMinCapacity));
+}
@@ -0,0 +1,140 @@
+#include "test_common.h"
+
+#include <evpp/libevent.h>
+#include <evpp/event_loop.h>
+#include <evpp/event_loop_thread.h>
+#include <evpp/epoll_poller.h>
+#include <evpp/fd_channel.h>
+#include <evpp/tcp_server.h>
+#include <evpp/tcp_client.h>
+#include <evpp/tcp_conn.h>
+#include <evpp/buffer.h>
+
+#include <thread>
+
+#ifdef H_OS_LINUX
+namespace {
+// Echo 4MB through a TCPServer and a TCPClient with the given backend
+void TestEcho(evpp::EventLoop::IOBackend backend, const std::string& addr) {
+    evpp::EventLoop::SetDefaultIOBackend(backend);
+
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+    H_TEST_EQUAL(client_thread->loop()->io_backend(), backend);
+    H_TEST_ASSERT(client_thread->loop()->poller() != nullptr);
+
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr, "EchoServer", 2));
+    tsrv->SetMessageCallback([](const evpp::TCPConnPtr& conn, evpp::Buffer* msg) {
+        conn->Send(msg);
+    });
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    const size_t kTotal = 4 * 1024 * 1024;
+    std::string payload(kTotal, 'x');
+    for (size_t i = 0; i < kTotal; i++) {
+        payload[i] = char('a' + i % 26);
+    }
+
+    std::atomic<size_t> received(0);
+    std::atomic<bool> matched(true);
+    std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), addr, "EchoClient"));
+    client->SetConnectionCallback([&payload](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            conn->Send(payload);
+        }
+    });
+    client->SetMessageCallback([&](const evpp::TCPConnPtr& conn, evpp::Buffer* msg) {
+        size_t offset = received.load();
+        if (msg->length() + offset > payload.size() ||
+                memcmp(msg->data(), payload.data() + offset, msg->length()) != 0) {
+            matched = false;
+        }
+        received += msg->length();
+        msg->Reset();
+    });
+    client->Connect();
+
+    for (int i = 0; i < 10000 && received.load() < kTotal; i++) {
+        usleep(1000);
+    }
+    H_TEST_EQUAL(received.load(), kTotal);
+    H_TEST_ASSERT(matched.load());
+
+    client->Disconnect();
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+
+    client_thread->Stop(true);
+    server_thread->Stop(true);
+    client.reset();
+    tsrv.reset();
+    client_thread.reset();
+    server_thread.reset();
+    evpp::EventLoop::SetDefaultIOBackend(evpp::EventLoop::kLibevent);
+}
+}
+
+TEST_UNIT(testEpollPollerChannel) {
+    evpp::EventLoop::SetDefaultIOBackend(evpp::EventLoop::kEpoll);
+    evpp::EventLoop loop;
+    evpp::EventLoop::SetDefaultIOBackend(evpp::EventLoop::kLibevent);
+    H_TEST_EQUAL(loop.io_backend(), evpp::EventLoop::kEpoll);
+    evpp::EpollPoller* poller = loop.poller();
+    H_TEST_ASSERT(poller != nullptr);
+
+    evpp_socket_t fds[2];
+    H_TEST_EQUAL(evutil_socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    evutil_make_socket_nonblocking(fds[1]);
+
+    int reads = 0;
+    int writes = 0;
+    std::shared_ptr<evpp::FdChannel> chan(new evpp::FdChannel(&loop, fds[1], true, false));
+    chan->SetReadCallback([&]() {
+        char buf[16];
+        if (::recv(fds[1], buf, sizeof(buf), 0) > 0) {
+            reads++;
+        }
+
+        // The write event is reported once and then disabled
+        chan->EnableWriteEvent();
+    });
+    chan->SetWriteCallback([&]() {
+        writes++;
+        chan->DisableWriteEvent();
+        loop.Stop();
+    });
+
+    loop.QueueInLoop([&]() {
+        chan->AttachToLoop();
+        H_TEST_EQUAL(poller->size(), 1u);
+        H_TEST_EQUAL(::send(fds[0], "x", 1, 0), 1);
+    });
+    loop.Run();
+
+    H_TEST_EQUAL(reads, 1);
+    H_TEST_EQUAL(writes, 1);
+    H_TEST_ASSERT(!chan->IsWritable());
+
+    chan->DisableAllEvent();
+    H_TEST_ASSERT(!chan->attached());
+    H_TEST_EQUAL(poller->size(), 1u); // Still registered until it is closed
+    chan->Close();
+    H_TEST_EQUAL(poller->size(), 0u);
+    chan.reset();
+    EVUTIL_CLOSESOCKET(fds[0]);
+    EVUTIL_CLOSESOCKET(fds[1]);
+}
+
+TEST_UNIT(testEpollPollerEcho) {
+    TestEcho(evpp::EventLoop::kEpoll, "127.0.0.1:19371");
+}
+
+TEST_UNIT(testEpollPollerEchoEdgeTriggered) {
+    TestEcho(evpp::EventLoop::kEpollET, "127.0.0.1:19372");
+}
+#endif
@@ -5,6 +5,7 @@
 #include <evpp/event_watcher.h>
 #include <evpp/event_loop.h>
 #include <thread>
+#include <atomic>
 
 // namespace {
 // static bool g_event_handler_called = false;
@@ -66,3 +67,52 @@ TEST_UNIT(testPipeEventWatcher) {
 
 
 
+
+namespace {
+static std::atomic<int> g_notify_handler_count(0);
+static void NotifyHandle(evpp::EventLoop* loop) {
+    if (g_notify_handler_count.fetch_add(1) == 0) {
+        loop->Stop();
+    }
+}
+
+static void MyNotifyThread(evpp::EventLoop* loop, evpp::NotifyWatcher* ev, std::atomic<int>* step) {
+    if (ev->Init()) {
+        ev->AsyncWait();
+    }
+
+    // Run the loop after the notifications, see testNotifyWatcher
+    step->store(1);
+    while (step->load() != 2) {
+        ::usleep(1000);
+    }
+
+    loop->Run();
+    delete ev; // make sure to initialize and delete in the same thread.
+}
+}
+
+TEST_UNIT(testNotifyWatcher) {
+    std::unique_ptr<evpp::EventLoop> loop(new evpp::EventLoop);
+    evpp::NotifyWatcher* ev = new evpp::NotifyWatcher(loop.get(), std::bind(&NotifyHandle, loop.get()));
+    g_notify_handler_count = 0;
+    std::atomic<int> step(0);
+    std::thread th(MyNotifyThread, loop.get(), ev, &step);
+    while (step.load() != 1) {
+        ::usleep(1000);
+    }
+#ifdef H_OS_LINUX
+    H_TEST_ASSERT(ev->IsEventFd());
+#endif
+
+    // Several notifications from another thread, issued before the loop runs,
+    // are coalesced into one wakeup
+    ev->Notify();
+    ev->Notify();
+    ev->Notify();
+    step.store(2);
+    th.join();
+    loop.reset();
+    H_TEST_ASSERT(g_notify_handler_count.load() == 1);
+    H_TEST_ASSERT(evpp::GetActiveEventCount() == 0);
+}
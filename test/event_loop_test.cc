@@ -4,6 +4,7 @@
 #include <evpp/libevent.h>
 #include <evpp/event_watcher.h>
 #include <evpp/event_loop.h>
+#include <evpp/event_loop_thread.h>
 #include <evpp/timestamp.h>
 
 #include <thread>
@@ -158,4 +159,153 @@ TEST_UNIT(TestEventLoop6) {
 
 
 
- 
\ No newline at end of file
+ 
+// Test EventLoop::QueueInLoopBatch() and TaskBatch
+TEST_UNIT(TestEventLoop7) {
+    evpp::EventLoopThread t1;
+    evpp::EventLoopThread t2;
+    t1.Start(true);
+    t2.Start(true);
+
+    std::vector<int> order1;
+    std::vector<int> order2;
+    std::atomic<int> count(0);
+    const int kCount = 100;
+    {
+        evpp::TaskBatch batch;
+        for (int i = 0; i < kCount; i++) {
+            batch.Add(t1.loop(), evpp::Task([&order1, &count, i]() { order1.push_back(i); count++; }));
+            batch.Add(t2.loop(), evpp::Task([&order2, &count, i]() { order2.push_back(i); count++; }));
+        }
+        H_TEST_EQUAL(batch.size(), size_t(kCount * 2));
+        batch.Flush();
+        H_TEST_EQUAL(batch.size(), 0u);
+    }
+
+    std::vector<evpp::Task> tasks;
+    tasks.push_back(evpp::Task([&order1, &count, kCount]() { order1.push_back(kCount); count++; }));
+    t1.loop()->QueueInLoopBatch(tasks);
+    H_TEST_ASSERT(tasks.empty());
+
+    while (count.load() != kCount * 2 + 1) {
+        usleep(1000);
+    }
+
+    H_TEST_EQUAL(order1.size(), size_t(kCount + 1));
+    H_TEST_EQUAL(order2.size(), size_t(kCount));
+    for (int i = 0; i < kCount; i++) {
+        H_TEST_EQUAL(order1[i], i);
+        H_TEST_EQUAL(order2[i], i);
+    }
+    H_TEST_EQUAL(order1[kCount], kCount);
+
+    // It is decreased after each task has run
+    for (int i = 0; i < 1000 && t1.loop()->pending_functor_count() != 0; i++) {
+        usleep(1000);
+    }
+    H_TEST_EQUAL(t1.loop()->pending_functor_count(), 0);
+    t1.Stop(true);
+    t2.Stop(true);
+}
+
+TEST_UNIT(TestEventLoopRunBeforeWait) {
+    evpp::EventLoopThread t;
+    t.Start(true);
+
+    std::vector<int> order;
+    std::atomic<bool> done(false);
+    evpp::EventLoop* loop = t.loop();
+    loop->RunInLoop([&order, &done, loop]() {
+        // The task queued into the loop is run in the next iteration
+        loop->QueueInLoop([&order, &done]() {
+            order.push_back(4);
+            done = true;
+        });
+        loop->RunBeforeWait(evpp::Task([&order, loop]() {
+            order.push_back(2);
+            loop->RunBeforeWait(evpp::Task([&order]() { order.push_back(3); }));
+        }));
+        order.push_back(1);
+    });
+
+    while (!done.load()) {
+        usleep(1000);
+    }
+
+    H_TEST_EQUAL(order.size(), 4u);
+    for (int i = 0; i < 4; i++) {
+        H_TEST_EQUAL(order[i], i + 1);
+    }
+    t.Stop(true);
+}
+
+TEST_UNIT(TestEventLoopBusyPoll) {
+    evpp::EventLoopThread t;
+    t.loop()->SetBusyPoll(evpp::Duration(0.002), false);
+    t.Start(true);
+    evpp::EventLoop* loop = t.loop();
+
+    // The tasks queued soon after each other are found by spinning
+    std::atomic<int> count(0);
+    for (int i = 0; i < 20; i++) {
+        loop->QueueInLoop([&count]() { count++; });
+        usleep(100);
+    }
+    while (count.load() < 20) {
+        usleep(1000);
+    }
+
+    // The statistics of a spin are added up when it ends
+    usleep(10 * 1000);
+    evpp::BusyPollStats s = loop->busy_poll_stats();
+    H_TEST_ASSERT(s.spin_ns > 0);
+    H_TEST_ASSERT(s.hits > 0);
+    H_TEST_ASSERT(s.spin_limit_ns == 2000000);
+
+    // It blocks when it is idle for longer than the spin, and the wakeup is measured
+    usleep(50 * 1000);
+    loop->QueueInLoop([&count]() { count++; });
+    std::atomic<bool> fired(false);
+    loop->RunAfter(evpp::Duration(0.001), [&fired]() { fired = true; });
+    while (count.load() < 21 || !fired.load()) {
+        usleep(1000);
+    }
+    s = loop->busy_poll_stats();
+    H_TEST_ASSERT(s.blocks > 0);
+    H_TEST_ASSERT(s.idle_spin_ns > 0 && s.idle_spin_ns <= s.spin_ns);
+    H_TEST_ASSERT(s.wakeup_samples > 0);
+    H_TEST_ASSERT(s.avg_wakeup_ns() > 0);
+    H_TEST_ASSERT(s.saved_ns() >= 0);
+
+    t.Stop(true);
+    H_TEST_ASSERT(evpp::GetActiveEventCount() == 0);
+}
+
+TEST_UNIT(TestEventLoopBusyPollAdaptive) {
+    evpp::EventLoopThread t;
+    t.loop()->SetBusyPoll(evpp::Duration(0.001), true);
+    t.Start(true);
+    evpp::EventLoop* loop = t.loop();
+
+    // Blocked for longer than the spin limit every time, so it shrinks to 0
+    std::atomic<int> count(0);
+    for (int i = 0; i < 10; i++) {
+        usleep(5 * 1000);
+        loop->QueueInLoop([&count]() { count++; });
+    }
+    while (count.load() < 10) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(loop->busy_poll_stats().spin_limit_ns == 0);
+
+    // Woken up soon after blocking, so it grows again
+    for (int i = 0; i < 200 && loop->busy_poll_stats().spin_limit_ns == 0; i++) {
+        loop->QueueInLoop([&count]() { count++; });
+        usleep(50);
+    }
+    int64_t limit = loop->busy_poll_stats().spin_limit_ns;
+    H_TEST_ASSERT(limit > 0 && limit <= 1000000);
+
+    t.Stop(true);
+    H_TEST_ASSERT(evpp::GetActiveEventCount() == 0);
+}
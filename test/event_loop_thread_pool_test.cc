@@ -4,12 +4,14 @@
 #include <evpp/event_watcher.h>
 #include <evpp/event_loop.h>
 #include <evpp/event_loop_thread_pool.h>
+#include <evpp/numa.h>
 
 #include <atomic>
 #include <thread>
 #include <mutex>
 
 #include <set>
+#include <vector>
 
 namespace {
 static std::set<std::thread::id> g_working_tids;
@@ -74,3 +76,176 @@ TEST_UNIT(testEventLoopThreadPool2) {
     H_TEST_ASSERT(evpp::GetActiveEventCount() == 0);
 }
 
+
+namespace {
+static uint32_t IndexOf(evpp::EventLoopThreadPool* pool, evpp::EventLoop* loop) {
+    for (uint32_t i = 0; i < pool->thread_num(); i++) {
+        if (pool->GetNextLoopWithHash(i) == loop) {
+            return i;
+        }
+    }
+    return pool->thread_num();
+}
+}
+
+TEST_UNIT(testEventLoopThreadPoolLoadAwareDispatch) {
+    typedef evpp::ThreadDispatchPolicy P;
+    std::unique_ptr<evpp::EventLoopThread> loop(new evpp::EventLoopThread);
+    loop->Start(true);
+
+    const uint32_t thread_num = 4;
+    std::unique_ptr<evpp::EventLoopThreadPool> pool(new evpp::EventLoopThreadPool(loop->loop(), thread_num));
+    H_TEST_ASSERT(pool->Start(true));
+
+    // The 4th loop has the least load
+    for (uint32_t i = 0; i < thread_num - 1; i++) {
+        pool->AddLoad(pool->GetNextLoopWithHash(i), 100);
+    }
+    for (int i = 0; i < 10; i++) {
+        H_TEST_ASSERT(IndexOf(pool.get(), pool->GetNextLoop(P::kLeastConnections, 0)) == thread_num - 1);
+    }
+
+    // It is chosen whenever it is one of the two choices, i.e. about half of the time
+    int chosen = 0;
+    for (int i = 0; i < 1000; i++) {
+        uint32_t index = IndexOf(pool.get(), pool->GetNextLoop(P::kPowerOfTwoChoices, 0));
+        H_TEST_ASSERT(index < thread_num);
+        chosen += index == thread_num - 1;
+    }
+    H_TEST_ASSERT(chosen > 300);
+
+    pool->AddLoad(pool->GetNextLoopWithHash(thread_num - 1), 200);
+    H_TEST_ASSERT(pool->load(thread_num - 1) == 200);
+    H_TEST_ASSERT(IndexOf(pool.get(), pool->GetNextLoop(P::kLeastConnections, 0)) != thread_num - 1);
+
+    // The loops which are not of the pool are ignored
+    pool->AddLoad(loop->loop(), 1000);
+    for (uint32_t i = 0; i < thread_num - 1; i++) {
+        H_TEST_ASSERT(pool->load(i) == 100);
+    }
+
+    // Block the first loop, so the tasks queued to it are pending
+    std::atomic<bool> blocked(true);
+    evpp::EventLoop* busy = pool->GetNextLoopWithHash(0);
+    busy->QueueInLoop([&blocked]() {
+        while (blocked.load()) {
+            usleep(1000);
+        }
+    });
+    for (int i = 0; i < 10; i++) {
+        busy->QueueInLoop([]() {});
+    }
+    for (int i = 0; i < 10; i++) {
+        H_TEST_ASSERT(pool->GetNextLoop(P::kLeastPendingFunctors, 0) != busy);
+    }
+    blocked.store(false);
+
+    pool->Stop(true);
+    loop->Stop(true);
+    pool.reset();
+    loop.reset();
+    H_TEST_ASSERT(evpp::GetActiveEventCount() == 0);
+}
+
+TEST_UNIT(testEventLoopThreadPoolConsistentHashing) {
+    typedef evpp::ThreadDispatchPolicy P;
+    std::unique_ptr<evpp::EventLoopThread> loop(new evpp::EventLoopThread);
+    loop->Start(true);
+
+    std::unique_ptr<evpp::EventLoopThreadPool> pool4(new evpp::EventLoopThreadPool(loop->loop(), 4));
+    std::unique_ptr<evpp::EventLoopThreadPool> pool5(new evpp::EventLoopThreadPool(loop->loop(), 5));
+    H_TEST_ASSERT(pool4->Start(true));
+    H_TEST_ASSERT(pool5->Start(true));
+
+    // About 1/5 of the keys move to the new loop, and the others stay
+    const int n = 10000;
+    int moved = 0;
+    std::vector<int> counts(5, 0);
+    for (int i = 0; i < n; i++) {
+        uint64_t key = 0x0a000000 + i;
+        uint32_t a = IndexOf(pool4.get(), pool4->GetNextLoop(P::kConsistentHashing, key));
+        uint32_t b = IndexOf(pool5.get(), pool5->GetNextLoop(P::kConsistentHashing, key));
+        H_TEST_ASSERT(a < 4 && b < 5);
+        H_TEST_ASSERT(pool4->GetNextLoop(P::kConsistentHashing, key) == pool4->GetNextLoopWithHash(a));
+        if (a != b) {
+            H_TEST_ASSERT(b == 4);
+            moved++;
+        }
+        counts[b]++;
+    }
+    H_TEST_ASSERT(moved > n / 5 - n / 20 && moved < n / 5 + n / 20);
+    for (int c : counts) {
+        H_TEST_ASSERT(c > n / 5 - n / 20 && c < n / 5 + n / 20);
+    }
+
+    pool4->Stop(true);
+    pool5->Stop(true);
+    loop->Stop(true);
+    pool4.reset();
+    pool5.reset();
+    loop.reset();
+    H_TEST_ASSERT(evpp::GetActiveEventCount() == 0);
+}
+
+TEST_UNIT(testEventLoopThreadPoolNUMAPlacement) {
+    std::unique_ptr<evpp::EventLoopThread> loop(new evpp::EventLoopThread);
+    loop->Start(true);
+
+    const uint32_t thread_num = 4;
+    std::unique_ptr<evpp::EventLoopThreadPool> pool(new evpp::EventLoopThreadPool(loop->loop(), thread_num));
+    pool->SpreadAcrossNUMANodes(true);
+    H_TEST_ASSERT(pool->Start(true));
+    H_TEST_ASSERT(pool->placed());
+
+    // Every loop runs on one CPU of its node
+    for (uint32_t i = 0; i < thread_num; i++) {
+        evpp::EventLoop* l = pool->GetNextLoopWithHash(i);
+        std::vector<int> affinity;
+        std::atomic<bool> done(false);
+        l->RunInLoop([&affinity, &done]() {
+            affinity = evpp::numa::ThreadAffinity();
+            done.store(true);
+        });
+        while (!done.load()) {
+            usleep(1000);
+        }
+
+        H_TEST_ASSERT(affinity.size() == 1);
+        H_TEST_ASSERT(!evpp::numa::CPUsOfNode(pool->numa_node(i)).empty());
+        H_TEST_ASSERT(evpp::numa::NodeOfCPU(affinity[0]) == pool->numa_node(i));
+
+        // The loop is the nearest one to its own CPU
+        evpp::EventLoop* nearest = pool->GetLoopForCPU(affinity[0]);
+        H_TEST_ASSERT(nearest != nullptr);
+        H_TEST_ASSERT(evpp::numa::NodeOfCPU(affinity[0]) == pool->numa_node(IndexOf(pool.get(), nearest)));
+    }
+    H_TEST_ASSERT(pool->GetLoopForCPU(-1) == nullptr);
+
+    pool->Stop(true);
+    loop->Stop(true);
+    pool.reset();
+    loop.reset();
+    H_TEST_ASSERT(evpp::GetActiveEventCount() == 0);
+}
+
+TEST_UNIT(testEventLoopThreadPoolCPUAffinity) {
+    std::unique_ptr<evpp::EventLoopThread> loop(new evpp::EventLoopThread);
+    loop->Start(true);
+
+    // All the loops on the same CPU, the first one allowed
+    int cpu = evpp::numa::AllowedCPUs()[0];
+    std::unique_ptr<evpp::EventLoopThreadPool> pool(new evpp::EventLoopThreadPool(loop->loop(), 2));
+    pool->SetCPUAffinity(std::vector<std::vector<int>>(1, std::vector<int>(1, cpu)));
+    H_TEST_ASSERT(pool->Start(true));
+
+    // The least loaded one of the loops pinned to the CPU
+    pool->AddLoad(pool->GetNextLoopWithHash(0), 1);
+    H_TEST_ASSERT(pool->GetLoopForCPU(cpu) == pool->GetNextLoopWithHash(1));
+    H_TEST_ASSERT(pool->numa_node(0) == evpp::numa::NodeOfCPU(cpu));
+
+    pool->Stop(true);
+    loop->Stop(true);
+    pool.reset();
+    loop.reset();
+    H_TEST_ASSERT(evpp::GetActiveEventCount() == 0);
+}
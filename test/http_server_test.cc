@@ -16,6 +16,8 @@
 #include "evpp/http/service.h"
 #include "evpp/http/context.h"
 #include "evpp/http/http_server.h"
+#include "evpp/compute_pool.h"
+#include "evpp/event_loop_thread_pool.h"
 
 static bool g_stopping = false;
 static void RequestHandler(evpp::EventLoop* loop, const evpp::http::ContextPtr& ctx, const evpp::http::HTTPSendResponseCallback& cb) {
@@ -345,3 +347,78 @@ TEST_UNIT(testHTTPServer909) {
 
 
 
+
+TEST_UNIT(testHTTPServerComputePool) {
+    evpp::http::Server ph(2);
+    ph.SetComputeThreadNum(2);
+    ph.RegisterHandler("/compute", [&ph](evpp::EventLoop* loop, const evpp::http::ContextPtr& ctx, const evpp::http::HTTPSendResponseCallback& cb) {
+        std::string body = ctx->body().ToString();
+        ph.compute_pool()->Compute(loop, [body]() {
+            return "compute=" + std::string(body.rbegin(), body.rend());
+        }, [loop, cb](std::string result) {
+            H_TEST_ASSERT(loop->IsInLoopThread());
+            cb(result);
+        });
+    });
+    bool r = ph.Init(g_listening_port) && ph.Start();
+    H_TEST_ASSERT(r);
+    H_TEST_ASSERT(ph.compute_pool() && ph.compute_pool()->IsRunning());
+
+    evpp::EventLoopThread t;
+    t.Start(true);
+    std::atomic<int> finished(0);
+    const int kRequests = 10;
+    for (int i = 0; i < kRequests; i++) {
+        auto req = new evpp::httpc::Request(t.loop(), GetHttpServerURL() + "/compute", "abc", evpp::Duration(10.0));
+        req->Execute([req, &finished](const std::shared_ptr<evpp::httpc::Response>& response) {
+            H_TEST_ASSERT(response->body().ToString() == "compute=cba");
+            finished++;
+            delete req;
+        });
+    }
+    while (finished.load() < kRequests) {
+        usleep(1000);
+    }
+
+    t.Stop(true);
+    ph.Stop();
+    H_TEST_ASSERT(ph.compute_pool()->IsStopped());
+    usleep(1000 * 1000); // sleep a while to release the listening address and port
+}
+
+TEST_UNIT(testHTTPServerRequestLoad) {
+    evpp::http::Server ph(2);
+    ph.SetThreadDispatchPolicy(evpp::ThreadDispatchPolicy::kLeastConnections);
+    ph.RegisterHandler("/reply", [](evpp::EventLoop* loop, const evpp::http::ContextPtr& ctx, const evpp::http::HTTPSendResponseCallback& cb) {
+        cb("ok");
+    });
+
+    // The response callback is dropped without replying, which still drops the load
+    ph.RegisterHandler("/drop", [](evpp::EventLoop* loop, const evpp::http::ContextPtr& ctx, const evpp::http::HTTPSendResponseCallback& cb) {
+    });
+    bool r = ph.Init(g_listening_port) && ph.Start();
+    H_TEST_ASSERT(r);
+
+    evpp::EventLoopThread t;
+    t.Start(true);
+    std::atomic<int> finished(0);
+    const char* uris[] = { "/reply", "/reply", "/drop" };
+    for (auto uri : uris) {
+        auto req = new evpp::httpc::Request(t.loop(), GetHttpServerURL() + uri, "", evpp::Duration(0.5));
+        req->Execute([req, &finished](const std::shared_ptr<evpp::httpc::Response>&) {
+            finished++;
+            delete req;
+        });
+    }
+    while (finished.load() < 3) {
+        usleep(1000);
+    }
+
+    for (uint32_t i = 0; i < ph.pool()->thread_num(); i++) {
+        H_TEST_EQUAL(ph.pool()->load(i), 0);
+    }
+
+    t.Stop(true);
+    ph.Stop();
+    usleep(1000 * 1000); // sleep a while to release the listening address and port
+}
@@ -0,0 +1,133 @@
+#include "test_common.h"
+
+#include <evpp/libevent.h>
+#include <evpp/event_loop.h>
+#include <evpp/event_loop_thread.h>
+#include <evpp/io_uring_engine.h>
+#include <evpp/tcp_server.h>
+#include <evpp/tcp_client.h>
+#include <evpp/tcp_conn.h>
+#include <evpp/buffer.h>
+
+#include <thread>
+
+#ifdef H_OS_LINUX
+TEST_UNIT(testIoUringEngineRecvSend) {
+    evpp::EventLoop::SetDefaultIOBackend(evpp::EventLoop::kIoUring);
+    evpp::EventLoop loop;
+    evpp::EventLoop::SetDefaultIOBackend(evpp::EventLoop::kLibevent);
+    evpp::IoUringEngine* engine = loop.io_uring();
+    if (!engine) {
+        // The kernel doesn't support it, the loop falls back to libevent
+        H_TEST_EQUAL(loop.io_backend(), evpp::EventLoop::kLibevent);
+        return;
+    }
+    H_TEST_EQUAL(loop.io_backend(), evpp::EventLoop::kIoUring);
+
+    evpp_socket_t fds[2];
+    H_TEST_EQUAL(evutil_socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    std::string received;
+    int sent = 0;
+    auto recv_op = std::make_shared<evpp::IoUringEngine::Operation>();
+    auto send_op = std::make_shared<evpp::IoUringEngine::Operation>();
+    recv_op->handler = [&](int res, const char* data, bool more) {
+        if (res > 0) {
+            received.append(data, res);
+        }
+
+        if (received.size() == 10) {
+            engine->Cancel(recv_op);
+        }
+
+        if (res == -ECANCELED) {
+            loop.Stop();
+        }
+    };
+    send_op->handler = [&](int res, const char*, bool) {
+        sent += res;
+        if (sent < 10) {
+            engine->Send(send_op, fds[0], "56789", 5, std::shared_ptr<void>());
+        }
+    };
+
+    loop.QueueInLoop([&]() {
+        engine->Recv(recv_op, fds[1], std::shared_ptr<void>());
+        engine->Send(send_op, fds[0], "01234", 5, std::shared_ptr<void>());
+        H_TEST_EQUAL(engine->inflight(), 2u);
+    });
+    loop.Run();
+
+    H_TEST_EQUAL(received, std::string("0123456789"));
+    H_TEST_EQUAL(sent, 10);
+    H_TEST_EQUAL(engine->inflight(), 0u);
+    H_TEST_ASSERT(!recv_op->pending());
+    EVUTIL_CLOSESOCKET(fds[0]);
+    EVUTIL_CLOSESOCKET(fds[1]);
+}
+
+TEST_UNIT(testIoUringEngineEcho) {
+    evpp::EventLoop::SetDefaultIOBackend(evpp::EventLoop::kIoUring);
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    const std::string addr = "127.0.0.1:19373";
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr, "EchoServer", 2));
+    tsrv->SetMessageCallback([](const evpp::TCPConnPtr& conn, evpp::Buffer* msg) {
+        conn->Send(msg);
+    });
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    // Larger than all the provided buffers of a loop
+    const size_t kTotal = 4 * 1024 * 1024;
+    std::string payload(kTotal, 'x');
+    for (size_t i = 0; i < kTotal; i++) {
+        payload[i] = char('a' + i % 26);
+    }
+
+    std::atomic<size_t> received(0);
+    std::atomic<bool> matched(true);
+    std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), addr, "EchoClient"));
+    client->SetConnectionCallback([&payload](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            // Many sends in one loop iteration
+            for (size_t i = 0; i < payload.size(); i += 65536) {
+                conn->Send(payload.data() + i, 65536);
+            }
+        }
+    });
+    client->SetMessageCallback([&](const evpp::TCPConnPtr& conn, evpp::Buffer* msg) {
+        size_t offset = received.load();
+        if (msg->length() + offset > payload.size() ||
+                memcmp(msg->data(), payload.data() + offset, msg->length()) != 0) {
+            matched = false;
+        }
+        received += msg->length();
+        msg->Reset();
+    });
+    client->Connect();
+
+    for (int i = 0; i < 10000 && received.load() < kTotal; i++) {
+        usleep(1000);
+    }
+    H_TEST_EQUAL(received.load(), kTotal);
+    H_TEST_ASSERT(matched.load());
+
+    client->Disconnect();
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+
+    client_thread->Stop(true);
+    server_thread->Stop(true);
+    client.reset();
+    tsrv.reset();
+    client_thread.reset();
+    server_thread.reset();
+    evpp::EventLoop::SetDefaultIOBackend(evpp::EventLoop::kLibevent);
+}
+#endif
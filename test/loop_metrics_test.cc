@@ -0,0 +1,104 @@
+#include "test_common.h"
+
+#include <evpp/event_loop.h>
+#include <evpp/event_loop_thread_pool.h>
+#include <evpp/fd_channel.h>
+#include <evpp/loop_metrics.h>
+#include <evpp/libevent.h>
+
+#include <thread>
+
+TEST_UNIT(testHistogram) {
+    H_TEST_EQUAL(evpp::Histogram::BucketIndex(0), 0u);
+    H_TEST_EQUAL(evpp::Histogram::BucketIndex(1), 0u);
+    H_TEST_EQUAL(evpp::Histogram::BucketIndex(2), 1u);
+    H_TEST_EQUAL(evpp::Histogram::BucketIndex(3), 1u);
+    H_TEST_EQUAL(evpp::Histogram::BucketIndex(1024), 10u);
+    H_TEST_EQUAL(evpp::Histogram::BucketIndex(uint64_t(-1)), size_t(evpp::Histogram::kBuckets - 1));
+
+    evpp::Histogram h;
+    for (uint64_t i = 1; i <= 100; i++) {
+        h.Record(i);
+    }
+    evpp::HistogramSnapshot s = h.Snapshot();
+    H_TEST_EQUAL(s.count, 100u);
+    H_TEST_EQUAL(s.sum, 5050u);
+    H_TEST_EQUAL(s.max, 100u);
+    H_TEST_EQUAL(s.Percentile(50), 63u); // 50 is in the bucket [32, 64)
+    H_TEST_EQUAL(s.Percentile(100), 100u);
+
+    evpp::HistogramSnapshot merged;
+    merged.Merge(s);
+    merged.Merge(s);
+    H_TEST_EQUAL(merged.count, 200u);
+    H_TEST_EQUAL(merged.max, 100u);
+}
+
+TEST_UNIT(testLoopMetricsDisabled) {
+    evpp::EventLoop loop;
+    H_TEST_ASSERT(loop.metrics() == nullptr);
+    loop.QueueInLoop([&loop]() { loop.Stop(); });
+    loop.Run();
+    H_TEST_EQUAL(loop.metrics_snapshot().queue_latency.count, 0u);
+    H_TEST_EQUAL(loop.metrics_snapshot().pending_batch.count, 0u);
+}
+
+TEST_UNIT(testLoopMetricsPool) {
+    evpp::EventLoopThreadPool pool(nullptr, 2);
+    pool.EnableMetrics(true);
+    pool.Start(true);
+
+    const int kCount = 100;
+    std::atomic<int> count(0);
+    for (int i = 0; i < kCount; i++) {
+        pool.GetNextLoop()->QueueInLoop([&count]() { count++; });
+    }
+
+    std::vector<evpp::Task> tasks;
+    tasks.push_back(evpp::Task([&count]() { count++; }));
+    pool.GetNextLoop()->QueueInLoopBatch(tasks);
+
+    evpp::EventLoop* loop = pool.GetNextLoop();
+    loop->RunAfter(evpp::Duration(0.01), evpp::Task([&count]() { count++; }), evpp::InvokeTimer::kWheelTimer);
+    loop->RunAfter(evpp::Duration(0.01), [&count]() { count++; });
+
+    // An FdChannel read callback
+    evpp_socket_t fds[2];
+    H_TEST_EQUAL(evutil_socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    std::shared_ptr<evpp::FdChannel> chan;
+    loop->RunInLoop([&]() {
+        chan.reset(new evpp::FdChannel(loop, fds[1], true, false));
+        chan->SetReadCallback([&]() {
+            char buf[16];
+            if (::recv(fds[1], buf, sizeof(buf), 0) > 0) {
+                count++;
+            }
+        });
+        chan->AttachToLoop();
+    });
+    H_TEST_EQUAL(::send(fds[0], "x", 1, 0), 1);
+
+    while (count.load() != kCount + 4) {
+        usleep(1000);
+    }
+
+    loop->RunInLoop([&]() {
+        chan->DisableAllEvent();
+        chan->Close();
+        chan.reset();
+    });
+
+    // The last functor is counted after it returns
+    usleep(10 * 1000);
+    evpp::LoopMetricsSnapshot s = pool.metrics_snapshot();
+    H_TEST_ASSERT(s.queue_latency.count >= uint64_t(kCount + 1));
+    H_TEST_ASSERT(s.pending_batch.count > 0);
+    H_TEST_ASSERT(s.pending_depth.count > 0);
+    H_TEST_ASSERT(s.timer_lateness.count >= 2u);
+    H_TEST_ASSERT(s.fd_read.count >= 1u);
+    H_TEST_ASSERT(!s.ToString().empty());
+
+    pool.Stop(true);
+    EVUTIL_CLOSESOCKET(fds[0]);
+    EVUTIL_CLOSESOCKET(fds[1]);
+}
@@ -0,0 +1,131 @@
+#include "test_common.h"
+
+#include <evpp/mpsc_queue.h>
+
+#include <thread>
+#include <vector>
+
+TEST_UNIT(testMPSCQueuePushPop) {
+    evpp::MPSCQueue<int> q;
+    int v = 0;
+    H_TEST_ASSERT(q.Empty());
+    H_TEST_ASSERT(!q.Pop(v));
+
+    for (int i = 0; i < 100; i++) {
+        q.Push(i);
+    }
+
+    for (int i = 0; i < 100; i++) {
+        H_TEST_ASSERT(q.Pop(v));
+        H_TEST_EQUAL(v, i);
+    }
+
+    H_TEST_ASSERT(q.Empty());
+}
+
+TEST_UNIT(testMPSCQueueDrainLeavesRequeued) {
+    evpp::MPSCQueue<int> q;
+    q.Push(1);
+    q.Push(2);
+    int sum = 0;
+    size_t n = q.Drain([&q, &sum](int& v) {
+        sum += v;
+        q.Push(v * 10); // Pushed during the draining, left to the next round
+    });
+    H_TEST_EQUAL(n, 2u);
+    H_TEST_EQUAL(sum, 3);
+    H_TEST_ASSERT(!q.Empty());
+
+    n = q.Drain([&sum](int& v) {
+        sum += v;
+    });
+    H_TEST_EQUAL(n, 2u);
+    H_TEST_EQUAL(sum, 33);
+    H_TEST_ASSERT(q.Empty());
+}
+
+TEST_UNIT(testMPSCQueueDrainRecursively) {
+    evpp::MPSCQueue<int> q;
+    for (int i = 0; i < 4; i++) {
+        q.Push(i);
+    }
+
+    // The inner drain consumes the rest, including the last value of the
+    // outer one, and what is pushed during it is left to the next round
+    std::vector<int> outer;
+    std::vector<int> inner;
+    size_t n = q.Drain([&](int& v) {
+        outer.push_back(v);
+        q.Push(v + 100);
+        if (v == 0) {
+            q.Drain([&](int& w) {
+                inner.push_back(w);
+                q.Push(w + 1000);
+            });
+        }
+    });
+    H_TEST_EQUAL(n, 1u);
+    H_TEST_EQUAL(outer.size(), 1u);
+    H_TEST_EQUAL(inner.size(), 4u);
+    H_TEST_EQUAL(inner[0], 1);
+    H_TEST_EQUAL(inner[3], 100);
+
+    n = q.Drain([](int&) {});
+    H_TEST_EQUAL(n, 4u);
+    H_TEST_ASSERT(q.Empty());
+}
+
+TEST_UNIT(testMPSCQueuePushBatch) {
+    evpp::MPSCQueue<int> q;
+    std::vector<int> batch;
+    H_TEST_EQUAL(q.PushBatch(batch.begin(), batch.end()), 0u);
+    H_TEST_ASSERT(q.Empty());
+
+    q.Push(0);
+    for (int i = 1; i < 10; i++) {
+        batch.push_back(i);
+    }
+    H_TEST_EQUAL(q.PushBatch(batch.begin(), batch.end()), 9u);
+    q.Push(10);
+
+    int expected = 0;
+    size_t n = q.Drain([&expected](int& v) {
+        H_TEST_EQUAL(v, expected);
+        expected++;
+    });
+    H_TEST_EQUAL(n, 11u);
+    H_TEST_ASSERT(q.Empty());
+}
+
+TEST_UNIT(testMPSCQueueMultiProducers) {
+    const int kProducers = 4;
+    const int kCount = 100000;
+    evpp::MPSCQueue<std::pair<int, int>> q;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; p++) {
+        producers.push_back(std::thread([&q, p, kCount]() {
+            for (int i = 0; i < kCount; i++) {
+                q.Push(std::make_pair(p, i));
+            }
+        }));
+    }
+
+    // Every producer's values are popped in the order they are pushed
+    std::vector<int> next(kProducers, 0);
+    int total = 0;
+    std::pair<int, int> v;
+    while (total < kProducers * kCount) {
+        if (!q.Pop(v)) {
+            std::this_thread::yield();
+            continue;
+        }
+        H_TEST_EQUAL(v.second, next[v.first]);
+        next[v.first]++;
+        total++;
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+    H_TEST_ASSERT(q.Empty());
+}
@@ -0,0 +1,51 @@
+#include "test_common.h"
+
+#include <evpp/numa.h>
+
+#include <algorithm>
+#include <thread>
+
+TEST_UNIT(testNUMAParseCPUList) {
+    std::vector<int> expected = { 0, 1, 2, 3, 8, 10, 11 };
+    H_TEST_ASSERT(evpp::numa::ParseCPUList("0-3,8,10-11") == expected);
+    H_TEST_ASSERT(evpp::numa::ParseCPUList("5") == std::vector<int>(1, 5));
+    H_TEST_ASSERT(evpp::numa::ParseCPUList("").empty());
+}
+
+TEST_UNIT(testNUMATopology) {
+    std::vector<int> allowed = evpp::numa::AllowedCPUs();
+    H_TEST_ASSERT(!allowed.empty());
+    H_TEST_ASSERT(evpp::numa::NodeCount() >= 1);
+
+    // Every allowed CPU is on exactly one node
+    size_t total = 0;
+    for (int n = 0; n < evpp::numa::NodeCount(); ++n) {
+        std::vector<int> cpus = evpp::numa::CPUsOfNode(n);
+        for (int cpu : cpus) {
+            H_TEST_ASSERT(std::find(allowed.begin(), allowed.end(), cpu) != allowed.end());
+            H_TEST_ASSERT(evpp::numa::NodeOfCPU(cpu) == n);
+        }
+        total += cpus.size();
+    }
+    H_TEST_ASSERT(total == allowed.size());
+    H_TEST_ASSERT(evpp::numa::CPUsOfNode(-1).empty());
+    H_TEST_ASSERT(evpp::numa::CPUsOfNode(evpp::numa::NodeCount()).empty());
+}
+
+TEST_UNIT(testNUMAPinThread) {
+    std::vector<int> allowed = evpp::numa::AllowedCPUs();
+    int cpu = allowed.back();
+    std::vector<int> affinity;
+    bool pinned = false;
+    bool preferred = false;
+    std::thread t([&]() {
+        pinned = evpp::numa::PinThread(std::vector<int>(1, cpu));
+        affinity = evpp::numa::ThreadAffinity();
+        preferred = evpp::numa::PreferNode(evpp::numa::NodeOfCPU(cpu)) && evpp::numa::PreferNode(-1);
+    });
+    t.join();
+    H_TEST_ASSERT(pinned);
+    H_TEST_ASSERT(affinity == std::vector<int>(1, cpu));
+    H_TEST_ASSERT(preferred);
+    H_TEST_ASSERT(!evpp::numa::PinThread(std::vector<int>()));
+}
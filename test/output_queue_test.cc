@@ -0,0 +1,663 @@
+#include "test_common.h"
+
+#include <evpp/libevent.h>
+#include <evpp/output_queue.h>
+#include <evpp/event_loop_thread.h>
+#include <evpp/tcp_server.h>
+#include <evpp/tcp_client.h>
+#include <evpp/tcp_conn.h>
+#include <evpp/sockets.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using evpp::Buffer;
+using evpp::BufferPtr;
+using evpp::OutputQueue;
+using std::string;
+
+namespace {
+string ReadAll(OutputQueue& q) {
+    string s;
+    while (!q.empty()) {
+        s.append(q.data(), q.front_length());
+        q.Next(q.front_length());
+    }
+    return s;
+}
+}
+
+TEST_UNIT(testOutputQueueAppendNext) {
+    OutputQueue q;
+    H_TEST_ASSERT(q.empty());
+
+    // The small pieces are copied into one block
+    q.Append("hello ", 6);
+    q.Append("world", 5);
+    H_TEST_EQUAL(q.length(), 11u);
+    H_TEST_EQUAL(q.block_count(), 1u);
+    H_TEST_EQUAL(string(q.data(), q.front_length()), string("hello world"));
+
+    q.Next(6);
+    H_TEST_EQUAL(q.length(), 5u);
+    H_TEST_EQUAL(string(q.data(), q.front_length()), string("world"));
+
+    // A piece larger than a block goes into a new block as a whole
+    const string large(OutputQueue::kBlockSize * 3, 'x');
+    q.Append(large.data(), large.size());
+    H_TEST_EQUAL(q.block_count(), 2u);
+    H_TEST_EQUAL(q.length(), 5 + large.size());
+    H_TEST_EQUAL(ReadAll(q), "world" + large);
+    H_TEST_EQUAL(q.block_count(), 0u);
+}
+
+TEST_UNIT(testOutputQueueAppendBufferPtr) {
+    OutputQueue q;
+    q.Append("head", 4);
+
+    BufferPtr buf(new Buffer);
+    buf->Append("body");
+    q.Append(buf, buf->data(), buf->length());
+    H_TEST_EQUAL(q.block_count(), 2u);
+    H_TEST_EQUAL(buf.use_count(), 2);
+
+    // The data copied later doesn't go into the block of the user
+    q.Append("tail", 4);
+    H_TEST_EQUAL(q.block_count(), 3u);
+
+    q.Next(4);
+    H_TEST_EQUAL(q.data(), buf->data()); // Not copied
+    H_TEST_EQUAL(ReadAll(q), string("bodytail"));
+    H_TEST_EQUAL(buf.use_count(), 1);
+}
+
+TEST_UNIT(testOutputQueueWriteToFD) {
+    evpp_socket_t fds[2];
+    H_TEST_EQUAL(evutil_socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    evutil_make_socket_nonblocking(fds[0]);
+
+    // More blocks than IOV_MAX, and more data than the socket buffer
+    OutputQueue q;
+    string expected;
+    for (int i = 0; i < 3000; i++) {
+        BufferPtr buf(new Buffer);
+        buf->Append(string(1000, char('a' + i % 26)));
+        q.Append(buf, buf->data(), buf->length());
+        expected += buf->ToString();
+    }
+
+    string received;
+    char tmp[65536];
+    while (!q.empty()) {
+        int serrno = 0;
+        ssize_t n = q.WriteToFD(fds[0], &serrno);
+        H_TEST_ASSERT(n > 0 || EVUTIL_ERR_RW_RETRIABLE(serrno));
+
+        ssize_t r = ::recv(fds[1], tmp, sizeof(tmp), 0);
+        H_TEST_ASSERT(r > 0);
+        received.append(tmp, r);
+    }
+
+    while (received.size() < expected.size()) {
+        ssize_t r = ::recv(fds[1], tmp, sizeof(tmp), 0);
+        H_TEST_ASSERT(r > 0);
+        received.append(tmp, r);
+    }
+    H_TEST_ASSERT(received == expected);
+
+    EVUTIL_CLOSESOCKET(fds[0]);
+    EVUTIL_CLOSESOCKET(fds[1]);
+}
+
+namespace {
+// A temporary file which has the content s, the fd is closed and the file is removed by the destructor
+struct TempFile {
+    explicit TempFile(const string& s) {
+        char name[] = "/tmp/evpp_output_queue_XXXXXX";
+        fd = ::mkstemp(name);
+        ::unlink(name);
+        ssize_t n = ::write(fd, s.data(), s.size());
+        (void)n;
+    }
+    ~TempFile() {
+        ::close(fd);
+    }
+    int fd;
+};
+
+string MakeContent(size_t len) {
+    string s(len, 0);
+    for (size_t i = 0; i < len; i++) {
+        s[i] = char('a' + (i * 7 + i / 1000) % 26);
+    }
+    return s;
+}
+
+// Write q to fds[0] and read it from fds[1] until q is drained
+void WriteAndReceive(OutputQueue& q, evpp_socket_t fds[2], size_t expected_size, string& received) {
+    char tmp[65536];
+    while (!q.empty()) {
+        int serrno = 0;
+        ssize_t n = q.WriteToFD(fds[0], &serrno);
+        H_TEST_ASSERT(n > 0 || EVUTIL_ERR_RW_RETRIABLE(serrno));
+        if (q.blocked_fd() >= 0) {
+            break;
+        }
+
+        ssize_t r = ::recv(fds[1], tmp, sizeof(tmp), 0);
+        H_TEST_ASSERT(r > 0);
+        received.append(tmp, r);
+    }
+
+    while (received.size() < expected_size) {
+        ssize_t r = ::recv(fds[1], tmp, sizeof(tmp), 0);
+        H_TEST_ASSERT(r > 0);
+        received.append(tmp, r);
+    }
+}
+}
+
+TEST_UNIT(testOutputQueueAppendFile) {
+    const string content = MakeContent(1024 * 1024);
+    TempFile f(content);
+
+    evpp_socket_t fds[2];
+    H_TEST_EQUAL(evutil_socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    evutil_make_socket_nonblocking(fds[0]);
+
+    // The file ranges are written in order with the data around them
+    OutputQueue q;
+    q.Append("head", 4);
+    q.AppendFile(f.fd, 100, 500000, std::shared_ptr<void>());
+    q.Append("middle", 6);
+    q.AppendFile(f.fd, 0, 10, std::shared_ptr<void>());
+    q.Append("tail", 4);
+    H_TEST_EQUAL(q.length(), 4 + 500000 + 6 + 10 + 4u);
+    H_TEST_ASSERT(q.footprint() < 100000); // The file ranges are not in the memory
+
+    const string expected = "head" + content.substr(100, 500000) + "middle" + content.substr(0, 10) + "tail";
+    string received;
+    WriteAndReceive(q, fds, expected.size(), received);
+    H_TEST_ASSERT(received == expected);
+
+    // A file shorter than the length queued is an error
+    q.AppendFile(f.fd, content.size() - 10, 20, std::shared_ptr<void>());
+    int serrno = 0;
+    H_TEST_EQUAL(q.WriteToFD(fds[0], &serrno), 10);
+    H_TEST_EQUAL(q.WriteToFD(fds[0], &serrno), -1);
+    H_TEST_EQUAL(serrno, ENODATA);
+
+    EVUTIL_CLOSESOCKET(fds[0]);
+    EVUTIL_CLOSESOCKET(fds[1]);
+}
+
+TEST_UNIT(testOutputQueueAppendPipe) {
+    evpp_socket_t fds[2];
+    H_TEST_EQUAL(evutil_socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    evutil_make_socket_nonblocking(fds[0]);
+    int p[2];
+    H_TEST_EQUAL(::pipe(p), 0);
+
+    OutputQueue q;
+    q.Append("head", 4);
+    q.AppendFile(p[0], 0, 8, std::shared_ptr<void>());
+    q.Append("tail", 4);
+
+    // The pipe is empty, the queue waits for it after the data before it
+    int serrno = 0;
+    H_TEST_EQUAL(q.WriteToFD(fds[0], &serrno), 4);
+    H_TEST_EQUAL(q.blocked_fd(), p[0]);
+    H_TEST_EQUAL(q.WriteToFD(fds[0], &serrno), -1);
+    H_TEST_EQUAL(q.blocked_fd(), p[0]);
+
+    // It arrives in two pieces
+    H_TEST_EQUAL(::write(p[1], "1234", 4), 4);
+    H_TEST_EQUAL(q.WriteToFD(fds[0], &serrno), 4);
+    H_TEST_EQUAL(q.blocked_fd(), p[0]);
+    H_TEST_EQUAL(::write(p[1], "5678", 4), 4);
+    H_TEST_EQUAL(q.WriteToFD(fds[0], &serrno), 8);
+    H_TEST_EQUAL(q.blocked_fd(), -1);
+    H_TEST_ASSERT(q.empty());
+
+    char tmp[64];
+    H_TEST_EQUAL(::recv(fds[1], tmp, sizeof(tmp), 0), 16);
+    H_TEST_EQUAL(string(tmp, 16), string("head12345678tail"));
+
+    ::close(p[0]);
+    ::close(p[1]);
+    EVUTIL_CLOSESOCKET(fds[0]);
+    EVUTIL_CLOSESOCKET(fds[1]);
+}
+
+TEST_UNIT(testTCPConnSendBufferPtr) {
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    // Larger than the socket buffers, most of it is queued without copying
+    BufferPtr payload(new Buffer);
+    for (int i = 0; i < 8 * 1024; i++) {
+        payload->Append(string(1024, char('a' + i % 26)));
+    }
+    const string expected = payload->ToString();
+
+    const string addr = "127.0.0.1:19374";
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr, "SendBufferPtrServer", 2));
+    tsrv->SetConnectionCallback([payload](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            conn->Send(payload);
+        }
+    });
+    tsrv->SetMessageCallback([](const evpp::TCPConnPtr&, evpp::Buffer*) {});
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    std::atomic<bool> matched(false);
+    string received;
+    std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), addr, "SendBufferPtrClient"));
+    client->SetMessageCallback([&](const evpp::TCPConnPtr& conn, evpp::Buffer* msg) {
+        received.append(msg->data(), msg->length());
+        msg->Reset();
+        if (received.size() == expected.size()) {
+            matched = received == expected;
+        }
+    });
+    client->Connect();
+
+    for (int i = 0; i < 10000 && !matched.load(); i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(matched.load());
+
+    // It is not modified by sending
+    H_TEST_EQUAL(payload->length(), expected.size());
+
+    client->Disconnect(true);
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+
+    client_thread->Stop(true);
+    server_thread->Stop(true);
+    client.reset();
+    tsrv.reset();
+}
+
+TEST_UNIT(testTCPConnSendFile) {
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    const string content = MakeContent(8 * 1024 * 1024);
+    std::shared_ptr<TempFile> file(new TempFile(content));
+    int p[2];
+    H_TEST_EQUAL(::pipe(p), 0);
+
+    // A file larger than the socket buffers, and a pipe which is written
+    // after the connection is established, queued in order with the strings
+    const string expected = "file:" + content + "pipe:" + content.substr(0, 100000) + "end";
+    std::atomic<int> write_complete(0);
+    std::atomic<int> high_water_mark(0);
+    const string addr = "127.0.0.1:19378";
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr, "SendFileServer", 2));
+    tsrv->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            conn->SetWriteCompleteCallback([&](const evpp::TCPConnPtr&) {
+                write_complete++;
+            });
+            conn->SetHighWaterMarkCallback([&](const evpp::TCPConnPtr&, size_t) {
+                high_water_mark++;
+            }, 1024 * 1024);
+            conn->Send("file:");
+            conn->SendFile(file->fd, 0, content.size(), file);
+            conn->Send("pipe:");
+            conn->SendFile(p[0], 0, 100000);
+            conn->Send("end");
+        }
+    });
+    tsrv->SetMessageCallback([](const evpp::TCPConnPtr&, evpp::Buffer*) {});
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    std::atomic<size_t> received_size(0);
+    std::atomic<bool> matched(false);
+    string received;
+    std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), addr, "SendFileClient"));
+    client->set_auto_reconnect(false);
+    client->SetMessageCallback([&](const evpp::TCPConnPtr& conn, evpp::Buffer* msg) {
+        received.append(msg->data(), msg->length());
+        msg->Reset();
+        received_size = received.size();
+        if (received.size() == expected.size()) {
+            matched = received == expected;
+        }
+    });
+    client->Connect();
+
+    // The file is sent, and then it waits for the pipe
+    size_t file_part = 5 + content.size() + 5;
+    for (int i = 0; i < 10000 && received_size.load() < file_part; i++) {
+        usleep(1000);
+    }
+    H_TEST_EQUAL(received_size.load(), file_part);
+
+    // "file:" may be sent directly, which completes a write
+    const int write_complete_before = write_complete.load();
+    H_TEST_ASSERT(write_complete_before <= 1);
+
+    for (size_t off = 0; off < 100000; off += 10000) {
+        H_TEST_EQUAL(::write(p[1], content.data() + off, 10000), 10000);
+        usleep(1000);
+    }
+
+    for (int i = 0; i < 10000 && !matched.load(); i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(matched.load());
+    usleep(10000);
+    H_TEST_EQUAL(write_complete.load(), write_complete_before + 1);
+    H_TEST_EQUAL(high_water_mark.load(), 1);
+
+    client->Disconnect(true);
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+
+    client_thread->Stop(true);
+    server_thread->Stop(true);
+    client.reset();
+    tsrv.reset();
+    ::close(p[0]);
+    ::close(p[1]);
+}
+
+TEST_UNIT(testTCPConnZeroCopy) {
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    BufferPtr payload(new Buffer);
+    payload->Append(MakeContent(4 * 1024 * 1024));
+    const string expected = payload->ToString() + "end";
+
+    // The payload is held until the completions are reaped, even after it is
+    // written. It is not modified, since the kernel may still read it.
+    std::weak_ptr<Buffer> weak_payload(payload);
+    std::atomic<int> zerocopy(-1);
+    const string addr = "127.0.0.1:19379";
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr, "ZeroCopyServer", 2));
+    tsrv->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            zerocopy = conn->SetZeroCopyThreshold(64 * 1024) ? 1 : 0;
+            conn->Send(payload);
+            payload.reset();
+            conn->Send("end");
+        }
+    });
+    tsrv->SetMessageCallback([](const evpp::TCPConnPtr&, evpp::Buffer*) {});
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    std::atomic<bool> matched(false);
+    string received;
+    std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), addr, "ZeroCopyClient"));
+    client->set_auto_reconnect(false);
+    client->SetMessageCallback([&](const evpp::TCPConnPtr& conn, evpp::Buffer* msg) {
+        received.append(msg->data(), msg->length());
+        msg->Reset();
+        if (received.size() == expected.size()) {
+            matched = received == expected;
+            // Trigger the server to read, which reaps the error queue as well
+            conn->Send("x");
+        }
+    });
+    client->Connect();
+
+    for (int i = 0; i < 10000 && !matched.load(); i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(matched.load());
+    H_TEST_ASSERT(zerocopy.load() >= 0);
+
+    // Released after the completion
+    for (int i = 0; i < 10000 && !weak_payload.expired(); i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(weak_payload.expired());
+
+    client->Disconnect(true);
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+
+    client_thread->Stop(true);
+    server_thread->Stop(true);
+    client.reset();
+    tsrv.reset();
+}
+
+TEST_UNIT(testTCPConnZeroCopyClose) {
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    BufferPtr payload(new Buffer);
+    payload->Append(MakeContent(32 * 1024 * 1024));
+    const string expected = payload->ToString();
+
+    // The connection is closed right after the payload is sent, while the
+    // peer doesn't read. The payload is held until the kernel completes the
+    // sends, which is after the peer reads the data.
+    std::weak_ptr<Buffer> weak_payload(payload);
+    std::atomic<int> zerocopy(-1);
+    std::atomic<bool> closed(false);
+    const string addr = "127.0.0.1:19386";
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr, "ZeroCopyCloseServer", 0));
+    tsrv->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            zerocopy = conn->SetZeroCopyThreshold(64 * 1024) ? 1 : 0;
+            conn->Send(payload);
+            payload.reset();
+            conn->Close();
+        } else {
+            closed = true;
+        }
+    });
+    tsrv->SetMessageCallback([](const evpp::TCPConnPtr&, evpp::Buffer*) {});
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    struct sockaddr_storage ss = evpp::sock::ParseFromIPPort(addr.c_str());
+    evpp_socket_t fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    H_TEST_ASSERT(::connect(fd, evpp::sock::sockaddr_cast(&ss), sizeof(struct sockaddr_in)) == 0);
+
+    for (int i = 0; i < 10000 && !closed.load(); i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(closed.load());
+    H_TEST_ASSERT(zerocopy.load() >= 0);
+
+    // The TCPConn is gone, and the pages are still being sent
+    usleep(100 * 1000);
+    H_TEST_EQUAL(tsrv->connection_count(), 0u);
+    if (zerocopy.load() == 1) {
+        H_TEST_ASSERT(!weak_payload.expired());
+    }
+
+    // The data sent before closing is intact, and followed by the end of the stream
+    string received;
+    char tmp[65536];
+    for (;;) {
+        ssize_t n = ::recv(fd, tmp, sizeof(tmp), 0);
+        H_TEST_ASSERT(n >= 0);
+        if (n <= 0) {
+            break;
+        }
+        received.append(tmp, n);
+    }
+    H_TEST_ASSERT(!received.empty());
+    H_TEST_ASSERT(received == expected.substr(0, received.size()));
+
+    // Released after the completions
+    for (int i = 0; i < 10000 && !weak_payload.expired(); i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(weak_payload.expired());
+    EVUTIL_CLOSESOCKET(fd);
+
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+    server_thread->Stop(true);
+    tsrv.reset();
+}
+
+TEST_UNIT(testTCPConnZeroCopyReadPaused) {
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    BufferPtr payload(new Buffer);
+    payload->Append(MakeContent(4 * 1024 * 1024));
+    const string expected = payload->ToString();
+
+    // Reading is paused and nothing is left to write after the payload,
+    // so no event reports the socket when the sends complete
+    std::weak_ptr<Buffer> weak_payload(payload);
+    std::atomic<int> zerocopy(-1);
+    const string addr = "127.0.0.1:19387";
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr, "ZeroCopyPausedServer", 0));
+    tsrv->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            conn->PauseRead();
+            zerocopy = conn->SetZeroCopyThreshold(64 * 1024) ? 1 : 0;
+            conn->Send(payload);
+            payload.reset();
+        }
+    });
+    tsrv->SetMessageCallback([](const evpp::TCPConnPtr&, evpp::Buffer*) {});
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    struct sockaddr_storage ss = evpp::sock::ParseFromIPPort(addr.c_str());
+    evpp_socket_t fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    H_TEST_ASSERT(::connect(fd, evpp::sock::sockaddr_cast(&ss), sizeof(struct sockaddr_in)) == 0);
+
+    string received;
+    char tmp[65536];
+    while (received.size() < expected.size()) {
+        ssize_t n = ::recv(fd, tmp, sizeof(tmp), 0);
+        H_TEST_ASSERT(n > 0);
+        if (n <= 0) {
+            break;
+        }
+        received.append(tmp, n);
+    }
+    H_TEST_ASSERT(received == expected);
+    H_TEST_ASSERT(zerocopy.load() >= 0);
+
+    // Released after the completions, while reading is still paused
+    for (int i = 0; i < 10000 && !weak_payload.expired(); i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(weak_payload.expired());
+
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+    server_thread->Stop(true);
+    tsrv.reset();
+    EVUTIL_CLOSESOCKET(fd);
+}
+
+#if defined(H_OS_LINUX) && defined(SO_ZEROCOPY)
+namespace {
+// A connected pair of TCP sockets on the loopback. MSG_ZEROCOPY is not
+// supported by the unix domain sockets.
+bool TCPSocketPair(evpp_socket_t fds[2]) {
+    evpp_socket_t l = ::socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(sa);
+    if (::bind(l, evpp::sock::sockaddr_cast(&sa), sizeof(sa)) != 0 || ::listen(l, 1) != 0
+            || ::getsockname(l, evpp::sock::sockaddr_cast(&sa), &len) != 0) {
+        EVUTIL_CLOSESOCKET(l);
+        return false;
+    }
+
+    fds[1] = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (::connect(fds[1], evpp::sock::sockaddr_cast(&sa), sizeof(sa)) != 0) {
+        EVUTIL_CLOSESOCKET(fds[1]);
+        EVUTIL_CLOSESOCKET(l);
+        return false;
+    }
+    fds[0] = ::accept(l, nullptr, nullptr);
+    EVUTIL_CLOSESOCKET(l);
+    return fds[0] >= 0;
+}
+}
+
+TEST_UNIT(testOutputQueueResetZeroCopy) {
+    evpp_socket_t fds[2];
+    H_TEST_ASSERT(TCPSocketPair(fds));
+    int on = 1;
+    if (::setsockopt(fds[0], SOL_SOCKET, SO_ZEROCOPY, &on, sizeof(on)) != 0) {
+        // Not supported by the kernel
+        EVUTIL_CLOSESOCKET(fds[0]);
+        EVUTIL_CLOSESOCKET(fds[1]);
+        return;
+    }
+    evutil_make_socket_nonblocking(fds[0]);
+    evutil_make_socket_nonblocking(fds[1]);
+
+    // More than the socket buffers can take. The peer doesn't read,
+    // so the data sent stays in the socket and its pages are pinned.
+    BufferPtr payload(new Buffer);
+    payload->Append(MakeContent(32 * 1024 * 1024));
+    std::weak_ptr<Buffer> weak_payload(payload);
+    OutputQueue q;
+    q.set_zerocopy_threshold(64 * 1024);
+    q.Append(payload, payload->data(), payload->length());
+    payload.reset();
+
+    int serrno = 0;
+    ssize_t n = q.WriteToFD(fds[0], &serrno);
+    H_TEST_ASSERT(n > 0);
+    H_TEST_ASSERT(!q.empty());
+    H_TEST_ASSERT(q.zerocopy_inflight());
+
+    // The block partly sent is dropped, but its holder is kept
+    q.Reset();
+    H_TEST_ASSERT(q.empty());
+    H_TEST_EQUAL(q.zerocopy_pending(), 1u);
+    H_TEST_ASSERT(!weak_payload.expired());
+
+    // Released after the peer receives the data
+    char tmp[65536];
+    size_t received = 0;
+    for (int i = 0; i < 10000 && (received < size_t(n) || q.zerocopy_inflight()); i++) {
+        ssize_t r = ::recv(fds[1], tmp, sizeof(tmp), 0);
+        if (r > 0) {
+            received += r;
+        } else {
+            usleep(1000);
+        }
+        q.ReapZeroCopy(fds[0]);
+    }
+    H_TEST_EQUAL(received, size_t(n));
+    H_TEST_ASSERT(!q.zerocopy_inflight());
+    H_TEST_EQUAL(q.zerocopy_pending(), 0u);
+    H_TEST_ASSERT(weak_payload.expired());
+
+    EVUTIL_CLOSESOCKET(fds[0]);
+    EVUTIL_CLOSESOCKET(fds[1]);
+}
+#endif
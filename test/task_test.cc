@@ -0,0 +1,68 @@
+#include "test_common.h"
+
+#include <evpp/task.h>
+#include <evpp/event_loop.h>
+#include <evpp/event_loop_thread.h>
+
+#include <thread>
+
+TEST_UNIT(testTaskInline) {
+    std::shared_ptr<int> p(new int(1));
+    std::string s = "hello";
+    auto f = [p, s]() { (*p)++; };
+    H_TEST_ASSERT(evpp::Task::IsInline<decltype(f)>());
+
+    evpp::Task t(std::move(f));
+    H_TEST_ASSERT(static_cast<bool>(t));
+    t();
+    t();
+    H_TEST_EQUAL(*p, 3);
+
+    evpp::Task t2(std::move(t));
+    H_TEST_ASSERT(!static_cast<bool>(t));
+    t2();
+    H_TEST_EQUAL(*p, 4);
+    t2.Reset();
+    H_TEST_ASSERT(p.use_count() == 1);
+}
+
+TEST_UNIT(testTaskHeap) {
+    char big[256] = {};
+    std::shared_ptr<int> p(new int(0));
+    auto f = [p, big]() { (*p) += big[0] + 1; };
+    H_TEST_ASSERT(!evpp::Task::IsInline<decltype(f)>());
+
+    evpp::Task t(std::move(f));
+    evpp::Task t2;
+    t2 = std::move(t);
+    t2();
+    H_TEST_EQUAL(*p, 1);
+    t2 = evpp::Task();
+    H_TEST_ASSERT(p.use_count() == 1);
+}
+
+TEST_UNIT(testTaskEmptyFunction) {
+    std::function<void()> empty;
+    evpp::Task t(empty);
+    H_TEST_ASSERT(!static_cast<bool>(t));
+}
+
+TEST_UNIT(testTaskQueueInLoop) {
+    evpp::EventLoopThread t;
+    t.Start(true);
+    std::atomic<int> count(0);
+    std::unique_ptr<int> move_only(new int(10));
+    int* raw = move_only.get();
+    auto f = std::bind([&count, raw](std::unique_ptr<int>& v) {
+        H_TEST_ASSERT(v.get() == raw);
+        count++;
+    }, std::move(move_only));
+    t.loop()->QueueInLoop(evpp::Task(std::move(f)));
+    t.loop()->RunInLoop(evpp::Task([&count]() { count++; }));
+    t.loop()->RunAfter(evpp::Duration(0.01), evpp::Task([&count]() { count++; }));
+    while (count.load() != 3) {
+        usleep(1000);
+    }
+    t.Stop(true);
+    H_TEST_ASSERT(t.IsStopped());
+}
@@ -8,7 +8,13 @@
 #include <evpp/buffer.h>
 #include <evpp/tcp_conn.h>
 #include <evpp/tcp_client.h>
+#include <evpp/listener.h>
+#include <evpp/sockets.h>
+#include <evpp/numa.h>
 
+#include <map>
+#include <mutex>
+#include <set>
 #include <thread>
 
 namespace {
@@ -131,3 +137,742 @@ TEST_UNIT(testTCPServerSilenceShutdown2) {
     H_TEST_ASSERT(evpp::GetActiveEventCount() == 0);
 }
 
+
+TEST_UNIT(testTCPConnSendFromOtherThreads) {
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    const std::string addr2 = "127.0.0.1:19375";
+    std::mutex mutex;
+    evpp::TCPConnPtr server_conn;
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr2, "SendFromOtherThreadsServer", 2));
+    tsrv->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            std::lock_guard<std::mutex> guard(mutex);
+            server_conn = conn;
+        }
+    });
+    tsrv->SetMessageCallback([](const evpp::TCPConnPtr&, evpp::Buffer*) {});
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    // Every message is 8 bytes : the index of the sending thread and the sequence
+    const int kThreads = 4;
+    const int kMessages = 20000;
+    std::atomic<int> received(0);
+    std::atomic<bool> ordered(true);
+    std::vector<int> next_seq(kThreads, 0);
+    std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), addr2, "SendFromOtherThreadsClient"));
+    client->SetMessageCallback([&](const evpp::TCPConnPtr& conn, evpp::Buffer* msg) {
+        while (msg->length() >= 8) {
+            std::string m = msg->NextString(8);
+            int t = m[0] - '0';
+            int seq = std::atoi(m.c_str() + 1);
+            if (t < 0 || t >= kThreads || seq != next_seq[t]++) {
+                ordered = false;
+            }
+            received++;
+        }
+    });
+    client->Connect();
+
+    for (int i = 0; i < 10000; i++) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (server_conn) {
+            break;
+        }
+        usleep(1000);
+    }
+    H_TEST_ASSERT(server_conn.get());
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.push_back(std::thread([t, server_conn]() {
+            for (int i = 0; i < kMessages; i++) {
+                char m[16];
+                snprintf(m, sizeof(m), "%d%07d", t, i);
+                switch (i % 4) {
+                case 0:
+                    server_conn->Send(std::string(m, 8));
+                    break;
+                case 1: {
+                    evpp::Buffer buf;
+                    buf.Append(m, 8);
+                    server_conn->Send(std::move(buf));
+                    H_TEST_EQUAL(buf.length(), 0u);
+                    break;
+                }
+                case 2: {
+                    evpp::BufferPtr buf(new evpp::Buffer);
+                    buf->Append(m, 8);
+                    server_conn->Send(buf);
+                    break;
+                }
+                default:
+                    server_conn->Send(evpp::Slice(m, 8));
+                    break;
+                }
+            }
+        }));
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (int i = 0; i < 10000 && received.load() < kThreads * kMessages; i++) {
+        usleep(1000);
+    }
+    H_TEST_EQUAL(received.load(), kThreads * kMessages);
+    H_TEST_ASSERT(ordered.load());
+
+    server_conn.reset();
+    client->Disconnect(true);
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+
+    client_thread->Stop(true);
+    server_thread->Stop(true);
+    client.reset();
+    tsrv.reset();
+}
+
+TEST_UNIT(testTCPConnAutoCork) {
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    // Every request is answered with many small responses in one callback,
+    // and the connection is closed right after the last one
+    const int kResponses = 1000;
+    const std::string addr2 = "127.0.0.1:19376";
+    std::atomic<int> write_completed(0);
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr2, "AutoCorkServer", 2));
+    tsrv->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            conn->SetAutoCork(true);
+            conn->SetWriteCompleteCallback([&](const evpp::TCPConnPtr&) {
+                write_completed++;
+            });
+        }
+    });
+    tsrv->SetMessageCallback([](const evpp::TCPConnPtr& conn, evpp::Buffer* msg) {
+        H_TEST_ASSERT(conn->auto_cork());
+        while (msg->length() >= 4) {
+            std::string req = msg->NextString(4);
+            for (int i = 0; i < kResponses; i++) {
+                char m[16];
+                snprintf(m, sizeof(m), "%07d", i);
+                conn->Send(m, 8);
+            }
+
+            if (req == "quit") {
+                conn->Close();
+                return;
+            }
+            conn->Flush();
+        }
+    });
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    std::atomic<int> received(0);
+    std::atomic<bool> ordered(true);
+    std::atomic<bool> closed(false);
+    std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), addr2, "AutoCorkClient"));
+    client->set_auto_reconnect(false);
+    client->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            conn->Send("ping");
+            conn->Send("quit");
+        } else {
+            closed = true;
+        }
+    });
+    client->SetMessageCallback([&](const evpp::TCPConnPtr& conn, evpp::Buffer* msg) {
+        while (msg->length() >= 8) {
+            std::string m = msg->NextString(8);
+            if (std::atoi(m.c_str()) != received.load() % kResponses) {
+                ordered = false;
+            }
+            received++;
+        }
+
+        // Disconnect before the close of the server is read, which leaves
+        // the client nothing to disconnect
+        if (received.load() == 2 * kResponses) {
+            client->Disconnect();
+        }
+    });
+    client->Connect();
+
+    for (int i = 0; i < 10000 && !closed.load(); i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(closed.load());
+    H_TEST_EQUAL(received.load(), 2 * kResponses);
+    H_TEST_ASSERT(ordered.load());
+    H_TEST_ASSERT(write_completed.load() >= 1);
+
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+
+    client_thread->Stop(true);
+    server_thread->Stop(true);
+    client.reset();
+    tsrv.reset();
+}
+
+namespace {
+// Send a burst of data to a server which consumes all of it, and then the
+// small messages. Return the memory footprint of the server side connection
+// after the burst and after the small messages.
+void RunBurstThenIdle(bool release_when_idle, size_t* after_burst, size_t* after_small) {
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    const size_t kBurst = 4 * 1024 * 1024;
+    const int kSmallMessages = 200;
+    const std::string addr2 = "127.0.0.1:19377";
+    std::atomic<size_t> received(0);
+    evpp::TCPConnPtr server_conn;
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr2, "BurstServer", 1));
+    tsrv->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            conn->SetReleaseBuffersWhenIdle(release_when_idle);
+            server_conn = conn;
+        }
+    });
+    tsrv->SetMessageCallback([&](const evpp::TCPConnPtr&, evpp::Buffer* msg) {
+        // Consume it only when a lot has been received, so the input buffer grows
+        if (msg->length() >= 512 * 1024 || received.load() + msg->length() >= kBurst) {
+            received += msg->length();
+            msg->Reset();
+        }
+    });
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), addr2, "BurstClient"));
+    client->set_auto_reconnect(false);
+    client->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            conn->Send(std::string(kBurst, 'x'));
+        }
+    });
+    client->Connect();
+
+    auto footprint = [&]() {
+        std::atomic<size_t> n(0);
+        std::atomic<bool> done(false);
+        server_thread->loop()->RunInLoop([&]() {
+            n = server_conn->memory_footprint();
+            done = true;
+        });
+        while (!done.load()) {
+            usleep(1000);
+        }
+        return n.load();
+    };
+
+    for (int i = 0; i < 10000 && received.load() < kBurst; i++) {
+        usleep(1000);
+    }
+    H_TEST_EQUAL(received.load(), kBurst);
+    *after_burst = footprint();
+
+    for (int i = 0; i < kSmallMessages; i++) {
+        size_t expected = received.load() + 100;
+        client->conn()->Send(std::string(100, 'y'));
+        for (int j = 0; j < 10000 && received.load() < expected; j++) {
+            usleep(100);
+        }
+    }
+    H_TEST_EQUAL(received.load(), kBurst + kSmallMessages * 100);
+    *after_small = footprint();
+
+    server_conn.reset();
+    client->Disconnect(true);
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+    client_thread->Stop(true);
+    server_thread->Stop(true);
+    client.reset();
+    tsrv.reset();
+}
+}
+
+TEST_UNIT(testTCPConnShrinkInputBuffer) {
+    size_t after_burst = 0;
+    size_t after_small = 0;
+    RunBurstThenIdle(false, &after_burst, &after_small);
+
+    // The buffer grown by the burst is shrunk while the small messages come
+    H_TEST_ASSERT(after_small < after_burst);
+    H_TEST_ASSERT(after_small <= 16 * 1024);
+}
+
+TEST_UNIT(testTCPConnReleaseBuffersWhenIdle) {
+    size_t after_burst = 0;
+    size_t after_small = 0;
+    RunBurstThenIdle(true, &after_burst, &after_small);
+    H_TEST_ASSERT(after_burst <= evpp::Buffer::kCheapPrependSize);
+    H_TEST_ASSERT(after_small <= evpp::Buffer::kCheapPrependSize);
+}
+
+TEST_UNIT(testTCPConnPauseResumeRead) {
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    const size_t kInputHighWaterMark = 64 * 1024;
+    const size_t kTotal = 16 * 1024 * 1024;
+    std::atomic<bool> paused(false);
+    std::atomic<bool> consume(false);
+    std::atomic<size_t> max_input(0);
+    std::atomic<size_t> received(0);
+    evpp::TCPConnPtr server_conn;
+
+    const std::string addr2 = "127.0.0.1:19380";
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr2, "PauseReadServer", 1));
+    tsrv->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            conn->SetInputHighWaterMark(kInputHighWaterMark);
+            conn->PauseRead();
+            server_conn = conn;
+            paused = true;
+        }
+    });
+    tsrv->SetMessageCallback([&](const evpp::TCPConnPtr&, evpp::Buffer* msg) {
+        if (msg->length() > max_input.load()) {
+            max_input = msg->length();
+        }
+        if (consume.load()) {
+            received += msg->length();
+            msg->Reset();
+        }
+    });
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), addr2, "PauseReadClient"));
+    client->set_auto_reconnect(false);
+    client->Connect();
+    for (int i = 0; i < 5000 && !paused.load(); i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(paused.load());
+    usleep(50 * 1000);
+
+    client->conn()->Send(std::string(kTotal, 'p'));
+
+    // Nothing is read while it is paused
+    usleep(200 * 1000);
+    H_TEST_ASSERT(max_input.load() == 0);
+
+    // The data is not consumed, so the reading is paused again at the high-water mark
+    server_conn->ResumeRead();
+    for (int i = 0; i < 5000 && max_input.load() < kInputHighWaterMark; i++) {
+        usleep(1000);
+    }
+    usleep(200 * 1000);
+    H_TEST_ASSERT(max_input.load() >= kInputHighWaterMark);
+    // The io_uring backend delivers the data already received into the
+    // provided buffers before the receiving request is canceled
+    H_TEST_ASSERT(max_input.load() < kInputHighWaterMark + 4 * 1024 * 1024);
+
+    // The buffered data is delivered again and all the rest is read
+    consume = true;
+    server_conn->ResumeRead();
+    for (int i = 0; i < 10000 && received.load() < kTotal; i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(received.load() == kTotal);
+
+    client->Disconnect(true);
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+
+    client_thread->Stop(true);
+    server_thread->Stop(true);
+    server_conn.reset();
+    client.reset();
+    tsrv.reset();
+}
+
+namespace {
+void RunReusePortListeners(const std::string& listen_addr, std::set<evpp::EventLoop*>* loops) {
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> listening_thread(new evpp::EventLoopThread);
+    listening_thread->Start(true);
+
+    const int kClients = 16;
+    std::mutex mutex;
+    std::atomic<int> accepted_in_listening_loop(0);
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(listening_thread->loop(), listen_addr, "ReusePortServer", 4));
+    tsrv->SetReusePortListeners(true);
+    tsrv->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            if (listening_thread->loop()->IsInLoopThread()) {
+                accepted_in_listening_loop++;
+            }
+            std::lock_guard<std::mutex> guard(mutex);
+            loops->insert(conn->loop());
+        }
+    });
+    tsrv->SetMessageCallback([](const evpp::TCPConnPtr& conn, evpp::Buffer* msg) {
+        conn->Send(msg);
+    });
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    std::atomic<int> echoed(0);
+    std::vector<std::shared_ptr<evpp::TCPClient>> clients;
+    for (int i = 0; i < kClients; i++) {
+        std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), listen_addr, "ReusePortClient"));
+        client->set_auto_reconnect(false);
+        client->SetConnectionCallback([](const evpp::TCPConnPtr& conn) {
+            if (conn->IsConnected()) {
+                conn->Send("hello");
+            }
+        });
+        client->SetMessageCallback([&](const evpp::TCPConnPtr&, evpp::Buffer* msg) {
+            if (msg->length() == 5) {
+                msg->Reset();
+                echoed++;
+            }
+        });
+        client->Connect();
+        clients.push_back(client);
+    }
+
+    for (int i = 0; i < 5000 && echoed.load() < kClients; i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(echoed.load() == kClients);
+    H_TEST_ASSERT(accepted_in_listening_loop.load() == 0);
+
+    for (auto& c : clients) {
+        c->Disconnect(true);
+    }
+
+    // The listeners are closed by their own loops
+    tsrv->Stop();
+    for (int i = 0; i < 5000 && !tsrv->IsStopped(); i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(tsrv->IsStopped());
+
+    client_thread->Stop(true);
+    listening_thread->Stop(true);
+    clients.clear();
+    tsrv.reset();
+}
+}
+
+TEST_UNIT(testTCPServerReusePortListeners) {
+    std::set<evpp::EventLoop*> loops;
+    RunReusePortListeners("127.0.0.1:19381", &loops);
+
+    // The connections are hashed to the listeners of the 4 loops
+    H_TEST_ASSERT(loops.size() >= 2);
+}
+
+TEST_UNIT(testTCPServerReusePortListenersCPUSteering) {
+#if defined(H_OS_LINUX) && defined(SO_ATTACH_REUSEPORT_CBPF)
+    std::unique_ptr<evpp::EventLoopThread> listening_thread(new evpp::EventLoopThread);
+    listening_thread->Start(true);
+
+    const std::string addr2 = "127.0.0.1:19382";
+    const uint32_t kLoops = 4;
+    std::mutex mutex;
+    std::map<std::string, evpp::EventLoop*> loop_of_client;
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(listening_thread->loop(), addr2, "CPUSteeringServer", kLoops));
+    tsrv->SetReusePortListeners(true, true);
+    tsrv->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (conn->IsConnected()) {
+            std::lock_guard<std::mutex> guard(mutex);
+            loop_of_client[conn->remote_addr()] = conn->loop();
+        }
+    });
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    // The packets sent on the loopback are received on the CPU of the sender,
+    // so the connections made on a CPU are all accepted by the listener of
+    // the loop cpu % kLoops, which is the order of the loops in the pool.
+    std::vector<int> cpus = evpp::numa::AllowedCPUs();
+    if (cpus.size() > 8) {
+        cpus.resize(8);
+    }
+    const int kClientsPerCPU = 8;
+    std::vector<evpp_socket_t> fds;
+    std::map<std::string, int> cpu_of_client;
+    struct sockaddr_storage ss = evpp::sock::ParseFromIPPort(addr2.c_str());
+    for (int cpu : cpus) {
+        std::thread t([&]() {
+            H_TEST_ASSERT(evpp::numa::PinThread(std::vector<int>(1, cpu)));
+            for (int i = 0; i < kClientsPerCPU; i++) {
+                evpp_socket_t fd = ::socket(AF_INET, SOCK_STREAM, 0);
+                H_TEST_ASSERT(::connect(fd, evpp::sock::sockaddr_cast(&ss), sizeof(struct sockaddr_in)) == 0);
+                struct sockaddr_storage local;
+                socklen_t len = sizeof(local);
+                H_TEST_ASSERT(::getsockname(fd, evpp::sock::sockaddr_cast(&local), &len) == 0);
+                cpu_of_client[evpp::sock::ToIPPort(&local)] = cpu;
+                fds.push_back(fd);
+            }
+        });
+        t.join();
+    }
+
+    for (int i = 0; i < 5000; i++) {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (loop_of_client.size() == fds.size()) {
+                break;
+            }
+        }
+        usleep(1000);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        H_TEST_EQUAL(loop_of_client.size(), fds.size());
+        for (auto& c : cpu_of_client) {
+            evpp::EventLoop* expected = tsrv->pool()->GetNextLoopWithHash(uint64_t(c.second) % kLoops);
+            H_TEST_ASSERT(loop_of_client[c.first] == expected);
+        }
+    }
+
+    for (evpp_socket_t fd : fds) {
+        EVUTIL_CLOSESOCKET(fd);
+    }
+    for (int i = 0; i < 5000 && tsrv->connection_count() > 0; i++) {
+        usleep(1000);
+    }
+
+    tsrv->Stop();
+    for (int i = 0; i < 5000 && !tsrv->IsStopped(); i++) {
+        usleep(1000);
+    }
+    H_TEST_ASSERT(tsrv->IsStopped());
+    listening_thread->Stop(true);
+    tsrv.reset();
+#endif
+}
+
+TEST_UNIT(testListenerAcceptBatch) {
+    std::unique_ptr<evpp::EventLoopThread> loop_thread(new evpp::EventLoopThread);
+    loop_thread->Start(true);
+    evpp::EventLoop* loop = loop_thread->loop();
+
+    const std::string addr2 = "127.0.0.1:19383";
+    const int kClients = 10;
+    std::mutex mutex;
+    std::vector<size_t> batches;
+    std::vector<evpp_socket_t> fds;
+    std::unique_ptr<evpp::Listener> listener(new evpp::Listener(loop, addr2));
+    listener->Listen();
+    listener->SetAcceptBudget(4);
+    listener->SetNewConnectionsCallback([&](std::vector<evpp::Listener::AcceptedConn>& conns) {
+        std::lock_guard<std::mutex> guard(mutex);
+        batches.push_back(conns.size());
+        for (auto& c : conns) {
+            H_TEST_ASSERT(!c.remote_addr.empty());
+            fds.push_back(c.fd);
+        }
+    });
+
+    // The connections are pending in the backlog before accepting starts
+    std::vector<evpp_socket_t> clients;
+    struct sockaddr_storage ss = evpp::sock::ParseFromIPPort(addr2.c_str());
+    for (int i = 0; i < kClients; i++) {
+        evpp_socket_t fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        H_TEST_ASSERT(::connect(fd, evpp::sock::sockaddr_cast(&ss), sizeof(struct sockaddr_in)) == 0);
+        clients.push_back(fd);
+    }
+    listener->Accept();
+
+    for (int i = 0; i < 5000; i++) {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (fds.size() == size_t(kClients)) {
+                break;
+            }
+        }
+        usleep(1000);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        H_TEST_ASSERT(fds.size() == size_t(kClients));
+        if (!loop->io_uring()) {
+            // 4 + 4 + 2, one batch per wakeup
+            H_TEST_ASSERT(batches.size() == 3);
+            H_TEST_ASSERT(batches[0] == 4);
+        }
+        for (auto fd : fds) {
+#ifdef H_OS_LINUX
+            H_TEST_ASSERT((::fcntl(fd, F_GETFL) & O_NONBLOCK) != 0);
+            H_TEST_ASSERT((::fcntl(fd, F_GETFD) & FD_CLOEXEC) != 0);
+#endif
+            EVUTIL_CLOSESOCKET(fd);
+        }
+    }
+
+    loop->RunInLoop([&listener]() {
+        listener->Stop();
+    });
+    loop_thread->Stop(true);
+    listener.reset();
+    for (auto fd : clients) {
+        EVUTIL_CLOSESOCKET(fd);
+    }
+}
+
+TEST_UNIT(testTCPServerBroadcast) {
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    const std::string addr2 = "127.0.0.1:19384";
+    const int kClients = 6;
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr2, "BroadcastServer", 3));
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+
+    std::atomic<int> received(0);
+    std::vector<std::shared_ptr<evpp::TCPClient>> clients;
+    for (int i = 0; i < kClients; i++) {
+        std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), addr2, "BroadcastClient"));
+        client->set_auto_reconnect(false);
+        client->SetMessageCallback([&](const evpp::TCPConnPtr&, evpp::Buffer* msg) {
+            if (msg->length() == 4) {
+                H_TEST_ASSERT(msg->NextAllString() == "news");
+                received++;
+            }
+        });
+        client->Connect();
+        clients.push_back(client);
+    }
+
+    for (int i = 0; i < 5000 && tsrv->connection_count() < size_t(kClients); i++) {
+        usleep(1000);
+    }
+    H_TEST_EQUAL(tsrv->connection_count(), size_t(kClients));
+
+    tsrv->Broadcast("news");
+    for (int i = 0; i < 5000 && received.load() < kClients; i++) {
+        usleep(1000);
+    }
+    H_TEST_EQUAL(received.load(), kClients);
+
+    // The connections are visited by their own loops
+    std::atomic<int> visited(0);
+    tsrv->ForEachConnection([&visited](const evpp::TCPConnPtr& conn) {
+        H_TEST_ASSERT(conn->loop()->IsInLoopThread());
+        visited++;
+    });
+    for (int i = 0; i < 5000 && visited.load() < kClients; i++) {
+        usleep(1000);
+    }
+    H_TEST_EQUAL(visited.load(), kClients);
+
+    // and removed from the tables of the loops when the clients disconnect
+    for (auto& c : clients) {
+        c->Disconnect(true);
+    }
+    for (int i = 0; i < 5000 && tsrv->connection_count() > 0; i++) {
+        usleep(1000);
+    }
+    H_TEST_EQUAL(tsrv->connection_count(), 0);
+
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+
+    client_thread->Stop(true);
+    server_thread->Stop(true);
+    clients.clear();
+    tsrv.reset();
+}
+
+TEST_UNIT(testTCPServerIncomingCPUSteering) {
+    std::unique_ptr<evpp::EventLoopThread> client_thread(new evpp::EventLoopThread);
+    client_thread->Start(true);
+    std::unique_ptr<evpp::EventLoopThread> server_thread(new evpp::EventLoopThread);
+    server_thread->Start(true);
+
+    // The first loop runs on all the CPUs and the second one is not placed,
+    // so the first one is the nearest to any CPU receiving the packets
+    const std::string addr2 = "127.0.0.1:19385";
+    const int kClients = 6;
+    std::unique_ptr<evpp::TCPServer> tsrv(new evpp::TCPServer(server_thread->loop(), addr2, "SteeringServer", 2));
+    std::vector<std::vector<int>> cpu_sets;
+    cpu_sets.push_back(evpp::numa::AllowedCPUs());
+    cpu_sets.push_back(std::vector<int>());
+    tsrv->pool()->SetCPUAffinity(cpu_sets);
+    tsrv->SetIncomingCPUSteering(true);
+
+    std::atomic<int> connected(0);
+    std::atomic<int> steered(0);
+    std::atomic<int> unknown_cpu(0);
+    tsrv->SetConnectionCallback([&](const evpp::TCPConnPtr& conn) {
+        if (!conn->IsConnected()) {
+            return;
+        }
+        if (evpp::sock::GetIncomingCPU(conn->fd()) < 0) {
+            unknown_cpu++;
+        } else if (conn->loop() == tsrv->pool()->GetNextLoopWithHash(0)) {
+            steered++;
+        }
+        connected++;
+    });
+    H_TEST_ASSERT(tsrv->Init());
+    H_TEST_ASSERT(tsrv->Start());
+    H_TEST_ASSERT(tsrv->pool()->placed());
+
+    std::vector<std::shared_ptr<evpp::TCPClient>> clients;
+    for (int i = 0; i < kClients; i++) {
+        std::shared_ptr<evpp::TCPClient> client(new evpp::TCPClient(client_thread->loop(), addr2, "SteeringClient"));
+        client->set_auto_reconnect(false);
+        client->Connect();
+        clients.push_back(client);
+    }
+
+    for (int i = 0; i < 5000 && connected.load() < kClients; i++) {
+        usleep(1000);
+    }
+    H_TEST_EQUAL(connected.load(), kClients);
+    H_TEST_EQUAL(steered.load() + unknown_cpu.load(), kClients);
+
+    for (auto& c : clients) {
+        c->Disconnect(true);
+    }
+
+    tsrv->Stop();
+    while (!tsrv->IsStopped()) {
+        usleep(1000);
+    }
+
+    client_thread->Stop(true);
+    server_thread->Stop(true);
+    clients.clear();
+    tsrv.reset();
+}
@@ -0,0 +1,114 @@
+#include "test_common.h"
+
+#include <evpp/event_loop.h>
+#include <evpp/event_loop_thread.h>
+#include <evpp/timing_wheel.h>
+#include <evpp/timestamp.h>
+
+#include <thread>
+#include <vector>
+
+namespace {
+class TestNode : public evpp::TimingWheel::Node {
+public:
+    TestNode() : fired_(0) {}
+    int fired_;
+    evpp::Timestamp fired_time_;
+    std::function<void()> on_timeout_;
+protected:
+    void OnWheelTimeout() override {
+        fired_++;
+        fired_time_ = evpp::Timestamp::Now();
+        if (on_timeout_) {
+            on_timeout_();
+        }
+    }
+};
+}
+
+TEST_UNIT(testTimingWheelAddRemove) {
+    evpp::EventLoop loop;
+    const int kCount = 1000;
+    std::vector<TestNode> nodes(kCount);
+    evpp::Timestamp start = evpp::Timestamp::Now();
+
+    auto f = [&]() {
+        evpp::TimingWheel* wheel = loop.timing_wheel();
+        for (int i = 0; i < kCount; i++) {
+            // Some of them go to the upper levels
+            wheel->Add(&nodes[i], evpp::Duration((i % 300) * evpp::Duration::kMillisecond));
+        }
+        H_TEST_EQUAL(wheel->size(), size_t(kCount));
+
+        // Remove the odd ones
+        for (int i = 1; i < kCount; i += 2) {
+            wheel->Remove(&nodes[i]);
+            wheel->Remove(&nodes[i]); // It is ok to remove twice
+        }
+        H_TEST_EQUAL(wheel->size(), size_t(kCount / 2));
+    };
+    loop.QueueInLoop(f);
+    loop.RunAfter(evpp::Duration(0.5), [&loop]() { loop.Stop(); });
+    loop.Run();
+
+    for (int i = 0; i < kCount; i++) {
+        if (i % 2 == 1) {
+            H_TEST_EQUAL(nodes[i].fired_, 0);
+            continue;
+        }
+
+        H_TEST_EQUAL(nodes[i].fired_, 1);
+        H_TEST_ASSERT(!nodes[i].linked());
+        evpp::Duration cost = nodes[i].fired_time_ - start;
+        H_TEST_ASSERT(cost >= evpp::Duration((i % 300) * evpp::Duration::kMillisecond));
+    }
+}
+
+TEST_UNIT(testTimingWheelCascade) {
+    evpp::EventLoop loop;
+    TestNode near;
+    TestNode far;
+    evpp::Timestamp start = evpp::Timestamp::Now();
+
+    // 300ms is beyond the 256 ticks of the root, so it is cascaded
+    far.on_timeout_ = [&loop]() { loop.Stop(); };
+    loop.QueueInLoop([&]() {
+        loop.timing_wheel()->Add(&near, evpp::Duration(0.01));
+        loop.timing_wheel()->Add(&far, evpp::Duration(0.3));
+    });
+    loop.Run();
+
+    H_TEST_EQUAL(near.fired_, 1);
+    H_TEST_EQUAL(far.fired_, 1);
+    H_TEST_ASSERT(far.fired_time_ - start >= evpp::Duration(0.3));
+    H_TEST_ASSERT(near.fired_time_ < far.fired_time_);
+}
+
+TEST_UNIT(testTimingWheelInvokeTimer) {
+    evpp::EventLoopThread t;
+    t.Start(true);
+    std::atomic<int> once(0);
+    std::atomic<int> every(0);
+    std::atomic<int> canceled(0);
+
+    evpp::Timestamp start = evpp::Timestamp::Now();
+    t.loop()->RunAfter(evpp::Duration(0.02), evpp::Task([&once]() { once++; }), evpp::InvokeTimer::kWheelTimer);
+    evpp::InvokeTimerPtr periodic = t.loop()->RunEvery(evpp::Duration(0.01), evpp::Task([&every]() { every++; }), evpp::InvokeTimer::kWheelTimer);
+    evpp::InvokeTimerPtr cancel = t.loop()->RunAfter(evpp::Duration(0.05), evpp::Task([&canceled]() { canceled++; }), evpp::InvokeTimer::kWheelTimer);
+    cancel->Cancel();
+
+    while (once.load() == 0 || every.load() < 5) {
+        usleep(1000);
+    }
+    periodic->Cancel();
+    H_TEST_ASSERT(evpp::Timestamp::Now() - start >= evpp::Duration(0.02));
+
+    usleep(100 * 1000);
+    int n = every.load();
+    usleep(50 * 1000);
+    H_TEST_EQUAL(every.load(), n);
+    H_TEST_EQUAL(once.load(), 1);
+    H_TEST_EQUAL(canceled.load(), 0);
+
+    t.Stop(true);
+}